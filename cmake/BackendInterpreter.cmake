@@ -0,0 +1,7 @@
+# ==============================================================================
+# INTERPRETER Backend Configuration
+# ==============================================================================
+# Kernels run on CPU tensors through Triton's interpreter (TRITON_INTERPRET=1)
+# in the embedded Python, so no device toolkit is needed.
+
+message(STATUS "Configuring INTERPRETER backend (CPU, no device runtime)")
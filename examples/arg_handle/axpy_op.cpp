@@ -6,16 +6,7 @@
 namespace my_ops {
 using namespace triton_jit;
 
-at::Tensor axpy(const at::Tensor& x, const at::Tensor& y, const c10::Scalar& alpha) {
-  auto res = torch::broadcast_tensors({x, y});
-  res[0] = res[0].contiguous();
-  res[1] = res[1].contiguous();
-  const at::Tensor& xx = res[0];
-  const at::Tensor& yy = res[1];
-
-  at::ScalarType out_dtype = at::promote_types(x.scalar_type(), y.scalar_type());
-  at::Tensor out = triton_jit::ops::backend_empty(xx.sizes(), out_dtype, x.device());
-
+static void launch_axpy(const at::Tensor& x, const at::Tensor& y, at::Tensor& out, const c10::Scalar& alpha) {
   const TritonJITFunction& f = TritonJITFunction::get_instance(std::string("axpy.py"), "axpy_kernel");
 
   constexpr int64_t tile_size = 1024;
@@ -28,9 +19,38 @@ at::Tensor axpy(const at::Tensor& x, const at::Tensor& y, const c10::Scalar& alp
   triton_jit::ops::RawStream stream = triton_jit::ops::get_device_stream(x);
 
   f(stream, num_blocks, 1, 1, num_warps, num_stages, x, y, out, alpha, n, tile_size);
+}
+
+at::Tensor axpy(const at::Tensor& x, const at::Tensor& y, const c10::Scalar& alpha) {
+  auto res = torch::broadcast_tensors({x, y});
+  res[0] = res[0].contiguous();
+  res[1] = res[1].contiguous();
+  const at::Tensor& xx = res[0];
+  const at::Tensor& yy = res[1];
+
+  at::ScalarType out_dtype = at::promote_types(x.scalar_type(), y.scalar_type());
+  at::Tensor out = triton_jit::ops::backend_empty(xx.sizes(), out_dtype, x.device());
+  launch_axpy(xx, yy, out, alpha);
+  return out;
+}
+
+at::Tensor& axpy_out(const at::Tensor& x, const at::Tensor& y, const c10::Scalar& alpha, at::Tensor& out) {
+  auto res = torch::broadcast_tensors({x, y});
+  res[0] = res[0].contiguous();
+  res[1] = res[1].contiguous();
+  const at::Tensor& xx = res[0];
+  const at::Tensor& yy = res[1];
+
+  at::ScalarType out_dtype = at::promote_types(x.scalar_type(), y.scalar_type());
+  triton_jit::ops::check_out_tensor("axpy.out", out, xx.sizes(), out_dtype, x.device());
+  launch_axpy(xx, yy, out, alpha);
   return out;
 }
 
+at::Tensor& axpy_(at::Tensor& x, const at::Tensor& y, const c10::Scalar& alpha) {
+  return axpy_out(x, y, alpha, x);
+}
+
 at::Tensor axpy2(const at::Tensor& x, const at::Tensor& y, const std::optional<c10::Scalar>& alpha) {
   auto res = torch::broadcast_tensors({x, y});
   res[0] = res[0].contiguous();
@@ -88,11 +108,15 @@ at::Tensor axpy3(const at::Tensor& x,
 
 TORCH_LIBRARY(axpy_ops, m) {
   m.def("axpy(Tensor self, Tensor other, Scalar alpha) -> Tensor");
+  m.def("axpy.out(Tensor self, Tensor other, Scalar alpha, *, Tensor(a!) out) -> Tensor(a!)");
+  m.def("axpy_(Tensor(a!) self, Tensor other, Scalar alpha) -> Tensor(a!)");
   m.def("axpy2(Tensor self, Tensor other, Scalar? alpha) -> Tensor");
   m.def("axpy3(Tensor self, Tensor? other, Scalar? alpha) -> Tensor");
 }
 
 REGISTER_TRITON_OP(axpy_ops, "axpy", axpy)
+REGISTER_TRITON_OP(axpy_ops, "axpy.out", axpy_out)
+REGISTER_TRITON_OP(axpy_ops, "axpy_", axpy_)
 REGISTER_TRITON_OP(axpy_ops, "axpy2", axpy2)
 REGISTER_TRITON_OP(axpy_ops, "axpy3", axpy3)
 
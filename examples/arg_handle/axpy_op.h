@@ -6,6 +6,8 @@
 namespace my_ops {
 
 at::Tensor axpy(const at::Tensor& x, const at::Tensor& y, const c10::Scalar& alpha);
+at::Tensor& axpy_out(const at::Tensor& x, const at::Tensor& y, const c10::Scalar& alpha, at::Tensor& out);
+at::Tensor& axpy_(at::Tensor& x, const at::Tensor& y, const c10::Scalar& alpha);
 at::Tensor axpy2(const at::Tensor& x, const at::Tensor& y, const std::optional<c10::Scalar>& alpha);
 at::Tensor axpy3(const at::Tensor& x,
                  const std::optional<at::Tensor>& y,
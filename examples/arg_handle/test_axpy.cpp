@@ -8,6 +8,8 @@ static at::Device test_device() {
   return at::Device("npu:0");
 #elif defined(BACKEND_MUSA)
   return at::Device("musa:0");
+#elif defined(BACKEND_INTERPRETER)
+  return at::kCPU;
 #else
   return at::kCUDA;
 #endif
@@ -69,3 +71,29 @@ TEST(axpy_test, optional_tensor_nullopt) {
   at::Tensor expected = alpha * a;
   EXPECT_TRUE(torch::allclose(result, expected));
 }
+
+TEST(axpy_test, out_reuses_buffer) {
+  at::Tensor a = at::rand({128 * 1024}, test_device());
+  at::Tensor b = at::rand({128 * 1024}, test_device());
+  at::Tensor out = at::empty_like(a);
+  void* buffer = out.data_ptr();
+
+  at::Tensor& result = my_ops::axpy_out(a, b, c10::Scalar(3.14), out);
+  EXPECT_EQ(result.data_ptr(), buffer);
+  EXPECT_TRUE(torch::allclose(out, at::add(c10::Scalar(3.14) * a, b)));
+}
+
+TEST(axpy_test, inplace) {
+  at::Tensor a = at::rand({128 * 1024}, test_device());
+  at::Tensor b = at::rand({128 * 1024}, test_device());
+  at::Tensor expected = at::add(c10::Scalar(2) * a, b);
+
+  my_ops::axpy_(a, b, c10::Scalar(2));
+  EXPECT_TRUE(torch::allclose(a, expected));
+}
+
+TEST(axpy_test, inplace_broadcast_self_throws) {
+  at::Tensor a = at::rand({128}, test_device());
+  at::Tensor b = at::rand({16, 128}, test_device());
+  EXPECT_THROW(my_ops::axpy_(a, b, c10::Scalar(2)), c10::Error);
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <stdexcept>
 #include <string>
 
@@ -17,7 +18,10 @@
 #endif
 #elif defined(BACKEND_MUSA)
 #include <musa_runtime.h>
+#elif defined(BACKEND_INTERPRETER)
+#include <ATen/Parallel.h>
 #else
+#include "ATen/cuda/CUDAContext.h"
 #include "c10/cuda/CUDAStream.h"
 #endif
 
@@ -28,6 +32,8 @@ namespace triton_jit::ops {
 using RawStream = aclrtStream;
 #elif defined(BACKEND_MUSA)
 using RawStream = musaStream_t;
+#elif defined(BACKEND_INTERPRETER)
+using RawStream = void*;
 #else
 using RawStream = CUstream;
 #endif
@@ -40,13 +46,62 @@ inline RawStream get_device_stream([[maybe_unused]] const at::Tensor& t) {
 #else
   return nullptr;
 #endif
-#elif defined(BACKEND_MUSA)
+#elif defined(BACKEND_MUSA) || defined(BACKEND_INTERPRETER)
   return nullptr;
 #else
   return static_cast<CUstream>(c10::cuda::getCurrentCUDAStream(t.device().index()).stream());
 #endif
 }
 
+// ---- Device synchronization (for benchmarks and tests) ----
+inline void device_synchronize([[maybe_unused]] const at::Device& device) {
+#if defined(BACKEND_NPU)
+#if HAS_TORCH_NPU
+  c10_npu::getCurrentNPUStream(device.index()).synchronize();
+#else
+  aclrtSynchronizeDevice();
+#endif
+#elif defined(BACKEND_MUSA)
+  musaDeviceSynchronize();
+#elif defined(BACKEND_INTERPRETER)
+  // interpreted launches are synchronous
+#else
+  c10::cuda::getCurrentCUDAStream(device.index()).synchronize();
+#endif
+}
+
+// ---- Launch planning ----
+// Grid-stride kernels may be launched with fewer programs than tiles. On NPU the
+// program count is capped to the physical cores of the kernel's core type, other
+// backends launch one program per tile. The grid is planned before the kernel is
+// compiled, so the caller names the mix_mode the compiler gives it: "aiv" for
+// vector-only kernels, "aic" or "mix" for kernels using tl.dot.
+inline unsigned int plan_num_blocks(unsigned int num_tiles, [[maybe_unused]] const char* mix_mode) {
+#if defined(BACKEND_NPU)
+  return triton_jit::NpuBackend::plan_launch(num_tiles, 1, 1, mix_mode).block_num;
+#else
+  return num_tiles;
+#endif
+}
+
+// ---- Compute units ----
+// Number of units that run programs concurrently (SMs on CUDA/IX/MUSA, cube
+// cores on NPU, host threads for the interpreter), used to decide when a grid
+// is too small to fill the device.
+inline int num_compute_units(const at::Device& device) {
+#if defined(BACKEND_NPU)
+  return static_cast<int>(triton_jit::NpuBackend::get_core_info(device.index()).cube_cores);
+#elif defined(BACKEND_MUSA)
+  int count = 0;
+  musaDeviceGetAttribute(&count, musaDevAttrMultiProcessorCount, device.index());
+  return count;
+#elif defined(BACKEND_INTERPRETER)
+  return at::get_num_threads();
+#else
+  return at::cuda::getDeviceProperties(device.index())->multiProcessorCount;
+#endif
+}
+
 // ---- Tensor allocation (wraps MUSA musaMalloc difference) ----
 inline at::Tensor backend_empty(at::IntArrayRef sizes, at::ScalarType dtype, at::Device device) {
 #if defined(BACKEND_MUSA)
@@ -65,4 +120,39 @@ inline at::Tensor backend_empty(at::IntArrayRef sizes, at::ScalarType dtype, at:
 #endif
 }
 
+// ---- Strided views ----
+// Stride of dims [begin, end) of t merged into one dim, or nullopt when they
+// cannot be viewed as one. Size-1 dims are ignored; all of them merge to stride 1.
+inline std::optional<int64_t> merged_stride(const at::Tensor& t, int64_t begin, int64_t end) {
+  std::optional<int64_t> inner;
+  int64_t expected = 0;
+  for (int64_t d = end - 1; d >= begin; d--) {
+    if (t.size(d) == 1) {
+      continue;
+    }
+    if (!inner.has_value()) {
+      inner = t.stride(d);
+    } else if (t.stride(d) != expected) {
+      return std::nullopt;
+    }
+    expected = t.stride(d) * t.size(d);
+  }
+  return inner.value_or(1);
+}
+
+// ---- Output buffers ----
+// out= and in-place variants write into a caller-provided tensor without
+// allocating. Kernels write outputs as dense row-major buffers, so the buffer
+// must match exactly instead of being resized or restrided.
+inline void check_out_tensor(const char* op,
+                             const at::Tensor& out,
+                             at::IntArrayRef sizes,
+                             at::ScalarType dtype,
+                             const at::Device& device) {
+  TORCH_CHECK(out.sizes() == sizes, op, ": expected out of shape ", sizes, ", got ", out.sizes());
+  TORCH_CHECK(out.scalar_type() == dtype, op, ": expected out of dtype ", dtype, ", got ", out.scalar_type());
+  TORCH_CHECK(out.device() == device, op, ": expected out on ", device, ", got ", out.device());
+  TORCH_CHECK(out.is_contiguous(), op, ": out must be contiguous, got strides ", out.strides());
+}
+
 }  // namespace triton_jit::ops
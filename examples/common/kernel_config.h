@@ -24,15 +24,38 @@ inline constexpr MatmulConfig default_matmul_config() {
 #endif
 }
 
-// ---- Reduce-sum config ----
-struct ReduceSumConfig {
+// Shape-bucketed matmul config: small M uses narrow row tiles, large square
+// problems use wide tiles. NPU keeps the default config for every shape.
+inline constexpr MatmulConfig matmul_config_for_shape([[maybe_unused]] int64_t M,
+                                                      [[maybe_unused]] int64_t N,
+                                                      [[maybe_unused]] int64_t K) {
+#if defined(BACKEND_NPU)
+  return default_matmul_config();
+#else
+  if (M <= 16) {
+    return {16, 64, 64, 8, 4, 3};
+  }
+  if (M <= 64 || N <= 64) {
+    return {32, 64, 64, 8, 4, 3};
+  }
+  if (M >= 1024 && N >= 1024) {
+    return {128, 128, 32, 8, 8, 3};
+  }
+  return default_matmul_config();
+#endif
+}
+
+// ---- Reduction config (examples/reduce) ----
+// BLOCK_M x BLOCK_N is the tile for rows reduced along a contiguous dim; the
+// planner reshapes a tile of the same size for short rows and strided rows.
+struct ReduceConfig {
   int64_t BLOCK_M;
   int64_t BLOCK_N;
   int num_warps;
   int num_stages;
 };
 
-inline constexpr ReduceSumConfig default_reduce_sum_config() {
+inline constexpr ReduceConfig default_reduce_config() {
 #if defined(BACKEND_NPU)
   return {4, 256, 1, 1};
 #else
@@ -70,6 +93,42 @@ inline constexpr NormConfig default_norm_config() {
 #endif
 }
 
+// ---- FP8 quantization config (examples/quant) ----
+struct QuantConfig {
+  int64_t max_block_size;  // longest row quantized from a single tile
+  int num_warps;
+  int num_stages;
+};
+
+inline constexpr QuantConfig default_quant_config() {
+#if defined(BACKEND_NPU)
+  return {1024, 1, 1};
+#else
+  return {8192, 8, 1};
+#endif
+}
+
+// ---- Scan config (cumsum, cumprod) ----
+// A tile holds tile_size elements, up to max_block_i of them across the inner
+// dim. single_pass selects the decoupled look-back kernel for rows longer than
+// one tile; it spin-waits on other programs of the grid, which NPU does not
+// support, so NPU takes the multi-kernel scan.
+struct ScanConfig {
+  int64_t tile_size;
+  int64_t max_block_i;
+  int num_warps;
+  int num_stages;
+  bool single_pass;
+};
+
+inline constexpr ScanConfig default_scan_config() {
+#if defined(BACKEND_NPU)
+  return {1024, 32, 1, 1, false};
+#else
+  return {2048, 64, 4, 1, true};
+#endif
+}
+
 // ---- Rotary embedding config ----
 struct RotaryConfig {
   int64_t BLOCK_N;
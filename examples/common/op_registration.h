@@ -4,6 +4,8 @@
 
 #if defined(BACKEND_NPU) || defined(BACKEND_MUSA)
 #define TRITON_DISPATCH_KEY PrivateUse1
+#elif defined(BACKEND_INTERPRETER)
+#define TRITON_DISPATCH_KEY CPU
 #else
 #define TRITON_DISPATCH_KEY CUDA
 #endif
@@ -0,0 +1,31 @@
+import triton
+from triton import language as tl
+
+# Template for kernels launched through triton_jit::MultiTensorApply.
+#
+# Parameters: (Table, num_tensors, one reference tensor per tensor list, extra args..., CHUNK_SIZE)
+# Table holds `num_tensors` records of (one pointer per list, numel), followed by
+# one (tensor index, chunk start) record per program. Pointers are stored as int64
+# and cast back using the element type of the reference tensor of their list.
+
+
+@triton.jit
+def multi_tensor_axpy_kernel(Table, num_tensors, X, Y, Out, a, CHUNK_SIZE: tl.constexpr):
+    # out[i] = a * x[i] + y[i] for every tensor i; 3 tensor lists -> records of 4
+    chunk = tl.program_id(0)
+    chunk_record = Table + num_tensors * 4 + chunk * 2
+    tensor_idx = tl.load(chunk_record)
+    start = tl.load(chunk_record + 1)
+
+    tensor_record = Table + tensor_idx * 4
+    x_ptr = tl.load(tensor_record).to(X.dtype)
+    y_ptr = tl.load(tensor_record + 1).to(Y.dtype)
+    out_ptr = tl.load(tensor_record + 2).to(Out.dtype)
+    n = tl.load(tensor_record + 3)
+
+    offsets = start + tl.arange(0, CHUNK_SIZE)
+    mask = offsets < n
+    x = tl.load(x_ptr + offsets, mask=mask)
+    y = tl.load(y_ptr + offsets, mask=mask)
+    o = a * x + y
+    tl.store(out_ptr + offsets, o, mask=mask)
@@ -0,0 +1,50 @@
+#include "foreach_op.h"
+#include "common/backend_ops.h"
+#include "common/op_registration.h"
+#include "triton_jit/multi_tensor_apply.h"
+#include "triton_jit/triton_jit_function.h"
+
+namespace my_ops {
+using namespace triton_jit;
+
+std::vector<at::Tensor> foreach_axpy(at::TensorList x, at::TensorList y, const c10::Scalar& alpha) {
+  TORCH_CHECK(x.size() == y.size(), "foreach_axpy: tensor lists must have the same length");
+  std::vector<at::Tensor> out;
+  if (x.empty()) {
+    return out;
+  }
+
+  std::vector<at::Tensor> xs, ys;
+  xs.reserve(x.size());
+  ys.reserve(y.size());
+  out.reserve(x.size());
+  for (size_t i = 0; i < x.size(); i++) {
+    TORCH_CHECK(x[i].sizes() == y[i].sizes(), "foreach_axpy: tensors must have the same shape");
+    xs.push_back(x[i].contiguous());
+    ys.push_back(y[i].contiguous());
+    at::ScalarType out_dtype = at::promote_types(x[i].scalar_type(), y[i].scalar_type());
+    out.push_back(triton_jit::ops::backend_empty(x[i].sizes(), out_dtype, x[i].device()));
+  }
+
+  const TritonJITFunction& f =
+      TritonJITFunction::get_instance(std::string("foreach_axpy.py"), "multi_tensor_axpy_kernel");
+
+  constexpr int64_t chunk_size = 2048;
+  constexpr int num_warps = 4;
+  constexpr int num_stages = 1;
+  static const MultiTensorApply<3> apply(f, chunk_size);
+
+  c10::DeviceGuard guard(x[0].device());
+  triton_jit::ops::RawStream stream = triton_jit::ops::get_device_stream(x[0]);
+
+  apply(stream, num_warps, num_stages, {xs, ys, out}, alpha);
+  return out;
+}
+
+TORCH_LIBRARY(foreach_ops, m) {
+  m.def("foreach_axpy(Tensor[] self, Tensor[] other, Scalar alpha) -> Tensor[]");
+}
+
+REGISTER_TRITON_OP(foreach_ops, "foreach_axpy", foreach_axpy)
+
+}  // namespace my_ops
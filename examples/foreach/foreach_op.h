@@ -0,0 +1,10 @@
+#pragma once
+
+#include <vector>
+#include "torch/torch.h"
+
+namespace my_ops {
+
+std::vector<at::Tensor> foreach_axpy(at::TensorList x, at::TensorList y, const c10::Scalar& alpha);
+
+}  // namespace my_ops
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "foreach_op.h"
+#include "torch/torch.h"
+#include "triton_jit/backend_config.h"
+
+static at::Device test_device() {
+#if defined(BACKEND_NPU)
+  return at::Device("npu:0");
+#elif defined(BACKEND_MUSA)
+  return at::Device("musa:0");
+#elif defined(BACKEND_INTERPRETER)
+  return at::kCPU;
+#else
+  return at::kCUDA;
+#endif
+}
+
+TEST(foreach_test, axpy_many_sizes) {
+  std::vector<at::Tensor> xs, ys;
+  for (int64_t n : {1, 17, 2048, 5000, 128 * 1024}) {
+    xs.push_back(at::rand({n}, test_device()));
+    ys.push_back(at::rand({n}, test_device()));
+  }
+
+  std::vector<at::Tensor> result = my_ops::foreach_axpy(xs, ys, c10::Scalar(2.5));
+  ASSERT_EQ(result.size(), xs.size());
+  for (size_t i = 0; i < xs.size(); i++) {
+    at::Tensor expected = at::add(c10::Scalar(2.5) * xs[i], ys[i]);
+    EXPECT_TRUE(torch::allclose(result[i], expected));
+  }
+}
+
+TEST(foreach_test, axpy_repeated_call) {
+  std::vector<at::Tensor> xs, ys;
+  for (int i = 0; i < 64; i++) {
+    xs.push_back(at::rand({32, 33}, test_device()));
+    ys.push_back(at::rand({32, 33}, test_device()));
+  }
+
+  // identical pointers on the second call hit the cached pointer table
+  my_ops::foreach_axpy(xs, ys, c10::Scalar(1.0));
+  std::vector<at::Tensor> result = my_ops::foreach_axpy(xs, ys, c10::Scalar(1.0));
+  for (size_t i = 0; i < xs.size(); i++) {
+    EXPECT_TRUE(torch::allclose(result[i], at::add(xs[i], ys[i])));
+  }
+}
+
+TEST(foreach_test, axpy_mixed_dtypes) {
+  // every pair promotes on its own; the pairs are launched in one group per dtype combination
+  at::TensorOptions f32 = at::TensorOptions().device(test_device());
+  std::vector<at::Tensor> xs = {at::rand({100}, f32.dtype(at::kHalf)),
+                                at::rand({3000}, f32),
+                                at::rand({64}, f32.dtype(at::kHalf)),
+                                at::rand({7}, f32.dtype(at::kDouble))};
+  std::vector<at::Tensor> ys = {
+      at::rand({100}, f32), at::rand({3000}, f32), at::rand({64}, f32.dtype(at::kHalf)), at::rand({7}, f32)};
+
+  std::vector<at::Tensor> result = my_ops::foreach_axpy(xs, ys, c10::Scalar(0.5));
+  for (size_t i = 0; i < xs.size(); i++) {
+    at::Tensor expected = at::add(c10::Scalar(0.5) * xs[i], ys[i]);
+    EXPECT_EQ(result[i].scalar_type(), expected.scalar_type());
+    EXPECT_TRUE(torch::allclose(result[i], expected, 1e-3, 1e-3));
+  }
+}
@@ -0,0 +1,152 @@
+import torch
+import triton
+from triton import language as tl
+
+
+@triton.jit
+def epilogue(acc, Bias, rm, rn, mask, bias_stride_m, bias_stride_n, alpha, beta, HAS_BIAS: tl.constexpr):
+    """alpha * acc (+ beta * bias), bias broadcast through its strides."""
+    acc = acc * alpha
+    if HAS_BIAS:
+        bias = tl.load(Bias + rm * bias_stride_m + rn * bias_stride_n, mask=mask, other=0.0)
+        acc += bias.to(tl.float32) * beta
+    return acc
+
+
+@triton.jit
+def mm_kernel(
+    A,
+    B,
+    C,
+    Bias,
+    M,
+    N,
+    K,
+    stride_am,
+    stride_ak,
+    stride_bk,
+    stride_bn,
+    stride_cm,
+    stride_cn,
+    bias_stride_m,
+    bias_stride_n,
+    alpha,
+    beta,
+    HAS_BIAS: tl.constexpr,
+    BLOCK_M: tl.constexpr,
+    BLOCK_N: tl.constexpr,
+    BLOCK_K: tl.constexpr,
+    GROUP_M: tl.constexpr,
+    SPLIT_K: tl.constexpr,
+):
+    """C = alpha * A @ B (+ beta * Bias).
+
+    Output tiles are visited in groups of GROUP_M rows so that programs running
+    together share A rows and B columns in L2. With SPLIT_K > 1, program_id(1)
+    selects a slice of K and the fp32 partial tile is written to a
+    [SPLIT_K, M, N] workspace (C) for split_k_reduce_kernel; the epilogue runs there.
+    """
+    pid = tl.program_id(0)
+    pid_k = tl.program_id(1)
+    num_pid_m = tl.cdiv(M, BLOCK_M)
+    num_pid_n = tl.cdiv(N, BLOCK_N)
+    num_pid_in_group = GROUP_M * num_pid_n
+    group_id = pid // num_pid_in_group
+    first_pid_m = group_id * GROUP_M
+    group_size_m = min(num_pid_m - first_pid_m, GROUP_M)
+    pid_m = first_pid_m + (pid % num_pid_in_group) % group_size_m
+    pid_n = (pid % num_pid_in_group) // group_size_m
+
+    rm = pid_m * BLOCK_M + tl.arange(0, BLOCK_M)
+    rn = pid_n * BLOCK_N + tl.arange(0, BLOCK_N)
+    rk = tl.arange(0, BLOCK_K)
+
+    k_per_split = tl.cdiv(K, SPLIT_K * BLOCK_K) * BLOCK_K
+    k_start = pid_k * k_per_split
+    k_end = min(k_start + k_per_split, K)
+
+    acc = tl.zeros((BLOCK_M, BLOCK_N), dtype=tl.float32)
+    for k in range(k_start, k_end, BLOCK_K):
+        ks = k + rk
+        a = tl.load(
+            A + rm[:, None] * stride_am + ks[None, :] * stride_ak,
+            mask=(rm < M)[:, None] & (ks < k_end)[None, :],
+            other=0.0,
+        )
+        b = tl.load(
+            B + ks[:, None] * stride_bk + rn[None, :] * stride_bn,
+            mask=(ks < k_end)[:, None] & (rn < N)[None, :],
+            other=0.0,
+        )
+        acc += tl.dot(a, b)
+
+    mask = (rm < M)[:, None] & (rn < N)[None, :]
+    if SPLIT_K == 1:
+        acc = epilogue(acc, Bias, rm[:, None], rn[None, :], mask, bias_stride_m, bias_stride_n, alpha, beta, HAS_BIAS)
+        tl.store(C + rm[:, None] * stride_cm + rn[None, :] * stride_cn, acc.to(C.dtype.element_ty), mask=mask)
+    else:
+        W = C + pid_k.to(tl.int64) * M * N
+        tl.store(W + rm[:, None] * N + rn[None, :], acc, mask=mask)
+
+
+@triton.jit
+def split_k_reduce_kernel(
+    W,
+    C,
+    Bias,
+    M,
+    N,
+    stride_cm,
+    stride_cn,
+    bias_stride_m,
+    bias_stride_n,
+    alpha,
+    beta,
+    HAS_BIAS: tl.constexpr,
+    SPLIT_K: tl.constexpr,
+    BLOCK_SIZE: tl.constexpr,
+):
+    """Sum the SPLIT_K partial tiles of W and apply the epilogue."""
+    pid = tl.program_id(0)
+    offsets = pid.to(tl.int64) * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < M * N
+    rm = offsets // N
+    rn = offsets % N
+
+    acc = tl.zeros((BLOCK_SIZE,), dtype=tl.float32)
+    for s in tl.static_range(SPLIT_K):
+        acc += tl.load(W + s * M * N + offsets, mask=mask, other=0.0)
+    acc = epilogue(acc, Bias, rm, rn, mask, bias_stride_m, bias_stride_n, alpha, beta, HAS_BIAS)
+    tl.store(C + rm * stride_cm + rn * stride_cn, acc.to(C.dtype.element_ty), mask=mask)
+
+
+def mm(a, b, split_k=1):
+    M, K = a.shape
+    N = b.shape[1]
+    c = torch.empty((M, N), device=a.device, dtype=a.dtype)
+    BLOCK_M, BLOCK_N, BLOCK_K, GROUP_M = 64, 64, 32, 8
+    grid = (triton.cdiv(M, BLOCK_M) * triton.cdiv(N, BLOCK_N), split_k)
+    out = c if split_k == 1 else torch.empty((split_k, M, N), device=a.device, dtype=torch.float32)
+    with torch.cuda.device(a.device):
+        mm_kernel[grid](
+            a, b, out, c, M, N, K,
+            a.stride(0), a.stride(1), b.stride(0), b.stride(1), c.stride(0), c.stride(1),
+            0, 0, 1.0, 0.0,
+            HAS_BIAS=False, BLOCK_M=BLOCK_M, BLOCK_N=BLOCK_N, BLOCK_K=BLOCK_K,
+            GROUP_M=GROUP_M, SPLIT_K=split_k,
+        )
+        if split_k > 1:
+            split_k_reduce_kernel[(triton.cdiv(M * N, 1024),)](
+                out, c, c, M, N, c.stride(0), c.stride(1), 0, 0, 1.0, 0.0,
+                HAS_BIAS=False, SPLIT_K=split_k, BLOCK_SIZE=1024,
+            )
+    return c
+
+
+if __name__ == "__main__":
+    a = torch.randn(512, 384, device="cuda", dtype=torch.float16)
+    b = torch.randn(384, 256, device="cuda", dtype=torch.float16)
+    torch.testing.assert_close(mm(a, b), a @ b, atol=1e-2, rtol=1e-2)
+    a = torch.randn(16, 8192, device="cuda", dtype=torch.float16)
+    b = torch.randn(8192, 64, device="cuda", dtype=torch.float16)
+    torch.testing.assert_close(mm(a, b, split_k=8), a @ b, atol=5e-2, rtol=1e-2)
@@ -0,0 +1,172 @@
+#include "matmul_op.h"
+#include <algorithm>
+#include "common/backend_ops.h"
+#include "common/kernel_config.h"
+#include "common/op_registration.h"
+#include "triton_jit/triton_jit_function.h"
+
+namespace my_ops {
+using namespace triton_jit;
+
+// Split K when the output tiles alone leave most compute units idle and each
+// slice still gets at least 4 BLOCK_K steps. Powers of two only, so the number
+// of compiled SPLIT_K variants stays small.
+static int64_t choose_split_k(int64_t num_tiles,
+                              int64_t K,
+                              const triton_jit::ops::MatmulConfig& cfg,
+                              int units) {
+  constexpr int64_t max_split_k = 16;
+  int64_t split_k = 1;
+  while (split_k < max_split_k && num_tiles * split_k * 2 <= units &&
+         K / (split_k * 2 * cfg.BLOCK_K) >= 4) {
+    split_k *= 2;
+  }
+  return split_k;
+}
+
+// out = alpha * (a @ b) + beta * bias, bias already expanded to [M, N]
+static void launch_matmul(const at::Tensor& a,
+                          const at::Tensor& b,
+                          at::Tensor& out,
+                          const std::optional<at::Tensor>& bias,
+                          double alpha,
+                          double beta) {
+  const int64_t M = a.size(0);
+  const int64_t K = a.size(1);
+  const int64_t N = b.size(1);
+  if (M == 0 || N == 0) {
+    return;
+  }
+
+  const auto cfg = triton_jit::ops::matmul_config_for_shape(M, N, K);
+  const int64_t num_tiles = ((M + cfg.BLOCK_M - 1) / cfg.BLOCK_M) * ((N + cfg.BLOCK_N - 1) / cfg.BLOCK_N);
+  const int64_t split_k = choose_split_k(num_tiles, K, cfg, triton_jit::ops::num_compute_units(a.device()));
+
+  const bool has_bias = bias.has_value();
+  // unused when has_bias is false; any tensor of the output's device will do
+  const at::Tensor& bias_t = has_bias ? *bias : out;
+  const int64_t bias_stride_m = has_bias ? bias_t.stride(0) : 0;
+  const int64_t bias_stride_n = has_bias ? bias_t.stride(1) : 0;
+
+  const TritonJITFunction& f = TritonJITFunction::get_instance(std::string("matmul.py"), "mm_kernel");
+
+  c10::DeviceGuard guard(out.device());
+  triton_jit::ops::RawStream stream = triton_jit::ops::get_device_stream(a);
+
+  at::Tensor workspace =
+      split_k == 1 ? out : triton_jit::ops::backend_empty({split_k, M, N}, at::kFloat, out.device());
+  f(stream,
+    static_cast<unsigned int>(num_tiles),
+    static_cast<unsigned int>(split_k),
+    1,
+    cfg.num_warps,
+    cfg.num_stages,
+    a,
+    b,
+    workspace,
+    bias_t,
+    M,
+    N,
+    K,
+    a.stride(0),
+    a.stride(1),
+    b.stride(0),
+    b.stride(1),
+    out.stride(0),
+    out.stride(1),
+    bias_stride_m,
+    bias_stride_n,
+    static_cast<float>(alpha),
+    static_cast<float>(beta),
+    has_bias,
+    cfg.BLOCK_M,
+    cfg.BLOCK_N,
+    cfg.BLOCK_K,
+    cfg.GROUP_M,
+    split_k);
+
+  if (split_k > 1) {
+    const TritonJITFunction& reduce =
+        TritonJITFunction::get_instance(std::string("matmul.py"), "split_k_reduce_kernel");
+    constexpr int64_t block_size = 1024;
+    reduce(stream,
+           static_cast<unsigned int>((M * N + block_size - 1) / block_size),
+           1,
+           1,
+           cfg.num_warps,
+           1,
+           workspace,
+           out,
+           bias_t,
+           M,
+           N,
+           out.stride(0),
+           out.stride(1),
+           bias_stride_m,
+           bias_stride_n,
+           static_cast<float>(alpha),
+           static_cast<float>(beta),
+           has_bias,
+           split_k,
+           block_size);
+  }
+}
+
+static void check_mm_args(const at::Tensor& a, const at::Tensor& b, const char* name) {
+  TORCH_CHECK(a.dim() == 2 && b.dim() == 2, name, ": expected 2-D matrices");
+  TORCH_CHECK(a.size(1) == b.size(0),
+              name,
+              ": shapes ",
+              a.sizes(),
+              " and ",
+              b.sizes(),
+              " cannot be multiplied");
+  TORCH_CHECK(a.scalar_type() == b.scalar_type(), name, ": mat1 and mat2 must have the same dtype");
+  // the kernel accumulates with tl.dot in fp32, which has no integer path here
+  TORCH_CHECK(at::isFloatingType(a.scalar_type()),
+              name,
+              ": expected floating point matrices, got ",
+              a.scalar_type());
+}
+
+at::Tensor mm(const at::Tensor& self, const at::Tensor& mat2) {
+  check_mm_args(self, mat2, "mm");
+  at::Tensor out =
+      triton_jit::ops::backend_empty({self.size(0), mat2.size(1)}, self.scalar_type(), self.device());
+  if (self.size(1) == 0) {
+    return out.zero_();
+  }
+  launch_matmul(self, mat2, out, std::nullopt, 1.0, 0.0);
+  return out;
+}
+
+at::Tensor addmm(const at::Tensor& self,
+                 const at::Tensor& mat1,
+                 const at::Tensor& mat2,
+                 const c10::Scalar& beta,
+                 const c10::Scalar& alpha) {
+  check_mm_args(mat1, mat2, "addmm");
+  const int64_t M = mat1.size(0);
+  const int64_t N = mat2.size(1);
+  at::Tensor out = triton_jit::ops::backend_empty({M, N}, mat1.scalar_type(), mat1.device());
+  // beta == 0 ignores self entirely (nan/inf included), as in aten
+  std::optional<at::Tensor> bias;
+  if (beta.toDouble() != 0.0) {
+    bias = self.expand({M, N});
+  }
+  if (mat1.size(1) == 0) {
+    return bias.has_value() ? out.copy_(*bias).mul_(beta) : out.zero_();
+  }
+  launch_matmul(mat1, mat2, out, bias, alpha.toDouble(), beta.toDouble());
+  return out;
+}
+
+TORCH_LIBRARY(matmul_ops, m) {
+  m.def("mm(Tensor self, Tensor mat2) -> Tensor");
+  m.def("addmm(Tensor self, Tensor mat1, Tensor mat2, *, Scalar beta=1, Scalar alpha=1) -> Tensor");
+}
+
+REGISTER_TRITON_OP(matmul_ops, "mm", mm)
+REGISTER_TRITON_OP(matmul_ops, "addmm", addmm)
+
+}  // namespace my_ops
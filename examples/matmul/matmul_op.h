@@ -0,0 +1,15 @@
+#pragma once
+
+#include "torch/torch.h"
+
+namespace my_ops {
+
+at::Tensor mm(const at::Tensor& self, const at::Tensor& mat2);
+
+at::Tensor addmm(const at::Tensor& self,
+                 const at::Tensor& mat1,
+                 const at::Tensor& mat2,
+                 const c10::Scalar& beta,
+                 const c10::Scalar& alpha);
+
+}  // namespace my_ops
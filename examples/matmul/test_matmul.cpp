@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "matmul_op.h"
+#include "torch/torch.h"
+#include "triton_jit/backend_config.h"
+
+static at::Device test_device() {
+#if defined(BACKEND_NPU)
+  return at::Device("npu:0");
+#elif defined(BACKEND_MUSA)
+  return at::Device("musa:0");
+#elif defined(BACKEND_INTERPRETER)
+  return at::kCPU;
+#else
+  return at::kCUDA;
+#endif
+}
+
+static at::TensorOptions half_options() {
+  return at::TensorOptions().dtype(at::kHalf).device(test_device());
+}
+
+TEST(matmul_test, mm_square) {
+  at::Tensor a = at::randn({512, 384}, half_options());
+  at::Tensor b = at::randn({384, 256}, half_options());
+  at::Tensor expected = at::mm(a.to(at::kFloat), b.to(at::kFloat));
+  at::Tensor result = my_ops::mm(a, b);
+  EXPECT_TRUE(torch::allclose(result.to(at::kFloat), expected, 1e-2, 1e-1));
+}
+
+TEST(matmul_test, mm_transposed_operand) {
+  at::Tensor a = at::randn({200, 96}, half_options());
+  at::Tensor b = at::randn({130, 96}, half_options()).t();
+  at::Tensor expected = at::mm(a.to(at::kFloat), b.to(at::kFloat));
+  at::Tensor result = my_ops::mm(a, b);
+  EXPECT_TRUE(torch::allclose(result.to(at::kFloat), expected, 1e-2, 1e-1));
+}
+
+TEST(matmul_test, mm_split_k) {
+  // a handful of output tiles with a long K takes the split-K path
+  at::Tensor a = at::randn({16, 8192}, half_options());
+  at::Tensor b = at::randn({8192, 64}, half_options());
+  at::Tensor expected = at::mm(a.to(at::kFloat), b.to(at::kFloat));
+  at::Tensor result = my_ops::mm(a, b);
+  EXPECT_TRUE(torch::allclose(result.to(at::kFloat), expected, 1e-2, 5e-1));
+}
+
+TEST(matmul_test, addmm_bias_alpha_beta) {
+  at::Tensor bias = at::randn({256}, half_options());
+  at::Tensor a = at::randn({128, 512}, half_options());
+  at::Tensor b = at::randn({512, 256}, half_options());
+  at::Tensor expected =
+      at::addmm(bias.to(at::kFloat), a.to(at::kFloat), b.to(at::kFloat), /*beta=*/0.5, /*alpha=*/2.0);
+  at::Tensor result = my_ops::addmm(bias, a, b, 0.5, 2.0);
+  EXPECT_TRUE(torch::allclose(result.to(at::kFloat), expected, 1e-2, 2e-1));
+}
+
+TEST(matmul_test, addmm_split_k_bias) {
+  at::Tensor bias = at::randn({32, 1}, half_options());
+  at::Tensor a = at::randn({32, 4096}, half_options());
+  at::Tensor b = at::randn({4096, 32}, half_options());
+  at::Tensor expected = at::addmm(bias.to(at::kFloat), a.to(at::kFloat), b.to(at::kFloat));
+  at::Tensor result = my_ops::addmm(bias, a, b, 1, 1);
+  EXPECT_TRUE(torch::allclose(result.to(at::kFloat), expected, 1e-2, 5e-1));
+}
+
+TEST(matmul_test, rejects_integer_dtypes) {
+  at::Tensor a = at::randint(0, 4, {8, 8}, at::TensorOptions().dtype(at::kInt).device(test_device()));
+  EXPECT_THROW(my_ops::mm(a, a), c10::Error);
+}
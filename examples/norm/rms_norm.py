@@ -0,0 +1,97 @@
+import torch
+import triton
+from triton import language as tl
+
+
+@triton.jit
+def fused_add_rms_norm_kernel(
+    X,
+    R,
+    W,
+    Y,
+    x_stride_r,
+    r_stride_r,
+    y_stride_r,
+    N,
+    eps,
+    BLOCK_SIZE: tl.constexpr,
+    ONE_TILE: tl.constexpr,
+):
+    """R = X + R (in place), Y = rms_norm(R) * W, one row per program."""
+    row = tl.program_id(0)
+    X += row * x_stride_r
+    R += row * r_stride_r
+    Y += row * y_stride_r
+
+    if ONE_TILE:
+        # the whole row fits in one tile: a single read of X and R
+        cols = tl.arange(0, BLOCK_SIZE)
+        mask = cols < N
+        x = tl.load(X + cols, mask=mask, other=0.0).to(tl.float32)
+        r = tl.load(R + cols, mask=mask, other=0.0).to(tl.float32)
+        x += r
+        tl.store(R + cols, x.to(R.dtype.element_ty), mask=mask)
+
+        var = tl.sum(x * x, axis=0) / N
+        rrms = tl.rsqrt(var + eps)
+        w = tl.load(W + cols, mask=mask, other=0.0).to(tl.float32)
+        y = x * rrms * w
+        tl.store(Y + cols, y.to(Y.dtype.element_ty), mask=mask)
+    else:
+        # rows longer than the block limit: accumulate, then normalize the updated residual
+        acc = tl.zeros([BLOCK_SIZE], dtype=tl.float32)
+        for off in range(0, N, BLOCK_SIZE):
+            cols = off + tl.arange(0, BLOCK_SIZE)
+            mask = cols < N
+            x = tl.load(X + cols, mask=mask, other=0.0).to(tl.float32)
+            r = tl.load(R + cols, mask=mask, other=0.0).to(tl.float32)
+            x += r
+            tl.store(R + cols, x.to(R.dtype.element_ty), mask=mask)
+            acc += x * x
+
+        var = tl.sum(acc, axis=0) / N
+        rrms = tl.rsqrt(var + eps)
+        for off in range(0, N, BLOCK_SIZE):
+            cols = off + tl.arange(0, BLOCK_SIZE)
+            mask = cols < N
+            x = tl.load(R + cols, mask=mask, other=0.0).to(tl.float32)
+            w = tl.load(W + cols, mask=mask, other=0.0).to(tl.float32)
+            y = x * rrms * w
+            tl.store(Y + cols, y.to(Y.dtype.element_ty), mask=mask)
+
+
+def fused_add_rms_norm(x, residual, weight, eps=1e-6):
+    N = x.shape[-1]
+    x2d = x.reshape(-1, N)
+    r2d = residual.view(-1, N)
+    y = torch.empty_like(x2d)
+    BLOCK_SIZE = triton.next_power_of_2(N)
+    with torch.cuda.device(x.device):
+        fused_add_rms_norm_kernel[(x2d.shape[0],)](
+            x2d,
+            r2d,
+            weight,
+            y,
+            x2d.stride(0),
+            r2d.stride(0),
+            y.stride(0),
+            N,
+            eps,
+            BLOCK_SIZE=BLOCK_SIZE,
+            ONE_TILE=True,
+        )
+    return y.view_as(x)
+
+
+if __name__ == "__main__":
+    x = torch.randn(64, 4096, device="cuda", dtype=torch.float16)
+    residual = torch.randn_like(x)
+    weight = torch.randn(4096, device="cuda", dtype=torch.float16)
+
+    expected_residual = (x.float() + residual.float()).half()
+    y = fused_add_rms_norm(x, residual, weight)
+    expected = torch.nn.functional.rms_norm(
+        expected_residual.float(), (4096,), weight.float(), 1e-6
+    )
+    torch.testing.assert_close(residual, expected_residual)
+    torch.testing.assert_close(y.float(), expected, atol=2e-2, rtol=2e-2)
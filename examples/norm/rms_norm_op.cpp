@@ -0,0 +1,79 @@
+#include "rms_norm_op.h"
+#include "common/backend_ops.h"
+#include "common/kernel_config.h"
+#include "common/op_registration.h"
+#include "triton_jit/triton_jit_function.h"
+
+namespace my_ops {
+using namespace triton_jit;
+
+at::Tensor fused_add_rms_norm(const at::Tensor& input,
+                              at::Tensor& residual,
+                              const at::Tensor& weight,
+                              double epsilon) {
+  TORCH_CHECK(input.sizes() == residual.sizes(), "fused_add_rms_norm: input and residual shapes differ");
+  TORCH_CHECK(input.scalar_type() == residual.scalar_type(),
+              "fused_add_rms_norm: input and residual dtypes differ");
+  const int64_t N = input.size(-1);
+  TORCH_CHECK(weight.dim() == 1 && weight.size(0) == N, "fused_add_rms_norm: weight must have shape [N]");
+
+  // Rows may be strided, but the hidden dim must be contiguous. The residual is
+  // updated in place, so it must be viewable as [M, N] without a copy.
+  at::Tensor x = input.stride(-1) == 1 ? input : input.contiguous();
+  x = x.reshape({-1, N});
+  TORCH_CHECK(residual.stride(-1) == 1, "fused_add_rms_norm: residual must be contiguous in the last dim");
+  at::Tensor r = residual.view({-1, N});
+  at::Tensor w = weight.contiguous();
+  const int64_t M = x.size(0);
+
+  at::Tensor out = triton_jit::ops::backend_empty(input.sizes(), input.scalar_type(), input.device());
+  at::Tensor y = out.view({-1, N});
+  if (M == 0) {
+    return out;
+  }
+
+  // Block size from the hidden size, capped by the backend's block limit
+  constexpr auto cfg = triton_jit::ops::default_norm_config();
+  int64_t block_size = 1;
+  while (block_size < N) {
+    block_size *= 2;
+  }
+  bool one_tile = true;
+  if (cfg.max_block_size > 0 && block_size > cfg.max_block_size) {
+    block_size = cfg.max_block_size;
+    one_tile = false;
+  }
+
+  const TritonJITFunction& f =
+      TritonJITFunction::get_instance(std::string("rms_norm.py"), "fused_add_rms_norm_kernel");
+
+  c10::DeviceGuard guard(out.device());
+  triton_jit::ops::RawStream stream = triton_jit::ops::get_device_stream(x);
+
+  f(stream,
+    static_cast<unsigned int>(M),
+    1,
+    1,
+    cfg.num_warps,
+    cfg.num_stages,
+    x,
+    r,
+    w,
+    y,
+    x.stride(0),
+    r.stride(0),
+    y.stride(0),
+    N,
+    static_cast<float>(epsilon),
+    block_size,
+    one_tile);
+  return out;
+}
+
+TORCH_LIBRARY(norm_ops, m) {
+  m.def("fused_add_rms_norm(Tensor input, Tensor(a!) residual, Tensor weight, float epsilon=1e-6) -> Tensor");
+}
+
+REGISTER_TRITON_OP(norm_ops, "fused_add_rms_norm", fused_add_rms_norm)
+
+}  // namespace my_ops
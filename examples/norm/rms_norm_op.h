@@ -0,0 +1,13 @@
+#pragma once
+
+#include "torch/torch.h"
+
+namespace my_ops {
+
+// residual <- input + residual; returns rms_norm(residual) * weight
+at::Tensor fused_add_rms_norm(const at::Tensor& input,
+                              at::Tensor& residual,
+                              const at::Tensor& weight,
+                              double epsilon);
+
+}  // namespace my_ops
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "rms_norm_op.h"
+#include "torch/torch.h"
+#include "triton_jit/backend_config.h"
+
+static at::Device test_device() {
+#if defined(BACKEND_NPU)
+  return at::Device("npu:0");
+#elif defined(BACKEND_MUSA)
+  return at::Device("musa:0");
+#elif defined(BACKEND_INTERPRETER)
+  return at::kCPU;
+#else
+  return at::kCUDA;
+#endif
+}
+
+static at::Tensor reference_rms_norm(const at::Tensor& x, const at::Tensor& weight, double eps) {
+  at::Tensor xf = x.to(at::kFloat);
+  at::Tensor rrms = at::rsqrt(xf.pow(2).mean({-1}, true) + eps);
+  return (xf * rrms * weight.to(at::kFloat)).to(x.scalar_type());
+}
+
+TEST(rms_norm_test, fp32) {
+  at::Tensor x = at::randn({32, 1024}, test_device());
+  at::Tensor residual = at::randn({32, 1024}, test_device());
+  at::Tensor weight = at::randn({1024}, test_device());
+
+  at::Tensor expected_residual = x + residual;
+  at::Tensor expected = reference_rms_norm(expected_residual, weight, 1e-6);
+  at::Tensor result = my_ops::fused_add_rms_norm(x, residual, weight, 1e-6);
+  EXPECT_TRUE(torch::allclose(residual, expected_residual, 1e-5, 1e-5));
+  EXPECT_TRUE(torch::allclose(result, expected, 1e-4, 1e-4));
+}
+
+TEST(rms_norm_test, fp16_long_row) {
+  at::TensorOptions opts = at::TensorOptions().dtype(at::kHalf).device(test_device());
+  at::Tensor x = at::randn({4, 3, 5120}, opts);
+  at::Tensor residual = at::randn({4, 3, 5120}, opts);
+  at::Tensor weight = at::randn({5120}, opts);
+
+  at::Tensor expected_residual = (x.to(at::kFloat) + residual.to(at::kFloat)).to(at::kHalf);
+  at::Tensor expected = reference_rms_norm(expected_residual, weight, 1e-5);
+  at::Tensor result = my_ops::fused_add_rms_norm(x, residual, weight, 1e-5);
+  EXPECT_TRUE(torch::allclose(residual, expected_residual, 1e-3, 1e-3));
+  EXPECT_TRUE(torch::allclose(result, expected, 2e-2, 2e-2));
+}
@@ -5,14 +5,17 @@ from triton import language as tl
 
 @triton.jit
 def binary_pointwise_kernel(X, Y, Out, n, BLOCK_N: tl.constexpr):
+    # grid-stride over tiles, so the launcher may use fewer programs than tiles
     pid = tl.program_id(0)
-    offsets = pid * BLOCK_N + tl.arange(0, BLOCK_N)
-    mask = offsets < n
-
-    x = tl.load(X + offsets, mask=mask)
-    y = tl.load(Y + offsets, mask=mask)
-    o = x + y
-    tl.store(Out + offsets, o, mask=mask)
+    num_tiles = tl.cdiv(n, BLOCK_N)
+    for tile in range(pid, num_tiles, tl.num_programs(0)):
+        offsets = tile * BLOCK_N + tl.arange(0, BLOCK_N)
+        mask = offsets < n
+
+        x = tl.load(X + offsets, mask=mask)
+        y = tl.load(Y + offsets, mask=mask)
+        o = x + y
+        tl.store(Out + offsets, o, mask=mask)
 
 
 def binary_add_tensor(x: torch.Tensor, y: torch.Tensor) -> torch.Tensor:
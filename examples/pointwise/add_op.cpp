@@ -6,16 +6,14 @@
 namespace my_ops {
 using namespace triton_jit;
 
-at::Tensor add_tensor(const at::Tensor& a_, const at::Tensor& b_) {
-  auto res = torch::broadcast_tensors({a_, b_});
+static std::vector<at::Tensor> broadcast_contiguous(const at::Tensor& a, const at::Tensor& b) {
+  auto res = torch::broadcast_tensors({a, b});
   res[0] = res[0].contiguous();
   res[1] = res[1].contiguous();
-  const at::Tensor& a = res[0];
-  const at::Tensor& b = res[1];
-
-  at::ScalarType out_dtype = at::promote_types(a.scalar_type(), b.scalar_type());
-  at::Tensor out = triton_jit::ops::backend_empty(a.sizes(), out_dtype, a.device());
+  return res;
+}
 
+static void launch_add(const at::Tensor& a, const at::Tensor& b, at::Tensor& out) {
   const TritonJITFunction& f =
       TritonJITFunction::get_instance(std::string("add.py"), "binary_pointwise_kernel");
 
@@ -23,19 +21,50 @@ at::Tensor add_tensor(const at::Tensor& a_, const at::Tensor& b_) {
   constexpr int num_warps = 8;
   constexpr int num_stages = 1;
   const int64_t n = out.numel();
-  const unsigned int num_blocks = (n + tile_size - 1) / tile_size;
+  const unsigned int num_tiles = (n + tile_size - 1) / tile_size;
+  const unsigned int num_blocks = triton_jit::ops::plan_num_blocks(num_tiles, "aiv");
 
   c10::DeviceGuard guard(out.device());
   triton_jit::ops::RawStream stream = triton_jit::ops::get_device_stream(a);
 
   f(stream, num_blocks, 1, 1, num_warps, num_stages, a, b, out, n, tile_size);
+}
+
+at::Tensor add_tensor(const at::Tensor& a_, const at::Tensor& b_) {
+  auto res = broadcast_contiguous(a_, b_);
+  const at::Tensor& a = res[0];
+  const at::Tensor& b = res[1];
+
+  at::ScalarType out_dtype = at::promote_types(a.scalar_type(), b.scalar_type());
+  at::Tensor out = triton_jit::ops::backend_empty(a.sizes(), out_dtype, a.device());
+  launch_add(a, b, out);
+  return out;
+}
+
+at::Tensor& add_tensor_out(const at::Tensor& a_, const at::Tensor& b_, at::Tensor& out) {
+  auto res = broadcast_contiguous(a_, b_);
+  const at::Tensor& a = res[0];
+  const at::Tensor& b = res[1];
+
+  at::ScalarType out_dtype = at::promote_types(a.scalar_type(), b.scalar_type());
+  triton_jit::ops::check_out_tensor("add_tensor.out", out, a.sizes(), out_dtype, a.device());
+  launch_add(a, b, out);
   return out;
 }
 
+at::Tensor& add_tensor_(at::Tensor& self, const at::Tensor& other) {
+  // each element is read before it is written, so self can be both input and output
+  return add_tensor_out(self, other, self);
+}
+
 TORCH_LIBRARY(my_ops, m) {
   m.def("add_tensor(Tensor self, Tensor other) -> Tensor");
+  m.def("add_tensor.out(Tensor self, Tensor other, *, Tensor(a!) out) -> Tensor(a!)");
+  m.def("add_tensor_(Tensor(a!) self, Tensor other) -> Tensor(a!)");
 }
 
 REGISTER_TRITON_OP(my_ops, "add_tensor", add_tensor)
+REGISTER_TRITON_OP(my_ops, "add_tensor.out", add_tensor_out)
+REGISTER_TRITON_OP(my_ops, "add_tensor_", add_tensor_)
 
 }  // namespace my_ops
@@ -5,5 +5,8 @@
 namespace my_ops {
 
 at::Tensor add_tensor(const at::Tensor& a_, const at::Tensor& b_);
+// Write into a preallocated `out` of the broadcast shape and promoted dtype, without allocating
+at::Tensor& add_tensor_out(const at::Tensor& a_, const at::Tensor& b_, at::Tensor& out);
+at::Tensor& add_tensor_(at::Tensor& self, const at::Tensor& other);
 
 }  // namespace my_ops
@@ -0,0 +1,161 @@
+#include <unistd.h>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "add_op.h"
+#include "common/backend_ops.h"
+#include "fmt/core.h"
+#include "torch/torch.h"
+#include "triton_jit/runtime_metrics.h"
+
+// Time from process start to the first completed launch of add_tensor, broken
+// down by phase. Each mode runs in a fresh child process sharing one temporary
+// TRITON_CACHE_DIR:
+//   cold                empty Triton cache: compile_a_kernel compiles
+//   warm_triton_cache   artifacts cached, TRITON_JIT_CACHE_LOOKUP=0: compile_a_kernel hits the cache
+//   warm_runtime_index  artifacts cached, the runtime finds them by cache key without compiling
+//
+// Usage: bench_startup [--out result.json], run from the directory containing add.py.
+static at::Device bench_device() {
+#if defined(BACKEND_NPU)
+  return at::Device("npu:0");
+#elif defined(BACKEND_MUSA)
+  return at::Device("musa:0");
+#elif defined(BACKEND_INTERPRETER)
+  return at::kCPU;
+#else
+  return at::kCUDA;
+#endif
+}
+
+// RuntimeMetrics histograms recorded by the runtime while JIT-compiling and loading a kernel.
+// metadata_parse happens inside module_load and is excluded from the sum.
+static const std::vector<std::string> kPhases = {"interpreter_boot",
+                                                 "python_import",
+                                                 "gen_ssig",
+                                                 "cache_lookup",
+                                                 "compile_a_kernel",
+                                                 "metadata_parse",
+                                                 "module_load"};
+
+static double ms_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static int run_child(const std::string& mode, const std::string& result_path) {
+  auto main_start = std::chrono::steady_clock::now();
+  const at::Device device = bench_device();
+
+  auto t = std::chrono::steady_clock::now();
+  at::Tensor a = at::rand({128 * 1024}, device);
+  at::Tensor b = at::rand({128 * 1024}, device);
+  triton_jit::ops::device_synchronize(device);
+  double device_init_ms = ms_since(t);
+
+  t = std::chrono::steady_clock::now();
+  my_ops::add_tensor(a, b);
+  triton_jit::ops::device_synchronize(device);
+  double first_launch_ms = ms_since(t);
+  double main_to_first_launch_ms = ms_since(main_start);
+
+  t = std::chrono::steady_clock::now();
+  my_ops::add_tensor(a, b);
+  triton_jit::ops::device_synchronize(device);
+  double second_launch_ms = ms_since(t);
+
+  triton_jit::RuntimeMetrics& metrics = triton_jit::RuntimeMetrics::instance();
+  std::ostringstream phases;
+  double jit_ms = 0.0;
+  for (size_t i = 0; i < kPhases.size(); i++) {
+    double ms = static_cast<double>(metrics.histogram("jit/" + kPhases[i]).sum_ns) / 1e6;
+    if (kPhases[i] != "metadata_parse") {
+      jit_ms += ms;
+    }
+    phases << (i ? ", " : "") << fmt::format("\"{}\": {:.3f}", kPhases[i], ms);
+  }
+
+  std::ofstream out(result_path);
+  out << fmt::format(
+      "{{\"mode\": \"{}\", \"device_init_ms\": {:.3f}, \"first_launch_ms\": {:.3f}, "
+      "\"first_launch_outside_jit_ms\": {:.3f}, \"second_launch_ms\": {:.3f}, "
+      "\"main_to_first_launch_ms\": {:.3f}, \"phases_ms\": {{{}}}, \"metrics\": {}}}",
+      mode,
+      device_init_ms,
+      first_launch_ms,
+      first_launch_ms - jit_ms,
+      second_launch_ms,
+      main_to_first_launch_ms,
+      phases.str(),
+      metrics.to_json());
+  return out.good() ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+  if (argc == 4 && std::string(argv[1]) == "--child") {
+    return run_child(argv[2], argv[3]);
+  }
+  std::string out_path;
+  if (argc == 3 && std::string(argv[1]) == "--out") {
+    out_path = argv[2];
+  } else if (argc != 1) {
+    std::cerr << "usage: " << argv[0] << " [--out result.json]\n";
+    return 2;
+  }
+
+  namespace fs = std::filesystem;
+  const fs::path self = fs::read_symlink("/proc/self/exe");
+  const fs::path work_dir = fs::temp_directory_path() / fmt::format("triton_jit_startup_{}", getpid());
+  const fs::path cache_dir = work_dir / "triton_cache";
+  fs::remove_all(work_dir);
+  fs::create_directories(cache_dir);
+
+  struct Mode {
+    const char* name;
+    const char* cache_lookup;
+  };
+  const Mode modes[] = {{"cold", "1"}, {"warm_triton_cache", "0"}, {"warm_runtime_index", "1"}};
+
+  std::ostringstream report;
+  report << fmt::format("{{\"backend\": \"{}\", \"modes\": {{", BACKEND_NAME);
+  int status = 0;
+  for (size_t i = 0; i < std::size(modes); i++) {
+    const fs::path result_path = work_dir / fmt::format("{}.json", modes[i].name);
+    std::string cmd = fmt::format("TRITON_CACHE_DIR='{}' TRITON_JIT_CACHE_LOOKUP={} '{}' --child {} '{}'",
+                                  cache_dir.string(),
+                                  modes[i].cache_lookup,
+                                  self.string(),
+                                  modes[i].name,
+                                  result_path.string());
+    auto t = std::chrono::steady_clock::now();
+    int rc = std::system(cmd.c_str());
+    double process_wall_ms = ms_since(t);
+
+    std::ifstream result(result_path);
+    std::string run((std::istreambuf_iterator<char>(result)), std::istreambuf_iterator<char>());
+    if (rc != 0 || run.empty()) {
+      std::cerr << "mode " << modes[i].name << " failed with status " << rc << "\n";
+      run = "null";
+      status = 1;
+    }
+    report << fmt::format("{}\"{}\": {{\"process_wall_ms\": {:.3f}, \"run\": {}}}",
+                          i ? ", " : "",
+                          modes[i].name,
+                          process_wall_ms,
+                          run);
+    std::cerr << fmt::format("{:<20} process {:10.1f} ms\n", modes[i].name, process_wall_ms);
+  }
+  report << "}}\n";
+  fs::remove_all(work_dir);
+
+  if (out_path.empty()) {
+    std::cout << report.str();
+  } else {
+    std::ofstream(out_path) << report.str();
+  }
+  return status;
+}
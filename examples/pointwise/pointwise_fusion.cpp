@@ -0,0 +1,541 @@
+#include "pointwise_fusion.h"
+
+#include <unistd.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+
+#include "common/backend_ops.h"
+#include "fmt/core.h"
+#include "fmt/ranges.h"
+#include "triton_jit/jit_utils.h"
+#include "triton_jit/runtime_metrics.h"
+#include "triton_jit/triton_jit_function.h"
+
+namespace my_ops {
+using namespace triton_jit;
+
+namespace {
+
+const char* tl_dtype(at::ScalarType t) {
+  switch (t) {
+    case at::ScalarType::Float:
+      return "tl.float32";
+    case at::ScalarType::Double:
+      return "tl.float64";
+    case at::ScalarType::Half:
+      return "tl.float16";
+    case at::ScalarType::BFloat16:
+      return "tl.bfloat16";
+    case at::ScalarType::Int:
+      return "tl.int32";
+    case at::ScalarType::Long:
+      return "tl.int64";
+    case at::ScalarType::Short:
+      return "tl.int16";
+    case at::ScalarType::Char:
+      return "tl.int8";
+    case at::ScalarType::Byte:
+      return "tl.uint8";
+    case at::ScalarType::Bool:
+      return "tl.int1";
+    default:
+      TORCH_CHECK(false, "PointwiseFusion: unsupported dtype ", t);
+  }
+}
+
+// Half precision values are computed in fp32 and rounded when stored
+at::ScalarType compute_dtype(at::ScalarType t) {
+  return t == at::ScalarType::Half || t == at::ScalarType::BFloat16 ? at::ScalarType::Float : t;
+}
+
+int category(at::ScalarType t) {
+  return t == at::ScalarType::Bool ? 0 : at::isFloatingType(t) ? 2 : 1;
+}
+
+// Result of ops such as exp and true division on integers
+at::ScalarType floating(at::ScalarType t, bool wrapped) {
+  if (at::isFloatingType(t)) {
+    return t;
+  }
+  return wrapped ? at::ScalarType::Double : at::typeMetaToScalarType(at::get_default_dtype());
+}
+
+const char* op_name(PointwiseOp op) {
+  // indexed by PointwiseOp
+  static const char* names[] = {
+      "input",
+      "scalar",
+      "add",
+      "sub",
+      "mul",
+      "div",
+      "maximum",
+      "minimum",
+      "neg",
+      "abs",
+      "exp",
+      "log",
+      "sqrt",
+      "rsqrt",
+      "sigmoid",
+      "tanh",
+      "relu",
+      "silu",
+      "gelu",
+      "cast",
+  };
+  return names[static_cast<int>(op)];
+}
+
+std::string expression(PointwiseOp op, const std::string& a, const std::string& b) {
+  switch (op) {
+    case PointwiseOp::ADD:
+      return fmt::format("{} + {}", a, b);
+    case PointwiseOp::SUB:
+      return fmt::format("{} - {}", a, b);
+    case PointwiseOp::MUL:
+      return fmt::format("{} * {}", a, b);
+    case PointwiseOp::DIV:
+      return fmt::format("{} / {}", a, b);
+    case PointwiseOp::MAXIMUM:
+      return fmt::format("tl.maximum({}, {})", a, b);
+    case PointwiseOp::MINIMUM:
+      return fmt::format("tl.minimum({}, {})", a, b);
+    case PointwiseOp::NEG:
+      return fmt::format("-{}", a);
+    case PointwiseOp::ABS:
+      return fmt::format("tl.abs({})", a);
+    case PointwiseOp::EXP:
+      return fmt::format("tl.exp({})", a);
+    case PointwiseOp::LOG:
+      return fmt::format("tl.log({})", a);
+    case PointwiseOp::SQRT:
+      return fmt::format("tl.sqrt({})", a);
+    case PointwiseOp::RSQRT:
+      return fmt::format("tl.rsqrt({})", a);
+    case PointwiseOp::SIGMOID:
+      return fmt::format("tl.sigmoid({})", a);
+    case PointwiseOp::TANH:
+      // tanh is not in triton.language on every backend
+      return fmt::format("2.0 * tl.sigmoid(2.0 * {}) - 1.0", a);
+    case PointwiseOp::RELU:
+      return fmt::format("tl.where({0} > 0, {0}, 0)", a);
+    case PointwiseOp::SILU:
+      return fmt::format("{0} * tl.sigmoid({0})", a);
+    case PointwiseOp::GELU:
+      return fmt::format("0.5 * {0} * (1.0 + tl.erf({0} * 0.7071067811865476))", a);
+    case PointwiseOp::CAST:
+      return a;
+    default:
+      TORCH_CHECK(false, "PointwiseFusion: ", op_name(op), " is not an expression");
+  }
+}
+
+std::filesystem::path fusion_dir() {
+  const char* dir = std::getenv("TRITON_JIT_FUSION_DIR");
+  if (dir != nullptr && dir[0] != '\0') {
+    return dir;
+  }
+  return get_home_directory() / ".triton_jit" / "fused";
+}
+
+// Write through a temporary file so that concurrent processes never import a partial source
+void write_source(const std::filesystem::path& path, const std::string& source) {
+  if (std::filesystem::exists(path)) {
+    return;
+  }
+  std::filesystem::create_directories(path.parent_path());
+  std::filesystem::path tmp = path;
+  tmp += fmt::format(".tmp{}", getpid());
+  {
+    std::ofstream out(tmp);
+    out << source;
+    TORCH_CHECK(out.good(), "PointwiseFusion: failed to write ", tmp.string());
+  }
+  std::filesystem::rename(tmp, path);
+}
+
+}  // namespace
+
+PointwiseValue PointwiseFusion::input(const at::Tensor& t) {
+  TORCH_CHECK(inputs_.empty() || t.device() == inputs_[0].device(),
+              "PointwiseFusion: inputs must be on one device, got ",
+              inputs_[0].device(),
+              " and ",
+              t.device());
+  tl_dtype(t.scalar_type());
+  nodes_.push_back({PointwiseOp::INPUT, -1, -1, t.scalar_type(), false, static_cast<int>(inputs_.size())});
+  inputs_.push_back(t);
+  return {static_cast<int>(nodes_.size()) - 1};
+}
+
+PointwiseValue PointwiseFusion::scalar(double v) {
+  const int slot = static_cast<int>(scalars_.size());
+  nodes_.push_back({PointwiseOp::SCALAR, -1, -1, at::ScalarType::Double, /*wrapped=*/true, slot});
+  scalars_.emplace_back(v);
+  return {static_cast<int>(nodes_.size()) - 1};
+}
+
+PointwiseValue PointwiseFusion::scalar(int64_t v) {
+  const int slot = static_cast<int>(scalars_.size());
+  nodes_.push_back({PointwiseOp::SCALAR, -1, -1, at::ScalarType::Long, /*wrapped=*/true, slot});
+  scalars_.emplace_back(v);
+  return {static_cast<int>(nodes_.size()) - 1};
+}
+
+const PointwiseFusion::Node& PointwiseFusion::node(PointwiseValue v) const {
+  TORCH_CHECK(v.id >= 0 && v.id < static_cast<int>(nodes_.size()),
+              "PointwiseFusion: value ",
+              v.id,
+              " does not belong to this graph");
+  return nodes_[v.id];
+}
+
+at::ScalarType PointwiseFusion::dtype(PointwiseValue v) const {
+  return node(v).dtype;
+}
+
+PointwiseValue PointwiseFusion::unary(PointwiseOp op, PointwiseValue a, at::ScalarType dtype) {
+  const Node& x = node(a);
+  nodes_.push_back({op, a.id, -1, dtype, x.wrapped});
+  return {static_cast<int>(nodes_.size()) - 1};
+}
+
+PointwiseValue PointwiseFusion::binary(PointwiseOp op, PointwiseValue a, PointwiseValue b, bool true_div) {
+  const Node& x = node(a);
+  const Node& y = node(b);
+  at::ScalarType dtype;
+  if (x.wrapped == y.wrapped) {
+    dtype = at::promote_types(x.dtype, y.dtype);
+  } else {
+    // a wrapped number only promotes a tensor of a lower category: int tensor * 0.5 is float
+    const Node& t = x.wrapped ? y : x;
+    const Node& w = x.wrapped ? x : y;
+    if (category(w.dtype) <= category(t.dtype)) {
+      dtype = t.dtype;
+    } else if (category(w.dtype) == 2) {
+      dtype = at::typeMetaToScalarType(at::get_default_dtype());
+    } else {
+      dtype = at::ScalarType::Long;
+    }
+  }
+  bool wrapped = x.wrapped && y.wrapped;
+  if (true_div) {
+    dtype = floating(dtype, wrapped);
+  }
+  nodes_.push_back({op, a.id, b.id, dtype, wrapped});
+  return {static_cast<int>(nodes_.size()) - 1};
+}
+
+PointwiseValue PointwiseFusion::add(PointwiseValue a, PointwiseValue b) {
+  return binary(PointwiseOp::ADD, a, b);
+}
+
+PointwiseValue PointwiseFusion::sub(PointwiseValue a, PointwiseValue b) {
+  return binary(PointwiseOp::SUB, a, b);
+}
+
+PointwiseValue PointwiseFusion::mul(PointwiseValue a, PointwiseValue b) {
+  return binary(PointwiseOp::MUL, a, b);
+}
+
+PointwiseValue PointwiseFusion::div(PointwiseValue a, PointwiseValue b) {
+  return binary(PointwiseOp::DIV, a, b, /*true_div=*/true);
+}
+
+PointwiseValue PointwiseFusion::maximum(PointwiseValue a, PointwiseValue b) {
+  return binary(PointwiseOp::MAXIMUM, a, b);
+}
+
+PointwiseValue PointwiseFusion::minimum(PointwiseValue a, PointwiseValue b) {
+  return binary(PointwiseOp::MINIMUM, a, b);
+}
+
+PointwiseValue PointwiseFusion::neg(PointwiseValue a) {
+  return unary(PointwiseOp::NEG, a, node(a).dtype);
+}
+
+PointwiseValue PointwiseFusion::abs(PointwiseValue a) {
+  return unary(PointwiseOp::ABS, a, node(a).dtype);
+}
+
+PointwiseValue PointwiseFusion::relu(PointwiseValue a) {
+  return unary(PointwiseOp::RELU, a, node(a).dtype);
+}
+
+#define DEFINE_FLOATING_UNARY(method, OP)                              \
+  PointwiseValue PointwiseFusion::method(PointwiseValue a) {           \
+    const Node& x = node(a);                                           \
+    return unary(PointwiseOp::OP, a, floating(x.dtype, x.wrapped));    \
+  }
+
+DEFINE_FLOATING_UNARY(exp, EXP)
+DEFINE_FLOATING_UNARY(log, LOG)
+DEFINE_FLOATING_UNARY(sqrt, SQRT)
+DEFINE_FLOATING_UNARY(rsqrt, RSQRT)
+DEFINE_FLOATING_UNARY(sigmoid, SIGMOID)
+DEFINE_FLOATING_UNARY(tanh, TANH)
+DEFINE_FLOATING_UNARY(silu, SILU)
+DEFINE_FLOATING_UNARY(gelu, GELU)
+
+#undef DEFINE_FLOATING_UNARY
+
+PointwiseValue PointwiseFusion::cast(PointwiseValue a, at::ScalarType dtype) {
+  tl_dtype(dtype);
+  PointwiseValue v = unary(PointwiseOp::CAST, a, dtype);
+  nodes_.back().wrapped = false;
+  return v;
+}
+
+PointwiseFusion::Layout PointwiseFusion::layout() const {
+  TORCH_CHECK(!inputs_.empty(), "PointwiseFusion: the graph needs at least one tensor input");
+  Layout l;
+  l.shape = inputs_[0].sizes().vec();
+  for (const at::Tensor& t : inputs_) {
+    l.shape = at::infer_size(l.shape, t.sizes());
+  }
+  l.numel = c10::multiply_integers(l.shape);
+
+  // operand strides over the broadcast shape, the contiguous output last
+  const size_t num_operands = inputs_.size() + 1;
+  std::vector<std::vector<int64_t>> full;
+  for (const at::Tensor& t : inputs_) {
+    full.push_back(t.expand(l.shape).strides().vec());
+  }
+  std::vector<int64_t> out_strides(l.shape.size(), 1);
+  for (int d = static_cast<int>(l.shape.size()) - 2; d >= 0; d--) {
+    out_strides[d] = out_strides[d + 1] * l.shape[d + 1];
+  }
+  full.push_back(out_strides);
+
+  // merge a dimension into the inner one when every operand walks both as one
+  std::vector<std::vector<int64_t>> merged(num_operands);
+  for (int d = static_cast<int>(l.shape.size()) - 1; d >= 0; d--) {
+    if (l.shape[d] == 1) {
+      continue;
+    }
+    bool mergeable = !l.sizes.empty();
+    for (size_t op = 0; mergeable && op < num_operands; op++) {
+      mergeable = full[op][d] == merged[op].back() * l.sizes.back();
+    }
+    if (mergeable) {
+      l.sizes.back() *= l.shape[d];
+      continue;
+    }
+    l.sizes.push_back(l.shape[d]);
+    for (size_t op = 0; op < num_operands; op++) {
+      merged[op].push_back(full[op][d]);
+    }
+  }
+  if (l.sizes.empty()) {
+    l.sizes.push_back(1);
+    for (auto& strides : merged) {
+      strides.push_back(1);
+    }
+  }
+  std::reverse(l.sizes.begin(), l.sizes.end());
+  for (auto& strides : merged) {
+    std::reverse(strides.begin(), strides.end());
+  }
+
+  for (size_t i = 0; i < inputs_.size(); i++) {
+    l.strides.push_back(merged[i] == merged.back() ? std::vector<int64_t> {} : merged[i]);
+  }
+  return l;
+}
+
+const PointwiseFusion::Kernel& PointwiseFusion::kernel(const std::vector<PointwiseValue>& outputs,
+                                                       const Layout& layout) const {
+  // everything the generated source depends on
+  const size_t rank = layout.sizes.size();
+  std::string key = fmt::format("rank={};", rank);
+  for (size_t i = 0; i < inputs_.size(); i++) {
+    key += fmt::format("{}{},",
+                       to_triton_typename(inputs_[i].scalar_type()),
+                       layout.strides[i].empty() ? "" : "/strided");
+  }
+  for (const Node& n : nodes_) {
+    key += fmt::format(";{}({},{}):{}", op_name(n.op), n.lhs, n.rhs, to_triton_typename(n.dtype));
+  }
+  key += ";out";
+  for (PointwiseValue v : outputs) {
+    key += fmt::format(",{}", v.id);
+  }
+
+  static std::mutex mutex;
+  static std::unordered_map<std::string, Kernel> kernels;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = kernels.find(key);
+  if (it != kernels.end()) {
+    return it->second;
+  }
+
+  std::vector<std::string> params;
+  for (size_t i = 0; i < inputs_.size(); i++) {
+    params.push_back(fmt::format("in{}", i));
+  }
+  for (size_t i = 0; i < scalars_.size(); i++) {
+    params.push_back(fmt::format("s{}", i));
+  }
+  for (size_t i = 0; i < outputs.size(); i++) {
+    params.push_back(fmt::format("out{}", i));
+  }
+  params.push_back("n");
+  for (size_t d = 1; d < rank; d++) {
+    params.push_back(fmt::format("size{}", d));
+  }
+  for (size_t i = 0; i < inputs_.size(); i++) {
+    for (size_t d = 0; d < layout.strides[i].size(); d++) {
+      params.push_back(fmt::format("in{}_stride{}", i, d));
+    }
+  }
+  params.push_back("BLOCK_N: tl.constexpr");
+
+  std::string body;
+  auto line = [&body](const std::string& s) { body += fmt::format("        {}\n", s); };
+  line("offsets = tile.to(tl.int64) * BLOCK_N + tl.arange(0, BLOCK_N)");
+  line("mask = offsets < n");
+  bool any_strided = std::any_of(layout.strides.begin(), layout.strides.end(), [](const auto& s) {
+    return !s.empty();
+  });
+  if (any_strided) {
+    line("rem = offsets");
+    for (size_t d = rank - 1; d > 0; d--) {
+      line(fmt::format("i{} = rem % size{}", d, d));
+      line(fmt::format("rem = rem // size{}", d));
+    }
+    line("i0 = rem");
+  }
+
+  auto operand = [this](int id, at::ScalarType to) {
+    at::ScalarType from = compute_dtype(nodes_[id].dtype);
+    return from == to ? fmt::format("v{}", id) : fmt::format("tl.cast(v{}, {})", id, tl_dtype(to));
+  };
+  for (size_t id = 0; id < nodes_.size(); id++) {
+    const Node& n = nodes_[id];
+    const at::ScalarType c = compute_dtype(n.dtype);
+    if (n.op == PointwiseOp::INPUT) {
+      std::string offset = "offsets";
+      if (!layout.strides[n.slot].empty()) {
+        std::vector<std::string> terms;
+        for (size_t d = 0; d < rank; d++) {
+          terms.push_back(fmt::format("i{} * in{}_stride{}", d, n.slot, d));
+        }
+        offset = fmt::format("{}", fmt::join(terms, " + "));
+      }
+      std::string load = fmt::format("tl.load(in{} + ({}), mask=mask)", n.slot, offset);
+      if (c != n.dtype) {
+        load = fmt::format("tl.cast({}, {})", load, tl_dtype(c));
+      }
+      line(fmt::format("v{} = {}", id, load));
+    } else if (n.op == PointwiseOp::SCALAR) {
+      // also turns a scalar specialized to the constant 1 into a typed value
+      line(fmt::format("v{} = tl.cast(s{}, {})", id, n.slot, tl_dtype(c)));
+    } else {
+      std::string b = n.rhs < 0 ? "" : operand(n.rhs, c);
+      line(fmt::format("v{} = {}", id, expression(n.op, operand(n.lhs, c), b)));
+    }
+  }
+  for (size_t i = 0; i < outputs.size(); i++) {
+    const Node& n = nodes_[outputs[i].id];
+    std::string value = fmt::format("v{}", outputs[i].id);
+    if (compute_dtype(n.dtype) != n.dtype) {
+      value = fmt::format("tl.cast({}, {})", value, tl_dtype(n.dtype));
+    }
+    line(fmt::format("tl.store(out{} + offsets, {}, mask=mask)", i, value));
+  }
+
+  // the name is derived from the rest of the source
+  std::string signature_and_body = fmt::format(
+      "({}):\n"
+      "    pid = tl.program_id(0)\n"
+      "    num_tiles = tl.cdiv(n, BLOCK_N)\n"
+      "    for tile in range(pid, num_tiles, tl.num_programs(0)):\n"
+      "{}",
+      fmt::join(params, ", "),
+      body);
+  std::string name =
+      fmt::format("fused_{:016x}", hash_bytes(signature_and_body.data(), signature_and_body.size()));
+  std::string source = fmt::format(
+      "# Generated by PointwiseFusion, graph: {}\n"
+      "import triton\n"
+      "from triton import language as tl\n"
+      "\n"
+      "\n"
+      "@triton.jit\n"
+      "def {}{}",
+      key,
+      name,
+      signature_and_body);
+
+  std::filesystem::path path = fusion_dir() / (name + ".py");
+  write_source(path, source);
+  RuntimeMetrics::instance().add("fusion/kernels_generated");
+  LOG(INFO) << "PointwiseFusion: " << key << " -> " << path.string();
+  return kernels.emplace(key, Kernel {path, name}).first->second;
+}
+
+std::filesystem::path PointwiseFusion::kernel_source(const std::vector<PointwiseValue>& outputs) const {
+  return kernel(outputs, layout()).path;
+}
+
+std::vector<at::Tensor> PointwiseFusion::run(const std::vector<PointwiseValue>& outputs) const {
+  TORCH_CHECK(!outputs.empty(), "PointwiseFusion: no outputs requested");
+  const Layout l = layout();
+  const at::Device device = inputs_[0].device();
+  std::vector<at::Tensor> results;
+  for (PointwiseValue v : outputs) {
+    results.push_back(triton_jit::ops::backend_empty(l.shape, node(v).dtype, device));
+  }
+  if (l.numel == 0) {
+    return results;
+  }
+  const Kernel& k = kernel(outputs, l);
+  const TritonJITFunction& f = TritonJITFunction::get_instance(k.path.string(), k.name);
+
+  constexpr int64_t tile_size = 1024;
+  constexpr int num_warps = 8;
+  constexpr int num_stages = 1;
+  const unsigned int num_tiles = (l.numel + tile_size - 1) / tile_size;
+  const unsigned int num_blocks = triton_jit::ops::plan_num_blocks(num_tiles, "aiv");
+
+  // the argument count depends on the graph, so pack them here instead of with operator()
+  ParameterBuffer buffer;
+  c10::SmallVector<std::string> signature;
+  ArgHandle handler = {f.get_static_sig(), buffer, signature, 0};
+  for (const at::Tensor& t : inputs_) {
+    handler.handle_arg(t);
+  }
+  for (const c10::Scalar& s : scalars_) {
+    handler.handle_arg(s);
+  }
+  for (const at::Tensor& out : results) {
+    handler.handle_arg(out);
+  }
+  handler.handle_arg(l.numel);
+  for (size_t d = 1; d < l.sizes.size(); d++) {
+    handler.handle_arg(l.sizes[d]);
+  }
+  for (const auto& strides : l.strides) {
+    for (int64_t stride : strides) {
+      handler.handle_arg(stride);
+    }
+  }
+  handler.handle_arg(tile_size);
+#if !defined(BACKEND_NPU) && !defined(BACKEND_INTERPRETER)
+  handler.append_global_scratch();
+  handler.append_global_scratch();
+#endif
+
+  c10::DeviceGuard guard(device);
+  triton_jit::ops::RawStream stream = triton_jit::ops::get_device_stream(inputs_[0]);
+  c10::SmallVector<void*> ptrs = buffer.get_ptrs();
+  f.launch_with_raw_args(
+      stream, num_blocks, 1, 1, num_warps, num_stages, join_sig(signature), ptrs.data(), ptrs.size());
+  return results;
+}
+
+}  // namespace my_ops
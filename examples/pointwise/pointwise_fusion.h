@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "torch/torch.h"
+
+namespace my_ops {
+
+enum class PointwiseOp : uint8_t {
+  INPUT,
+  SCALAR,
+  ADD,
+  SUB,
+  MUL,
+  DIV,
+  MAXIMUM,
+  MINIMUM,
+  NEG,
+  ABS,
+  EXP,
+  LOG,
+  SQRT,
+  RSQRT,
+  SIGMOID,
+  TANH,
+  RELU,
+  SILU,
+  GELU,
+  CAST,
+};
+
+/// A node of a PointwiseFusion graph
+struct PointwiseValue {
+  int id = -1;
+};
+
+/**
+ * @brief Builds a chain of elementwise ops and runs it as one generated Triton kernel
+ *
+ * Inputs are broadcast together and dtypes are promoted as in torch, with scalars
+ * taking part as wrapped numbers. Half precision values are computed in fp32.
+ *
+ *   PointwiseFusion g;
+ *   PointwiseValue x = g.input(a), y = g.input(b);
+ *   PointwiseValue z = g.silu(g.add(g.mul(x, y), g.scalar(1.0)));
+ *   at::Tensor out = g.run({z})[0];
+ *
+ * The kernel source is generated once per graph structure (ops, dtypes and the
+ * collapsed layout of the inputs), written under $TRITON_JIT_FUSION_DIR
+ * (default ~/.triton_jit/fused) with a name derived from a hash of its content,
+ * and launched through TritonJITFunction like any other kernel. Every input is read
+ * and every output is written once, however long the chain.
+ */
+class PointwiseFusion {
+ public:
+  PointwiseValue input(const at::Tensor& t);
+  PointwiseValue scalar(double v);
+  PointwiseValue scalar(int64_t v);
+
+  PointwiseValue add(PointwiseValue a, PointwiseValue b);
+  PointwiseValue sub(PointwiseValue a, PointwiseValue b);
+  PointwiseValue mul(PointwiseValue a, PointwiseValue b);
+  PointwiseValue div(PointwiseValue a, PointwiseValue b);
+  PointwiseValue maximum(PointwiseValue a, PointwiseValue b);
+  PointwiseValue minimum(PointwiseValue a, PointwiseValue b);
+
+  PointwiseValue neg(PointwiseValue a);
+  PointwiseValue abs(PointwiseValue a);
+  PointwiseValue exp(PointwiseValue a);
+  PointwiseValue log(PointwiseValue a);
+  PointwiseValue sqrt(PointwiseValue a);
+  PointwiseValue rsqrt(PointwiseValue a);
+  PointwiseValue sigmoid(PointwiseValue a);
+  PointwiseValue tanh(PointwiseValue a);
+  PointwiseValue relu(PointwiseValue a);
+  PointwiseValue silu(PointwiseValue a);
+  /// erf formulation, as torch.nn.functional.gelu(approximate="none")
+  PointwiseValue gelu(PointwiseValue a);
+  PointwiseValue cast(PointwiseValue a, at::ScalarType dtype);
+
+  /// Result dtype of a value
+  at::ScalarType dtype(PointwiseValue v) const;
+
+  /// Allocate the outputs with the broadcast shape and compute them in a single launch
+  std::vector<at::Tensor> run(const std::vector<PointwiseValue>& outputs) const;
+
+  /// Path of the generated kernel source run() launches for these outputs, generating it if needed
+  std::filesystem::path kernel_source(const std::vector<PointwiseValue>& outputs) const;
+
+ private:
+  struct Node {
+    PointwiseOp op;
+    int lhs = -1;
+    int rhs = -1;
+    at::ScalarType dtype;
+    /// Python number: does not take part in promotion against tensors of the same category
+    bool wrapped = false;
+    /// Index into inputs_ or scalars_
+    int slot = -1;
+  };
+
+  /// Inputs broadcast to the output shape, with dimensions merged where all operands allow it
+  struct Layout {
+    std::vector<int64_t> shape;
+    int64_t numel = 0;
+    std::vector<int64_t> sizes;
+    /// Per input, strides over `sizes`; empty for inputs laid out like the output
+    std::vector<std::vector<int64_t>> strides;
+  };
+
+  struct Kernel {
+    std::filesystem::path path;
+    std::string name;
+  };
+
+  PointwiseValue unary(PointwiseOp op, PointwiseValue a, at::ScalarType dtype);
+  PointwiseValue binary(PointwiseOp op, PointwiseValue a, PointwiseValue b, bool true_div = false);
+  const Node& node(PointwiseValue v) const;
+
+  Layout layout() const;
+  const Kernel& kernel(const std::vector<PointwiseValue>& outputs, const Layout& layout) const;
+
+  std::vector<Node> nodes_;
+  std::vector<at::Tensor> inputs_;
+  std::vector<c10::Scalar> scalars_;
+};
+
+}  // namespace my_ops
@@ -8,6 +8,8 @@ static at::Device test_device() {
   return at::Device("npu:0");
 #elif defined(BACKEND_MUSA)
   return at::Device("musa:0");
+#elif defined(BACKEND_INTERPRETER)
+  return at::kCPU;
 #else
   return at::kCUDA;
 #endif
@@ -30,3 +32,36 @@ TEST(add_test, broadcast) {
   at::Tensor expected = at::add(a, b);
   EXPECT_TRUE(torch::allclose(result, expected));
 }
+
+TEST(add_test, out_reuses_buffer) {
+  at::Tensor a = at::rand({256, 128}, test_device());
+  at::Tensor b = at::rand({128}, test_device());
+  at::Tensor out = at::empty({256, 128}, a.options());
+  void* buffer = out.data_ptr();
+
+  at::Tensor& result = my_ops::add_tensor_out(a, b, out);
+  EXPECT_EQ(result.data_ptr(), buffer);
+  EXPECT_TRUE(torch::allclose(out, at::add(a, b)));
+}
+
+TEST(add_test, inplace) {
+  at::Tensor a = at::rand({128 * 1024}, test_device());
+  at::Tensor b = at::rand({128 * 1024}, test_device());
+  at::Tensor expected = at::add(a, b);
+  void* buffer = a.data_ptr();
+
+  my_ops::add_tensor_(a, b);
+  EXPECT_EQ(a.data_ptr(), buffer);
+  EXPECT_TRUE(torch::allclose(a, expected));
+}
+
+TEST(add_test, out_mismatch_throws) {
+  at::Tensor a = at::rand({256, 128}, test_device());
+  at::Tensor b = at::rand({256, 128}, test_device());
+  at::Tensor wrong_shape = at::empty({128, 256}, a.options());
+  at::Tensor wrong_dtype = at::empty({256, 128}, a.options().dtype(at::kDouble));
+  at::Tensor non_contiguous = at::empty({128, 256}, a.options()).t();
+  EXPECT_THROW(my_ops::add_tensor_out(a, b, wrong_shape), c10::Error);
+  EXPECT_THROW(my_ops::add_tensor_out(a, b, wrong_dtype), c10::Error);
+  EXPECT_THROW(my_ops::add_tensor_out(a, b, non_contiguous), c10::Error);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+#include "common/backend_ops.h"
+#include "torch/torch.h"
+#include "triton_jit/async_launcher.h"
+#include "triton_jit/runtime_metrics.h"
+#include "triton_jit/triton_jit_function.h"
+
+using namespace triton_jit;
+
+static at::Device test_device() {
+#if defined(BACKEND_NPU)
+  return at::Device("npu:0");
+#elif defined(BACKEND_MUSA)
+  return at::Device("musa:0");
+#elif defined(BACKEND_INTERPRETER)
+  return at::kCPU;
+#else
+  return at::kCUDA;
+#endif
+}
+
+TEST(async_launch_test, launches_from_many_threads) {
+  constexpr int kThreads = 4;
+  constexpr int kLaunchesPerThread = 16;
+  constexpr int64_t n = 64 * 1024;
+  constexpr int64_t tile_size = 1024;
+  const TritonJITFunction& f =
+      TritonJITFunction::get_instance(std::string("add.py"), "binary_pointwise_kernel");
+  AsyncLauncher& launcher = AsyncLauncher::instance();
+
+  // every thread accumulates into its own buffer, launch after launch on one stream
+  std::vector<at::Tensor> acc;
+  at::Tensor one = at::ones({n}, test_device());
+  for (int i = 0; i < kThreads; i++) {
+    acc.push_back(at::zeros({n}, test_device()));
+  }
+  c10::DeviceGuard guard(one.device());
+  ops::RawStream stream = ops::get_device_stream(one);
+  const unsigned int num_blocks = ops::plan_num_blocks((n + tile_size - 1) / tile_size, "aiv");
+
+  std::vector<std::thread> threads;
+  std::vector<std::vector<std::future<void>>> futures(kThreads);
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t]() {
+      c10::DeviceGuard thread_guard(one.device());
+      for (int i = 0; i < kLaunchesPerThread; i++) {
+        futures[t].push_back(
+            launcher.submit(f, stream, num_blocks, 1, 1, 8, 1, acc[t], one, acc[t], n, tile_size));
+      }
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  launcher.flush();
+  EXPECT_EQ(launcher.pending(), 0);
+  for (auto& thread_futures : futures) {
+    for (std::future<void>& fut : thread_futures) {
+      EXPECT_NO_THROW(fut.get());
+    }
+  }
+  ops::device_synchronize(one.device());
+  for (const at::Tensor& a : acc) {
+    EXPECT_TRUE(torch::equal(a, at::full({n}, kLaunchesPerThread, a.options())));
+  }
+}
+
+TEST(async_launch_test, errors_reach_the_future) {
+  const TritonJITFunction& f =
+      TritonJITFunction::get_instance(std::string("add.py"), "binary_pointwise_kernel");
+  at::Tensor a = at::ones({16}, test_device());
+  c10::DeviceGuard guard(a.device());
+  ops::RawStream stream = ops::get_device_stream(a);
+  // one argument more than the kernel has parameters
+  std::future<void> fut = AsyncLauncher::instance().submit(
+      f, stream, 1, 1, 1, 8, 1, a, a, a, static_cast<int64_t>(16), static_cast<int64_t>(1024), 0);
+  EXPECT_ANY_THROW(fut.get());
+}
+
+TEST(async_launch_test, compiles_on_the_launcher_thread) {
+  // this thread started the interpreter; the launcher thread then needs the GIL to build an
+  // overload nobody has launched yet (fp64, BLOCK_N = 2048)
+  const TritonJITFunction& f =
+      TritonJITFunction::get_instance(std::string("add.py"), "binary_pointwise_kernel");
+  constexpr int64_t n = 10000;
+  constexpr int64_t tile_size = 2048;
+  at::TensorOptions opts = at::TensorOptions().dtype(at::kDouble).device(test_device());
+  at::Tensor x = at::rand({n}, opts);
+  at::Tensor y = at::rand({n}, opts);
+  at::Tensor queued_out = at::empty_like(x);
+  at::Tensor direct_out = at::empty_like(x);
+  c10::DeviceGuard guard(x.device());
+  ops::RawStream stream = ops::get_device_stream(x);
+  const unsigned int num_blocks = ops::plan_num_blocks((n + tile_size - 1) / tile_size, "aiv");
+  const uint64_t overload_misses = RuntimeMetrics::instance().histogram("jit/python_import").count;
+
+  std::future<void> fut = AsyncLauncher::instance().submit(
+      f, stream, num_blocks, 1, 1, 4, 1, x, y, queued_out, n, tile_size);
+  ASSERT_EQ(fut.wait_for(std::chrono::minutes(5)), std::future_status::ready)
+      << "the launcher thread did not get the GIL";
+  EXPECT_NO_THROW(fut.get());
+  EXPECT_GT(RuntimeMetrics::instance().histogram("jit/python_import").count, overload_misses);
+
+  // the same function launched directly while the launcher has it queued
+  std::future<void> queued = AsyncLauncher::instance().submit(
+      f, stream, num_blocks, 1, 1, 4, 1, x, y, queued_out, n, tile_size);
+  f(stream, num_blocks, 1, 1, 4, 1, x, y, direct_out, n, tile_size);
+  EXPECT_NO_THROW(queued.get());
+  ops::device_synchronize(x.device());
+  EXPECT_TRUE(torch::equal(queued_out, x + y));
+  EXPECT_TRUE(torch::equal(direct_out, x + y));
+}
@@ -0,0 +1,23 @@
+#include <gtest/gtest.h>
+#include "common/backend_ops.h"
+#include "torch/torch.h"
+#include "triton_jit/triton_jit_function.h"
+
+using namespace triton_jit;
+
+// Built for the INTERPRETER backend only: every tensor argument crosses into
+// interpret_launch.py as (address, nbytes, dtype) and is rebuilt as a host tensor there
+TEST(interpreter_launch_test, tensor_dtypes) {
+  const TritonJITFunction& f =
+      TritonJITFunction::get_instance(std::string("add.py"), "binary_pointwise_kernel");
+  constexpr int64_t n = 1000;
+  constexpr int64_t tile_size = 256;
+  for (at::ScalarType dtype :
+       {at::kFloat, at::kDouble, at::kHalf, at::kBFloat16, at::kInt, at::kLong, at::kByte}) {
+    at::Tensor x = at::randint(0, 100, {n}, at::TensorOptions().dtype(dtype));
+    at::Tensor y = at::randint(0, 100, {n}, at::TensorOptions().dtype(dtype));
+    at::Tensor out = at::empty_like(x);
+    f(ops::get_device_stream(x), (n + tile_size - 1) / tile_size, 1, 1, 4, 1, x, y, out, n, tile_size);
+    EXPECT_TRUE(torch::equal(out, x + y)) << dtype;
+  }
+}
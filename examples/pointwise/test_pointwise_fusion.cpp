@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "pointwise_fusion.h"
+#include "torch/torch.h"
+#include "triton_jit/backend_config.h"
+#include "triton_jit/runtime_metrics.h"
+
+static at::Device test_device() {
+#if defined(BACKEND_NPU)
+  return at::Device("npu:0");
+#elif defined(BACKEND_MUSA)
+  return at::Device("musa:0");
+#elif defined(BACKEND_INTERPRETER)
+  return at::kCPU;
+#else
+  return at::kCUDA;
+#endif
+}
+
+TEST(pointwise_fusion_test, chain) {
+  at::Tensor a = at::randn({128 * 1024}, test_device());
+  at::Tensor b = at::randn({128 * 1024}, test_device());
+
+  my_ops::PointwiseFusion g;
+  my_ops::PointwiseValue x = g.input(a);
+  my_ops::PointwiseValue y = g.input(b);
+  my_ops::PointwiseValue z = g.silu(g.add(g.mul(x, y), g.scalar(1.0)));
+  at::Tensor result = g.run({z})[0];
+
+  at::Tensor expected = at::silu(a * b + 1.0);
+  EXPECT_TRUE(torch::allclose(result, expected, 1e-5, 1e-5));
+}
+
+TEST(pointwise_fusion_test, broadcast_and_strided_inputs) {
+  at::Tensor a = at::rand({64, 256}, test_device()).t();
+  at::Tensor b = at::rand({64}, test_device());
+
+  my_ops::PointwiseFusion g;
+  my_ops::PointwiseValue z = g.relu(g.sub(g.input(a), g.input(b)));
+  at::Tensor result = g.run({z})[0];
+
+  at::Tensor expected = at::relu(a - b);
+  EXPECT_EQ(result.sizes(), expected.sizes());
+  EXPECT_TRUE(torch::allclose(result, expected));
+}
+
+TEST(pointwise_fusion_test, dtype_promotion) {
+  at::Tensor a = at::randint(0, 100, {4096}, at::TensorOptions().dtype(at::kInt).device(test_device()));
+  at::Tensor h = at::randn({4096}, at::TensorOptions().dtype(at::kHalf).device(test_device()));
+
+  my_ops::PointwiseFusion g;
+  my_ops::PointwiseValue x = g.input(a);
+  my_ops::PointwiseValue y = g.input(h);
+  my_ops::PointwiseValue scaled = g.mul(x, g.scalar(int64_t(3)));
+  my_ops::PointwiseValue halved = g.div(x, g.scalar(int64_t(2)));
+  my_ops::PointwiseValue mixed = g.add(y, g.scalar(0.5));
+  EXPECT_EQ(g.dtype(scaled), at::kInt);
+  EXPECT_EQ(g.dtype(halved), at::kFloat);
+  EXPECT_EQ(g.dtype(mixed), at::kHalf);
+  EXPECT_EQ(g.dtype(g.add(x, y)), at::kHalf);
+
+  std::vector<at::Tensor> out = g.run({scaled, halved, mixed});
+  EXPECT_TRUE(torch::equal(out[0], a * 3));
+  EXPECT_TRUE(torch::allclose(out[1], a / 2));
+  EXPECT_TRUE(torch::allclose(out[2], h + 0.5, 1e-3, 1e-3));
+}
+
+TEST(pointwise_fusion_test, cast_and_gelu) {
+  at::Tensor a = at::randn({1000}, test_device());
+
+  my_ops::PointwiseFusion g;
+  my_ops::PointwiseValue z = g.cast(g.gelu(g.input(a)), at::kBFloat16);
+  at::Tensor result = g.run({z})[0];
+
+  EXPECT_EQ(result.scalar_type(), at::kBFloat16);
+  EXPECT_TRUE(torch::allclose(result.to(at::kFloat), at::gelu(a).to(at::kBFloat16).to(at::kFloat)));
+}
+
+TEST(pointwise_fusion_test, kernel_cached_by_structure) {
+  auto build = [](const at::Tensor& a, double alpha) {
+    auto g = std::make_unique<my_ops::PointwiseFusion>();
+    my_ops::PointwiseValue z = g->tanh(g->mul(g->input(a), g->scalar(alpha)));
+    return std::make_pair(std::move(g), z);
+  };
+  at::Tensor a = at::randn({2048}, test_device());
+  at::Tensor b = at::randn({4096}, test_device());
+  auto [g1, z1] = build(a, 0.5);
+  auto [g2, z2] = build(b, 2.0);
+
+  EXPECT_EQ(g1->kernel_source({z1}), g2->kernel_source({z2}));
+  uint64_t generated = triton_jit::RuntimeMetrics::instance().counter("fusion/kernels_generated");
+  EXPECT_TRUE(torch::allclose(g1->run({z1})[0], at::tanh(a * 0.5), 1e-5, 1e-5));
+  EXPECT_TRUE(torch::allclose(g2->run({z2})[0], at::tanh(b * 2.0), 1e-5, 1e-5));
+  EXPECT_EQ(triton_jit::RuntimeMetrics::instance().counter("fusion/kernels_generated"), generated);
+}
@@ -0,0 +1,162 @@
+import torch
+import triton
+from triton import language as tl
+
+
+@triton.jit
+def _load_tile(X, R, cols, mask, x_stride_c, r_stride_c, HAS_RESIDUAL: tl.constexpr):
+    """Load a tile as fp32; with a residual, R = X + R (in place) and the rounded sum is returned."""
+    x = tl.load(X + cols * x_stride_c, mask=mask, other=0.0).to(tl.float32)
+    if HAS_RESIDUAL:
+        x += tl.load(R + cols * r_stride_c, mask=mask, other=0.0).to(tl.float32)
+        r = x.to(R.dtype.element_ty)
+        tl.store(R + cols * r_stride_c, r, mask=mask)
+        # quantize what the residual holds, so both paths agree with a reload of R
+        x = r.to(tl.float32)
+    return x
+
+
+@triton.jit
+def _store_quantized(Y, cols, mask, x, inv_scale, fp8_max):
+    y = tl.clamp(x * inv_scale, -fp8_max, fp8_max)
+    tl.store(Y + cols, y.to(Y.dtype.element_ty), mask=mask)
+
+
+@triton.jit
+def fp8_quant_kernel(
+    X,
+    R,
+    Y,
+    S,
+    x_stride_r,
+    x_stride_c,
+    r_stride_r,
+    r_stride_c,
+    y_stride_r,
+    N,
+    fp8_max,
+    min_scale,
+    HAS_RESIDUAL: tl.constexpr,
+    PER_TOKEN: tl.constexpr,
+    BLOCK_SIZE: tl.constexpr,
+    ONE_TILE: tl.constexpr,
+):
+    """Y = fp8(X [+ R] / scale), one row per program.
+
+    PER_TOKEN computes scale = max(absmax(row) / fp8_max, min_scale) and stores
+    it to S[row]; otherwise S[0] holds the scale of the whole tensor.
+    """
+    row = tl.program_id(0).to(tl.int64)
+    X += row * x_stride_r
+    Y += row * y_stride_r
+    if HAS_RESIDUAL:
+        R += row * r_stride_r
+
+    if ONE_TILE:
+        # the whole row fits in one tile: a single read of X (and R)
+        cols = tl.arange(0, BLOCK_SIZE)
+        mask = cols < N
+        x = _load_tile(X, R, cols, mask, x_stride_c, r_stride_c, HAS_RESIDUAL)
+        if PER_TOKEN:
+            scale = tl.maximum(tl.max(tl.abs(x), axis=0) / fp8_max, min_scale)
+            tl.store(S + row, scale)
+        else:
+            scale = tl.load(S)
+        _store_quantized(Y, cols, mask, x, 1.0 / scale, fp8_max)
+    else:
+        if PER_TOKEN:
+            # rows longer than the block limit: absmax first, then quantize the
+            # row again from the updated residual (or the input)
+            acc = tl.zeros([BLOCK_SIZE], dtype=tl.float32)
+            for off in range(0, N, BLOCK_SIZE):
+                cols = off + tl.arange(0, BLOCK_SIZE)
+                mask = cols < N
+                x = _load_tile(X, R, cols, mask, x_stride_c, r_stride_c, HAS_RESIDUAL)
+                acc = tl.maximum(acc, tl.abs(x))
+            scale = tl.maximum(tl.max(acc, axis=0) / fp8_max, min_scale)
+            tl.store(S + row, scale)
+            inv_scale = 1.0 / scale
+            for off in range(0, N, BLOCK_SIZE):
+                cols = off + tl.arange(0, BLOCK_SIZE)
+                mask = cols < N
+                if HAS_RESIDUAL:
+                    x = tl.load(R + cols * r_stride_c, mask=mask, other=0.0).to(tl.float32)
+                else:
+                    x = tl.load(X + cols * x_stride_c, mask=mask, other=0.0).to(tl.float32)
+                _store_quantized(Y, cols, mask, x, inv_scale, fp8_max)
+        else:
+            inv_scale = 1.0 / tl.load(S)
+            for off in range(0, N, BLOCK_SIZE):
+                cols = off + tl.arange(0, BLOCK_SIZE)
+                mask = cols < N
+                x = _load_tile(X, R, cols, mask, x_stride_c, r_stride_c, HAS_RESIDUAL)
+                _store_quantized(Y, cols, mask, x, inv_scale, fp8_max)
+
+
+@triton.jit
+def fp8_absmax_kernel(
+    X,
+    R,
+    S,
+    x_stride_r,
+    x_stride_c,
+    r_stride_r,
+    r_stride_c,
+    N,
+    fp8_max,
+    HAS_RESIDUAL: tl.constexpr,
+    BLOCK_SIZE: tl.constexpr,
+):
+    """S[0] = max(S[0], absmax(X [+ R]) / fp8_max), one row per program; R = X + R (in place)."""
+    row = tl.program_id(0).to(tl.int64)
+    X += row * x_stride_r
+    if HAS_RESIDUAL:
+        R += row * r_stride_r
+    acc = tl.zeros([BLOCK_SIZE], dtype=tl.float32)
+    for off in range(0, N, BLOCK_SIZE):
+        cols = off + tl.arange(0, BLOCK_SIZE)
+        mask = cols < N
+        x = _load_tile(X, R, cols, mask, x_stride_c, r_stride_c, HAS_RESIDUAL)
+        acc = tl.maximum(acc, tl.abs(x))
+    tl.atomic_max(S, tl.max(acc, axis=0) / fp8_max)
+
+
+def per_token_quant_fp8(x, residual=None):
+    N = x.shape[-1]
+    x2d = x.reshape(-1, N)
+    r2d = residual.view(-1, N) if residual is not None else None
+    y = torch.empty(x2d.shape, device=x.device, dtype=torch.float8_e4m3fn)
+    scales = torch.empty((x2d.shape[0], 1), device=x.device, dtype=torch.float32)
+    fp8_max = torch.finfo(torch.float8_e4m3fn).max
+    with torch.cuda.device(x.device):
+        fp8_quant_kernel[(x2d.shape[0],)](
+            x2d,
+            r2d,
+            y,
+            scales,
+            x2d.stride(0),
+            x2d.stride(1),
+            r2d.stride(0) if r2d is not None else 0,
+            r2d.stride(1) if r2d is not None else 0,
+            y.stride(0),
+            N,
+            fp8_max,
+            1.0 / (fp8_max * 512.0),
+            HAS_RESIDUAL=r2d is not None,
+            PER_TOKEN=True,
+            BLOCK_SIZE=triton.next_power_of_2(N),
+            ONE_TILE=True,
+        )
+    return y.view(x.shape), scales.view(*x.shape[:-1], 1)
+
+
+if __name__ == "__main__":
+    x = torch.randn(64, 4096, device="cuda", dtype=torch.bfloat16)
+    residual = torch.randn_like(x)
+
+    expected_residual = x + residual
+    y, scales = per_token_quant_fp8(x, residual)
+    torch.testing.assert_close(residual, expected_residual)
+    expected_scales = residual.float().abs().amax(-1, keepdim=True) / 448.0
+    torch.testing.assert_close(scales, expected_scales)
+    torch.testing.assert_close(y.float() * scales, residual.float(), atol=0.5, rtol=0.07)
@@ -0,0 +1,200 @@
+#include "quant_op.h"
+#include "common/backend_ops.h"
+#include "common/kernel_config.h"
+#include "common/op_registration.h"
+#include "triton_jit/triton_jit_function.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "c10/util/Float8_e4m3fn.h"
+#include "c10/util/Float8_e5m2.h"
+
+namespace my_ops {
+using namespace triton_jit;
+
+namespace {
+
+// Rows of the input (and residual) viewed as [M, N], and the dense FP8 output
+struct QuantRows {
+  at::Tensor x;
+  std::optional<at::Tensor> r;
+  at::Tensor out;
+  at::Tensor y;
+  int64_t M;
+  int64_t N;
+  float fp8_max;
+  // lower bound of a dynamic scale, so all-zero rows do not divide by zero
+  float min_scale;
+};
+
+QuantRows prepare_rows(const char* op,
+                       const at::Tensor& input,
+                       const std::optional<at::Tensor>& residual,
+                       std::optional<at::ScalarType> dtype) {
+  TORCH_CHECK(input.dim() >= 1, op, ": input must have at least one dim");
+  TORCH_CHECK(at::isFloatingType(input.scalar_type()),
+              op,
+              ": expected a floating point input, got ",
+              input.scalar_type());
+  const at::ScalarType out_dtype = dtype.value_or(at::kFloat8_e4m3fn);
+  QuantRows rows;
+  if (out_dtype == at::kFloat8_e4m3fn) {
+    rows.fp8_max = static_cast<float>(std::numeric_limits<c10::Float8_e4m3fn>::max());
+  } else if (out_dtype == at::kFloat8_e5m2) {
+    rows.fp8_max = static_cast<float>(std::numeric_limits<c10::Float8_e5m2>::max());
+  } else {
+    TORCH_CHECK(false, op, ": dtype must be Float8_e4m3fn or Float8_e5m2, got ", out_dtype);
+  }
+  rows.min_scale = 1.0f / (rows.fp8_max * 512.0f);
+
+  // Both strides are passed to the kernel, so views like a column slice are
+  // read in place. The residual is updated in place and must be viewable as [M, N].
+  rows.N = input.size(-1);
+  rows.x = input.reshape({-1, rows.N});
+  rows.M = rows.x.size(0);
+  if (residual.has_value()) {
+    TORCH_CHECK(residual->sizes() == input.sizes(), op, ": input and residual shapes differ");
+    TORCH_CHECK(residual->scalar_type() == input.scalar_type(), op, ": input and residual dtypes differ");
+    rows.r = residual->view({-1, rows.N});
+  }
+  rows.out = triton_jit::ops::backend_empty(input.sizes(), out_dtype, input.device());
+  rows.y = rows.out.view({-1, rows.N});
+  return rows;
+}
+
+// block size from the row length, capped by the backend's block limit
+int64_t quant_block_size(int64_t N) {
+  constexpr auto cfg = triton_jit::ops::default_quant_config();
+  int64_t block_size = 1;
+  while (block_size < N) {
+    block_size *= 2;
+  }
+  return std::min(block_size, cfg.max_block_size);
+}
+
+// Launches fp8_quant_kernel; with per_token the kernel writes S, otherwise S[0] is the scale
+void launch_quant(const QuantRows& rows,
+                  const at::Tensor& x,
+                  const std::optional<at::Tensor>& r,
+                  const at::Tensor& s,
+                  bool per_token) {
+  constexpr auto cfg = triton_jit::ops::default_quant_config();
+  const int64_t block_size = quant_block_size(rows.N);
+  const TritonJITFunction& f = TritonJITFunction::get_instance(std::string("quant.py"), "fp8_quant_kernel");
+
+  c10::DeviceGuard guard(rows.out.device());
+  triton_jit::ops::RawStream stream = triton_jit::ops::get_device_stream(x);
+  f(stream,
+    static_cast<unsigned int>(rows.M),
+    1,
+    1,
+    cfg.num_warps,
+    cfg.num_stages,
+    x,
+    r,
+    rows.y,
+    s,
+    x.stride(0),
+    x.stride(1),
+    r.has_value() ? r->stride(0) : 0,
+    r.has_value() ? r->stride(1) : 0,
+    rows.y.stride(0),
+    rows.N,
+    rows.fp8_max,
+    rows.min_scale,
+    r.has_value(),
+    per_token,
+    block_size,
+    block_size >= rows.N);
+}
+
+}  // namespace
+
+std::tuple<at::Tensor, at::Tensor> per_token_quant_fp8(const at::Tensor& input,
+                                                       const std::optional<at::Tensor>& residual,
+                                                       std::optional<at::ScalarType> dtype) {
+  QuantRows rows = prepare_rows("per_token_quant_fp8", input, residual, dtype);
+  std::vector<int64_t> scale_shape = input.sizes().vec();
+  scale_shape.back() = 1;
+  at::Tensor scales = triton_jit::ops::backend_empty(scale_shape, at::kFloat, input.device());
+  if (rows.M == 0) {
+    return {rows.out, scales};
+  }
+  // an empty row has no absmax; it is quantized with the smallest scale
+  if (rows.N == 0) {
+    scales.fill_(rows.min_scale);
+    return {rows.out, scales};
+  }
+  launch_quant(rows, rows.x, rows.r, scales, true);
+  return {rows.out, scales};
+}
+
+std::tuple<at::Tensor, at::Tensor> per_tensor_quant_fp8(const at::Tensor& input,
+                                                        const std::optional<at::Tensor>& residual,
+                                                        const std::optional<at::Tensor>& scale,
+                                                        std::optional<at::ScalarType> dtype) {
+  QuantRows rows = prepare_rows("per_tensor_quant_fp8", input, residual, dtype);
+  if (scale.has_value()) {
+    TORCH_CHECK(scale->numel() == 1,
+                "per_tensor_quant_fp8: scale must have one element, got ",
+                scale->numel());
+    at::Tensor s = scale->to(input.device(), at::kFloat).reshape({1});
+    if (rows.out.numel() > 0) {
+      launch_quant(rows, rows.x, rows.r, s, false);
+    }
+    return {rows.out, s};
+  }
+
+  at::Tensor s = triton_jit::ops::backend_empty({1}, at::kFloat, input.device());
+  s.fill_(rows.min_scale);
+  if (rows.out.numel() == 0) {
+    return {rows.out, s};
+  }
+
+  constexpr auto cfg = triton_jit::ops::default_quant_config();
+  const TritonJITFunction& absmax =
+      TritonJITFunction::get_instance(std::string("quant.py"), "fp8_absmax_kernel");
+  {
+    c10::DeviceGuard guard(rows.out.device());
+    triton_jit::ops::RawStream stream = triton_jit::ops::get_device_stream(rows.x);
+    absmax(stream,
+           static_cast<unsigned int>(rows.M),
+           1,
+           1,
+           cfg.num_warps,
+           cfg.num_stages,
+           rows.x,
+           rows.r,
+           s,
+           rows.x.stride(0),
+           rows.x.stride(1),
+           rows.r.has_value() ? rows.r->stride(0) : 0,
+           rows.r.has_value() ? rows.r->stride(1) : 0,
+           rows.N,
+           rows.fp8_max,
+           rows.r.has_value(),
+           quant_block_size(rows.N));
+  }
+  // the first pass already added the residual, so the second one reads it as the input
+  if (rows.r.has_value()) {
+    launch_quant(rows, *rows.r, std::nullopt, s, false);
+  } else {
+    launch_quant(rows, rows.x, std::nullopt, s, false);
+  }
+  return {rows.out, s};
+}
+
+TORCH_LIBRARY(quant_ops, m) {
+  m.def(
+      "per_token_quant_fp8(Tensor input, Tensor(a!)? residual=None, *, ScalarType? dtype=None) -> "
+      "(Tensor, Tensor)");
+  m.def(
+      "per_tensor_quant_fp8(Tensor input, Tensor(a!)? residual=None, Tensor? scale=None, *, "
+      "ScalarType? dtype=None) -> (Tensor, Tensor)");
+}
+
+REGISTER_TRITON_OP(quant_ops, "per_token_quant_fp8", per_token_quant_fp8)
+REGISTER_TRITON_OP(quant_ops, "per_tensor_quant_fp8", per_tensor_quant_fp8)
+
+}  // namespace my_ops
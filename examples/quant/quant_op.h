@@ -0,0 +1,38 @@
+#pragma once
+
+#include <optional>
+#include <tuple>
+#include "torch/torch.h"
+
+namespace my_ops {
+
+/**
+ * @brief Dynamic per-token FP8 quantization of the last dim
+ *
+ * Every row gets scale = absmax(row) / fp8_max, and out = fp8(input / scale).
+ * With a residual, residual <- input + residual first and the updated residual
+ * is quantized. A row is read once, unless it is longer than the backend's
+ * block limit. dtype is Float8_e4m3fn (default) or Float8_e5m2.
+ *
+ * @return (out of input's shape, float32 scales of shape [*input.shape[:-1], 1])
+ */
+std::tuple<at::Tensor, at::Tensor> per_token_quant_fp8(const at::Tensor& input,
+                                                       const std::optional<at::Tensor>& residual,
+                                                       std::optional<at::ScalarType> dtype);
+
+/**
+ * @brief Per-tensor FP8 quantization with a static or dynamic scale
+ *
+ * A given scale (a float32 tensor of one element) is used as is and the input
+ * is read once. Without one, the absmax of the whole tensor is needed before any
+ * element can be quantized, so a first pass computes the scale (and updates the
+ * residual) and a second pass quantizes.
+ *
+ * @return (out of input's shape, float32 scale of shape [1])
+ */
+std::tuple<at::Tensor, at::Tensor> per_tensor_quant_fp8(const at::Tensor& input,
+                                                        const std::optional<at::Tensor>& residual,
+                                                        const std::optional<at::Tensor>& scale,
+                                                        std::optional<at::ScalarType> dtype);
+
+}  // namespace my_ops
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "quant_op.h"
+#include "torch/torch.h"
+#include "triton_jit/backend_config.h"
+
+static at::Device test_device() {
+#if defined(BACKEND_NPU)
+  return at::Device("npu:0");
+#elif defined(BACKEND_MUSA)
+  return at::Device("musa:0");
+#elif defined(BACKEND_INTERPRETER)
+  return at::kCPU;
+#else
+  return at::kCUDA;
+#endif
+}
+
+static constexpr double kE4M3Max = 448.0;
+
+// quantizes with the given scales and dequantizes again in fp32
+static at::Tensor reference_round_trip(const at::Tensor& x, const at::Tensor& scales) {
+  at::Tensor xf = x.to(at::kFloat);
+  at::Tensor q = at::clamp(xf / scales, -kE4M3Max, kE4M3Max).to(at::kFloat8_e4m3fn);
+  return q.to(at::kFloat) * scales;
+}
+
+TEST(quant_test, per_token) {
+  // rows are read with a column stride of 132, without a copy
+  at::TensorOptions opts = at::TensorOptions().dtype(at::kHalf).device(test_device());
+  at::Tensor x = at::randn({1000, 4, 33}, opts).permute({1, 2, 0});
+  auto [out, scales] = my_ops::per_token_quant_fp8(x, std::nullopt, std::nullopt);
+  EXPECT_EQ(out.scalar_type(), at::kFloat8_e4m3fn);
+  EXPECT_EQ(scales.sizes(), at::IntArrayRef({4, 33, 1}));
+
+  at::Tensor expected_scales = x.to(at::kFloat).abs().amax({-1}, true) / kE4M3Max;
+  EXPECT_TRUE(torch::allclose(scales, expected_scales, 1e-6, 1e-7));
+  EXPECT_TRUE(torch::allclose(out.to(at::kFloat) * scales, reference_round_trip(x, scales), 1e-3, 1e-3));
+}
+
+TEST(quant_test, per_token_strided_with_residual) {
+  at::TensorOptions opts = at::TensorOptions().dtype(at::kBFloat16).device(test_device());
+  // a column slice of a wider buffer, and a row longer than one tile
+  at::Tensor x = at::randn({16, 20000}, opts).slice(1, 0, 10000);
+  at::Tensor residual = at::randn({16, 10000}, opts);
+  at::Tensor expected_residual = x + residual;
+
+  auto [out, scales] = my_ops::per_token_quant_fp8(x, residual, std::nullopt);
+  EXPECT_TRUE(torch::equal(residual, expected_residual));
+  at::Tensor expected_scales = expected_residual.to(at::kFloat).abs().amax({-1}, true) / kE4M3Max;
+  EXPECT_TRUE(torch::allclose(scales, expected_scales, 1e-6, 1e-7));
+  EXPECT_TRUE(torch::allclose(
+      out.to(at::kFloat) * scales, reference_round_trip(expected_residual, scales), 1e-3, 1e-3));
+}
+
+TEST(quant_test, per_tensor_dynamic_and_static) {
+  at::Tensor x = at::randn({128, 512}, test_device());
+  at::Tensor residual = at::randn({128, 512}, test_device());
+  at::Tensor expected_residual = x + residual;
+
+  auto [out, scale] = my_ops::per_tensor_quant_fp8(x, residual, std::nullopt, std::nullopt);
+  EXPECT_TRUE(torch::allclose(residual, expected_residual));
+  at::Tensor expected_scale = expected_residual.abs().amax().reshape({1}) / kE4M3Max;
+  EXPECT_TRUE(torch::allclose(scale, expected_scale, 1e-6, 1e-7));
+  EXPECT_TRUE(torch::allclose(out.to(at::kFloat) * scale, reference_round_trip(residual, scale), 1e-3, 1e-3));
+
+  at::Tensor static_scale = at::full({1}, 0.01, at::TensorOptions().dtype(at::kFloat).device(test_device()));
+  auto [static_out, used_scale] = my_ops::per_tensor_quant_fp8(x, std::nullopt, static_scale, std::nullopt);
+  EXPECT_TRUE(torch::equal(used_scale, static_scale));
+  EXPECT_TRUE(torch::allclose(
+      static_out.to(at::kFloat) * 0.01, reference_round_trip(x, static_scale), 1e-3, 1e-3));
+}
+
+TEST(quant_test, per_token_e5m2) {
+  at::Tensor x = at::randn({8, 640}, test_device());
+  auto [out, scales] = my_ops::per_token_quant_fp8(x, std::nullopt, at::kFloat8_e5m2);
+  EXPECT_EQ(out.scalar_type(), at::kFloat8_e5m2);
+  constexpr double kE5M2Max = 57344.0;
+  EXPECT_TRUE(torch::allclose(scales, x.abs().amax({-1}, true) / kE5M2Max, 1e-6, 1e-7));
+  at::Tensor q = at::clamp(x / scales, -kE5M2Max, kE5M2Max).to(at::kFloat8_e5m2);
+  at::Tensor expected = q.to(at::kFloat) * scales;
+  EXPECT_TRUE(torch::allclose(out.to(at::kFloat) * scales, expected, 1e-3, 1e-3));
+}
+
+TEST(quant_test, rejects_non_fp8_dtype) {
+  at::Tensor x = at::randn({2, 8}, test_device());
+  EXPECT_THROW(my_ops::per_token_quant_fp8(x, std::nullopt, at::kHalf), c10::Error);
+}
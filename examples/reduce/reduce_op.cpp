@@ -0,0 +1,115 @@
+#include "reduce_op.h"
+#include "common/backend_ops.h"
+#include "common/op_registration.h"
+#include "reduction.h"
+
+#include "ATen/native/ReduceOpsUtils.h"
+
+namespace my_ops {
+
+static at::Tensor reduce(const at::Tensor& self,
+                         const at::DimVector& dims,
+                         bool keepdim,
+                         at::ScalarType out_dtype,
+                         ReduceOp op,
+                         int64_t ord = 2) {
+  at::DimVector shape = at::meta::get_reduction_shape(self, dims, keepdim, false);
+  at::Tensor out = triton_jit::ops::backend_empty(shape, out_dtype, self.device());
+  run_reduction(self, dims, op, out, nullptr, ord);
+  return out;
+}
+
+static at::DimVector arg_reduction_dims(const at::Tensor& self, ::std::optional<int64_t> dim) {
+  if (!dim.has_value()) {
+    return reduction_dims(self, std::nullopt);
+  }
+  return {at::maybe_wrap_dim(dim.value(), self.dim())};
+}
+
+at::Tensor mean_dim(const at::Tensor& self,
+                    at::OptionalIntArrayRef dim,
+                    bool keepdim,
+                    ::std::optional<at::ScalarType> dtype) {
+  at::ScalarType out_dtype = dtype.value_or(self.scalar_type());
+  TORCH_CHECK(at::isFloatingType(out_dtype),
+              "mean(): could not infer output dtype. Input dtype must be floating point, got ",
+              out_dtype);
+  return reduce(self, reduction_dims(self, dim), keepdim, out_dtype, ReduceOp::MEAN);
+}
+
+at::Tensor prod_dim(const at::Tensor& self,
+                    int64_t dim,
+                    bool keepdim,
+                    ::std::optional<at::ScalarType> dtype) {
+  at::ScalarType out_dtype = at::native::get_dtype_from_self(self, dtype, true);
+  return reduce(self, {at::maybe_wrap_dim(dim, self.dim())}, keepdim, out_dtype, ReduceOp::PROD);
+}
+
+at::Tensor amax(const at::Tensor& self, at::IntArrayRef dim, bool keepdim) {
+  return reduce(self, reduction_dims(self, dim), keepdim, self.scalar_type(), ReduceOp::MAX);
+}
+
+at::Tensor amin(const at::Tensor& self, at::IntArrayRef dim, bool keepdim) {
+  return reduce(self, reduction_dims(self, dim), keepdim, self.scalar_type(), ReduceOp::MIN);
+}
+
+at::Tensor argmax(const at::Tensor& self, ::std::optional<int64_t> dim, bool keepdim) {
+  return reduce(self, arg_reduction_dims(self, dim), keepdim, at::ScalarType::Long, ReduceOp::ARGMAX);
+}
+
+at::Tensor argmin(const at::Tensor& self, ::std::optional<int64_t> dim, bool keepdim) {
+  return reduce(self, arg_reduction_dims(self, dim), keepdim, at::ScalarType::Long, ReduceOp::ARGMIN);
+}
+
+at::Tensor vector_norm(const at::Tensor& self,
+                       double ord,
+                       at::OptionalIntArrayRef dim,
+                       bool keepdim,
+                       ::std::optional<at::ScalarType> dtype) {
+  TORCH_CHECK(ord == 1.0 || ord == 2.0, "vector_norm: only ord 1 and 2 are supported, got ", ord);
+  at::ScalarType out_dtype = dtype.value_or(self.scalar_type());
+  TORCH_CHECK(at::isFloatingType(out_dtype), "vector_norm: expected a floating point dtype, got ", out_dtype);
+  return reduce(
+      self, reduction_dims(self, dim), keepdim, out_dtype, ReduceOp::NORM, static_cast<int64_t>(ord));
+}
+
+std::tuple<at::Tensor, at::Tensor> var_mean(const at::Tensor& self,
+                                            at::OptionalIntArrayRef dim,
+                                            double correction,
+                                            bool keepdim) {
+  TORCH_CHECK(at::isFloatingType(self.scalar_type()),
+              "var_mean: expected a floating point input, got ",
+              self.scalar_type());
+  at::DimVector dims = reduction_dims(self, dim);
+  at::DimVector shape = at::meta::get_reduction_shape(self, dims, keepdim, false);
+  at::Tensor var = triton_jit::ops::backend_empty(shape, self.scalar_type(), self.device());
+  at::Tensor mean = triton_jit::ops::backend_empty(shape, self.scalar_type(), self.device());
+  run_reduction(self, dims, ReduceOp::VAR_MEAN, var, &mean, 2, correction);
+  return {var, mean};
+}
+
+TORCH_LIBRARY(reduce_ops, m) {
+  m.def("mean_dim(Tensor self, int[1]? dim, bool keepdim=False, *, ScalarType? dtype=None) -> Tensor");
+  m.def("prod_dim(Tensor self, int dim, bool keepdim=False, *, ScalarType? dtype=None) -> Tensor");
+  m.def("amax(Tensor self, int[1] dim=[], bool keepdim=False) -> Tensor");
+  m.def("amin(Tensor self, int[1] dim=[], bool keepdim=False) -> Tensor");
+  m.def("argmax(Tensor self, int? dim=None, bool keepdim=False) -> Tensor");
+  m.def("argmin(Tensor self, int? dim=None, bool keepdim=False) -> Tensor");
+  m.def(
+      "vector_norm(Tensor self, float ord=2, int[1]? dim=None, bool keepdim=False, *, "
+      "ScalarType? dtype=None) -> Tensor");
+  m.def(
+      "var_mean(Tensor self, int[1]? dim=None, *, float correction=1, bool keepdim=False) -> "
+      "(Tensor, Tensor)");
+}
+
+REGISTER_TRITON_OP(reduce_ops, "mean_dim", mean_dim)
+REGISTER_TRITON_OP(reduce_ops, "prod_dim", prod_dim)
+REGISTER_TRITON_OP(reduce_ops, "amax", amax)
+REGISTER_TRITON_OP(reduce_ops, "amin", amin)
+REGISTER_TRITON_OP(reduce_ops, "argmax", argmax)
+REGISTER_TRITON_OP(reduce_ops, "argmin", argmin)
+REGISTER_TRITON_OP(reduce_ops, "vector_norm", vector_norm)
+REGISTER_TRITON_OP(reduce_ops, "var_mean", var_mean)
+
+}  // namespace my_ops
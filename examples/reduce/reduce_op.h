@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include "torch/torch.h"
+
+namespace my_ops {
+
+// Reductions built on run_reduction (reduction.h), with the semantics of the aten ops of the same name
+at::Tensor mean_dim(const at::Tensor& self,
+                    at::OptionalIntArrayRef dim,
+                    bool keepdim,
+                    ::std::optional<at::ScalarType> dtype);
+at::Tensor prod_dim(const at::Tensor& self, int64_t dim, bool keepdim, ::std::optional<at::ScalarType> dtype);
+at::Tensor amax(const at::Tensor& self, at::IntArrayRef dim, bool keepdim);
+at::Tensor amin(const at::Tensor& self, at::IntArrayRef dim, bool keepdim);
+at::Tensor argmax(const at::Tensor& self, ::std::optional<int64_t> dim, bool keepdim);
+at::Tensor argmin(const at::Tensor& self, ::std::optional<int64_t> dim, bool keepdim);
+// ord 1 or 2
+at::Tensor vector_norm(const at::Tensor& self,
+                       double ord,
+                       at::OptionalIntArrayRef dim,
+                       bool keepdim,
+                       ::std::optional<at::ScalarType> dtype);
+// (variance, mean), Welford
+std::tuple<at::Tensor, at::Tensor> var_mean(const at::Tensor& self,
+                                            at::OptionalIntArrayRef dim,
+                                            double correction,
+                                            bool keepdim);
+
+}  // namespace my_ops
@@ -0,0 +1,260 @@
+#include "reduction.h"
+#include "common/backend_ops.h"
+#include "common/kernel_config.h"
+#include "triton_jit/triton_jit_function.h"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <utility>
+#include "ATen/WrapDimUtils.h"
+#include "ATen/native/ReduceOpsUtils.h"
+
+namespace my_ops {
+using namespace triton_jit;
+
+namespace {
+
+// a split reduces at least this many column tiles, so the merge stays cheap
+constexpr int64_t kMinTilesPerSplit = 4;
+
+int64_t next_power_of_2(int64_t n) {
+  int64_t p = 1;
+  while (p < n) {
+    p *= 2;
+  }
+  return p;
+}
+
+int64_t cdiv(int64_t a, int64_t b) {
+  return (a + b - 1) / b;
+}
+
+// (size, stride) of `axes` walked as one dim, if their strides nest in order
+std::optional<std::pair<int64_t, int64_t>> collapse(const at::Tensor& t, const at::DimVector& axes) {
+  int64_t size = 1;
+  int64_t stride = 1;
+  for (auto it = axes.rbegin(); it != axes.rend(); ++it) {
+    if (t.size(*it) == 1) {
+      continue;
+    }
+    if (size == 1) {
+      stride = t.stride(*it);
+    } else if (t.stride(*it) != stride * size) {
+      return std::nullopt;
+    }
+    size *= t.size(*it);
+  }
+  return std::make_pair(size, stride);
+}
+
+}  // namespace
+
+at::DimVector reduction_dims(const at::Tensor& self, at::OptionalIntArrayRef dim) {
+  at::DimVector dims = at::native::make_dim_vector(dim, self.dim());
+  at::maybe_wrap_dims(dims, self.dim());
+  return dims;
+}
+
+at::ScalarType reduction_acc_dtype(at::ScalarType dtype) {
+  if (!at::isFloatingType(dtype)) {
+    return at::ScalarType::Long;
+  }
+  return dtype == at::ScalarType::Double ? dtype : at::ScalarType::Float;
+}
+
+ReductionPlan plan_reduction(const at::Tensor& self, const at::DimVector& dims) {
+  at::DimVector kept, reduced;
+  for (int64_t i = 0; i < self.dim(); i++) {
+    if (std::find(dims.begin(), dims.end(), i) != dims.end()) {
+      reduced.push_back(i);
+    } else {
+      kept.push_back(i);
+    }
+  }
+
+  ReductionPlan plan;
+  auto m = collapse(self, kept);
+  auto n = collapse(self, reduced);
+  if (m && n && self.numel() > 0) {
+    plan.input = self;
+    std::tie(plan.M, plan.stride_m) = *m;
+    std::tie(plan.N, plan.stride_n) = *n;
+  } else {
+    at::DimVector order = kept;
+    order.insert(order.end(), reduced.begin(), reduced.end());
+    plan.input = self.permute(order).contiguous();
+    plan.M = 1;
+    for (int64_t d : kept) {
+      plan.M *= self.size(d);
+    }
+    plan.N = plan.M == 0 ? 0 : self.numel() / plan.M;
+    plan.stride_m = plan.N;
+    plan.stride_n = 1;
+  }
+  if (plan.N == 1) {
+    plan.stride_n = 1;
+  }
+
+  // keep the tile size of the config, with its long side on the contiguous dim
+  constexpr auto cfg = triton_jit::ops::default_reduce_config();
+  const int64_t tile = cfg.BLOCK_M * cfg.BLOCK_N;
+  if (plan.stride_n == 1) {
+    plan.block_n = std::min(cfg.BLOCK_N, next_power_of_2(plan.N));
+    plan.block_m = std::max<int64_t>(1, std::min(next_power_of_2(plan.M), tile / plan.block_n));
+  } else {
+    plan.block_m = std::min(cfg.BLOCK_N, next_power_of_2(plan.M));
+    plan.block_n = std::max<int64_t>(1, std::min(next_power_of_2(plan.N), tile / plan.block_m));
+  }
+  plan.num_warps = cfg.num_warps;
+  plan.num_stages = cfg.num_stages;
+
+  // split long rows when there are too few row tiles to occupy every compute unit
+  const int64_t row_tiles = cdiv(plan.M, plan.block_m);
+  const int64_t col_tiles = cdiv(plan.N, plan.block_n);
+  int64_t splits = 1;
+  if (plan.M > 0 && plan.N > 0) {
+    const int64_t units = triton_jit::ops::num_compute_units(self.device());
+    if (row_tiles < units && col_tiles >= 2 * kMinTilesPerSplit) {
+      splits = std::min(cdiv(col_tiles, kMinTilesPerSplit), cdiv(units, row_tiles));
+    }
+  }
+  plan.chunk = std::max<int64_t>(1, cdiv(col_tiles, splits)) * plan.block_n;
+  plan.num_splits = std::max<int64_t>(1, cdiv(plan.N, plan.chunk));
+  return plan;
+}
+
+void run_reduction(const at::Tensor& self,
+                   const at::DimVector& dims,
+                   ReduceOp op,
+                   at::Tensor& out,
+                   at::Tensor* mean_out,
+                   int64_t ord,
+                   double correction) {
+  TORCH_CHECK(op != ReduceOp::VAR_MEAN || mean_out != nullptr, "var_mean needs an output for the mean");
+  TORCH_CHECK(ord == 1 || ord == 2, "norm: only ord 1 and 2 are supported, got ", ord);
+  const ReductionPlan plan = plan_reduction(self, dims);
+  at::Tensor& out1 = mean_out != nullptr ? *mean_out : out;
+  if (plan.M == 0) {
+    return;
+  }
+  if (plan.N == 0) {
+    switch (op) {
+      case ReduceOp::SUM:
+      case ReduceOp::NORM:
+        out.zero_();
+        return;
+      case ReduceOp::PROD:
+        out.fill_(1);
+        return;
+      case ReduceOp::MEAN:
+        out.fill_(std::numeric_limits<double>::quiet_NaN());
+        return;
+      case ReduceOp::VAR_MEAN:
+        out.fill_(std::numeric_limits<double>::quiet_NaN());
+        out1.fill_(std::numeric_limits<double>::quiet_NaN());
+        return;
+      default:
+        TORCH_CHECK(false, "cannot perform reduction over a zero-size dimension, which has no identity");
+    }
+  }
+
+  const int64_t op_code = static_cast<int64_t>(op);
+  const float correction_f = static_cast<float>(correction);
+  const unsigned int num_blocks =
+      triton_jit::ops::plan_num_blocks(cdiv(plan.M, plan.block_m) * plan.num_splits, "aiv");
+
+  c10::DeviceGuard guard(out.device());
+  triton_jit::ops::RawStream stream = triton_jit::ops::get_device_stream(plan.input);
+  const TritonJITFunction& f = TritonJITFunction::get_instance(std::string("reduction.py"), "reduce_kernel");
+
+  if (plan.num_splits == 1) {
+    f(stream,
+      num_blocks,
+      1,
+      1,
+      plan.num_warps,
+      plan.num_stages,
+      plan.input,
+      out,
+      out1,
+      out,
+      plan.M,
+      plan.N,
+      plan.stride_m,
+      plan.stride_n,
+      plan.num_splits,
+      plan.chunk,
+      correction_f,
+      op_code,
+      ord,
+      true,
+      plan.block_m,
+      plan.block_n);
+    return;
+  }
+
+  // partial states [M, num_splits], merged by reduce_combine_kernel
+  const at::ScalarType acc_dtype = reduction_acc_dtype(plan.input.scalar_type());
+  const int64_t num_mid = plan.M * plan.num_splits;
+  const at::Device device = plan.input.device();
+  at::Tensor mid0 = triton_jit::ops::backend_empty({num_mid}, acc_dtype, device);
+  at::Tensor mid1 = mid0;
+  at::Tensor mid2 = mid0;
+  if (op == ReduceOp::ARGMAX || op == ReduceOp::ARGMIN) {
+    mid1 = triton_jit::ops::backend_empty({num_mid}, at::ScalarType::Long, device);
+  } else if (op == ReduceOp::VAR_MEAN) {
+    mid1 = triton_jit::ops::backend_empty({num_mid}, acc_dtype, device);
+    mid2 = triton_jit::ops::backend_empty({num_mid}, acc_dtype, device);
+  }
+  f(stream,
+    num_blocks,
+    1,
+    1,
+    plan.num_warps,
+    plan.num_stages,
+    plan.input,
+    mid0,
+    mid1,
+    mid2,
+    plan.M,
+    plan.N,
+    plan.stride_m,
+    plan.stride_n,
+    plan.num_splits,
+    plan.chunk,
+    correction_f,
+    op_code,
+    ord,
+    false,
+    plan.block_m,
+    plan.block_n);
+
+  constexpr auto cfg = triton_jit::ops::default_reduce_config();
+  const int64_t block_s = std::min(cfg.BLOCK_N, next_power_of_2(plan.num_splits));
+  const int64_t block_m =
+      std::max<int64_t>(1, std::min(next_power_of_2(plan.M), cfg.BLOCK_M * cfg.BLOCK_N / block_s));
+  const TritonJITFunction& combine =
+      TritonJITFunction::get_instance(std::string("reduction.py"), "reduce_combine_kernel");
+  combine(stream,
+          triton_jit::ops::plan_num_blocks(cdiv(plan.M, block_m), "aiv"),
+          1,
+          1,
+          plan.num_warps,
+          plan.num_stages,
+          mid0,
+          mid1,
+          mid2,
+          out,
+          out1,
+          plan.M,
+          plan.num_splits,
+          plan.N,
+          correction_f,
+          op_code,
+          ord,
+          block_m,
+          block_s);
+}
+
+}  // namespace my_ops
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include "c10/util/DimVector.h"
+#include "torch/torch.h"
+
+namespace my_ops {
+
+/// Reductions of reduction.py; the values are its OP constexprs
+enum class ReduceOp : int64_t {
+  SUM = 0,
+  MEAN = 1,
+  PROD = 2,
+  MAX = 3,
+  MIN = 4,
+  ARGMAX = 5,
+  ARGMIN = 6,
+  NORM = 7,
+  VAR_MEAN = 8,
+};
+
+/**
+ * @brief How a reduction over some dims of a tensor is launched
+ *
+ * The input is viewed as [M, N] with the reduced dims on the right. When the kept
+ * dims and the reduced dims each collapse into a single stride the view is taken
+ * in place, otherwise the input is permuted into a contiguous copy. The tile is
+ * shaped along the contiguous side of the view, and rows too few to fill the
+ * device are split into chunks reduced by separate programs and merged by a
+ * second kernel.
+ */
+struct ReductionPlan {
+  at::Tensor input;
+  int64_t M = 0;
+  int64_t N = 0;
+  int64_t stride_m = 0;
+  int64_t stride_n = 0;
+  int64_t block_m = 1;
+  int64_t block_n = 1;
+  int64_t num_splits = 1;
+  /// Columns reduced per split, a multiple of block_n
+  int64_t chunk = 0;
+  int num_warps = 4;
+  int num_stages = 1;
+};
+
+/// Wrapped dims to reduce; all dims when `dim` is nullopt or empty
+at::DimVector reduction_dims(const at::Tensor& self, at::OptionalIntArrayRef dim);
+
+ReductionPlan plan_reduction(const at::Tensor& self, const at::DimVector& dims);
+
+/// dtype of the partial states: fp32 for half precision, int64 for integers and bool
+at::ScalarType reduction_acc_dtype(at::ScalarType dtype);
+
+/**
+ * @brief Reduce `self` over `dims` into `out`
+ *
+ * `out` has the reduced shape (with or without keepdim) and is written as a dense
+ * vector of M elements. VAR_MEAN writes the variance to `out` and the mean to
+ * `mean_out`. `ord` (1 or 2) is used by NORM, `correction` by VAR_MEAN.
+ */
+void run_reduction(const at::Tensor& self,
+                   const at::DimVector& dims,
+                   ReduceOp op,
+                   at::Tensor& out,
+                   at::Tensor* mean_out = nullptr,
+                   int64_t ord = 2,
+                   double correction = 0.0);
+
+}  // namespace my_ops
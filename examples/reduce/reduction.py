@@ -0,0 +1,357 @@
+# ==============================================================================
+# reduction.py - Generic row reduction templates
+#
+# The input is viewed as a strided [M, N] matrix and every row is reduced. The
+# reduction is selected by the OP constexpr; each one is a combine function over
+# a state of up to three values:
+#   SUM, MEAN, PROD, MAX, MIN, NORM   (value)
+#   ARGMAX, ARGMIN                    (value, index)
+#   VAR_MEAN                          (mean, m2, count), Welford
+# Long rows can be split across programs: reduce_kernel then writes partial
+# states and reduce_combine_kernel merges them. Keep the OP values in sync with
+# ReduceOp in reduction.h.
+# ==============================================================================
+
+import triton
+from triton import language as tl
+
+SUM = tl.constexpr(0)
+MEAN = tl.constexpr(1)
+PROD = tl.constexpr(2)
+MAX = tl.constexpr(3)
+MIN = tl.constexpr(4)
+ARGMAX = tl.constexpr(5)
+ARGMIN = tl.constexpr(6)
+NORM = tl.constexpr(7)
+VAR_MEAN = tl.constexpr(8)
+
+
+@triton.jit
+def _to_acc(x):
+    """Accumulation type: fp32 for half precision, int64 for integers."""
+    if x.dtype.is_floating():
+        if x.dtype.primitive_bitwidth < 32:
+            x = x.to(tl.float32)
+    else:
+        x = x.to(tl.int64)
+    return x
+
+
+@triton.jit
+def _identity(x, OP: tl.constexpr):
+    """A tensor like x filled with the identity of the combine function."""
+    if OP == PROD:
+        v = tl.full(x.shape, 1, x.dtype)
+    elif (OP == MAX) or (OP == ARGMAX):
+        if x.dtype.is_floating():
+            v = tl.full(x.shape, float("-inf"), x.dtype)
+        else:
+            v = tl.full(x.shape, -9223372036854775808, x.dtype)
+    elif (OP == MIN) or (OP == ARGMIN):
+        if x.dtype.is_floating():
+            v = tl.full(x.shape, float("inf"), x.dtype)
+        else:
+            v = tl.full(x.shape, 9223372036854775807, x.dtype)
+    else:
+        v = tl.zeros(x.shape, x.dtype)
+    return v
+
+
+@triton.jit
+def _add(a, b):
+    return a + b
+
+
+@triton.jit
+def _mul(a, b):
+    return a * b
+
+
+@triton.jit
+def _max(a, b):
+    return tl.maximum(a, b)
+
+
+@triton.jit
+def _min(a, b):
+    return tl.minimum(a, b)
+
+
+@triton.jit
+def _argmax_combine(v1, i1, v2, i2):
+    take = (v1 > v2) | ((v1 == v2) & (i1 < i2))
+    return tl.where(take, v1, v2), tl.where(take, i1, i2)
+
+
+@triton.jit
+def _argmin_combine(v1, i1, v2, i2):
+    take = (v1 < v2) | ((v1 == v2) & (i1 < i2))
+    return tl.where(take, v1, v2), tl.where(take, i1, i2)
+
+
+@triton.jit
+def _welford_combine(mean1, m2_1, n1, mean2, m2_2, n2):
+    n = n1 + n2
+    delta = mean2 - mean1
+    w = n2 / tl.maximum(n, 1.0)
+    return mean1 + delta * w, m2_1 + m2_2 + delta * delta * n1 * w, n
+
+
+@triton.jit
+def _combine_state(acc, aux, cnt, v, i, n, OP: tl.constexpr):
+    """Merge the state (v, i, n) into (acc, aux, cnt), elementwise."""
+    if OP == VAR_MEAN:
+        acc, aux, cnt = _welford_combine(acc, aux, cnt, v, i, n)
+    elif OP == ARGMAX:
+        acc, aux = _argmax_combine(acc, aux, v, i)
+    elif OP == ARGMIN:
+        acc, aux = _argmin_combine(acc, aux, v, i)
+    elif OP == PROD:
+        acc = acc * v
+    elif OP == MAX:
+        acc = tl.maximum(acc, v)
+    elif OP == MIN:
+        acc = tl.minimum(acc, v)
+    else:
+        acc = acc + v
+    return acc, aux, cnt
+
+
+@triton.jit
+def _reduce_rows(acc, aux, cnt, OP: tl.constexpr):
+    """Reduce [BLOCK_M, BLOCK_N] states along the row; state an OP does not use is left as is."""
+    if OP == VAR_MEAN:
+        acc, aux, cnt = tl.reduce((acc, aux, cnt), axis=1, combine_fn=_welford_combine)
+    elif OP == ARGMAX:
+        acc, aux = tl.reduce((acc, aux), axis=1, combine_fn=_argmax_combine)
+    elif OP == ARGMIN:
+        acc, aux = tl.reduce((acc, aux), axis=1, combine_fn=_argmin_combine)
+    else:
+        if OP == PROD:
+            acc = tl.reduce(acc, axis=1, combine_fn=_mul)
+        elif OP == MAX:
+            acc = tl.reduce(acc, axis=1, combine_fn=_max)
+        elif OP == MIN:
+            acc = tl.reduce(acc, axis=1, combine_fn=_min)
+        else:
+            acc = tl.reduce(acc, axis=1, combine_fn=_add)
+    return acc, aux, cnt
+
+
+@triton.jit
+def _store_result(out0, out1, rows, mask, acc, aux, cnt, N, correction, OP: tl.constexpr, ORD: tl.constexpr):
+    if OP == VAR_MEAN:
+        var = aux / tl.maximum(cnt - correction, 0.0)
+        tl.store(out0 + rows, var.to(out0.dtype.element_ty), mask=mask)
+        tl.store(out1 + rows, acc.to(out1.dtype.element_ty), mask=mask)
+    elif (OP == ARGMAX) or (OP == ARGMIN):
+        tl.store(out0 + rows, aux.to(out0.dtype.element_ty), mask=mask)
+    else:
+        if OP == MEAN:
+            acc = acc / N
+        elif OP == NORM:
+            if ORD == 2:
+                acc = tl.sqrt(acc)
+        tl.store(out0 + rows, acc.to(out0.dtype.element_ty), mask=mask)
+
+
+@triton.jit
+def reduce_kernel(
+    inp,
+    out0,
+    out1,
+    out2,
+    M,
+    N,
+    stride_m,
+    stride_n,
+    num_splits,
+    chunk,
+    correction,
+    OP: tl.constexpr,
+    ORD: tl.constexpr,
+    FINAL: tl.constexpr,
+    BLOCK_M: tl.constexpr,
+    BLOCK_N: tl.constexpr,
+):
+    """Reduce `chunk` columns of BLOCK_M rows per work item.
+
+    With FINAL the results go to out0 (and out1 for VAR_MEAN). Otherwise the
+    partial states go to out0/out1/out2 at [row, split], for reduce_combine_kernel.
+    """
+    pid = tl.program_id(0)
+    num_work = tl.cdiv(M, BLOCK_M) * num_splits
+    for work in range(pid, num_work, tl.num_programs(0)):
+        row_tile = work // num_splits
+        split = work % num_splits
+        rows = row_tile.to(tl.int64) * BLOCK_M + tl.arange(0, BLOCK_M)
+        row_mask = rows < M
+        start = split.to(tl.int64) * chunk
+
+        zero = _to_acc(tl.zeros([BLOCK_M, BLOCK_N], dtype=inp.dtype.element_ty))
+        acc = _identity(zero, OP)
+        if (OP == ARGMAX) or (OP == ARGMIN):
+            aux = tl.zeros([BLOCK_M, BLOCK_N], dtype=tl.int64)
+        else:
+            aux = zero
+        cnt = zero
+
+        for off in range(0, chunk, BLOCK_N):
+            cols = start + off + tl.arange(0, BLOCK_N)[None, :]
+            mask = row_mask[:, None] & (cols < N)
+            x = _to_acc(tl.load(inp + rows[:, None] * stride_m + cols * stride_n, mask=mask, other=0))
+            if OP == VAR_MEAN:
+                acc, aux, cnt = _combine_state(acc, aux, cnt, x, zero, mask.to(zero.dtype), OP)
+            else:
+                if OP == NORM:
+                    if ORD == 1:
+                        x = tl.abs(x)
+                    else:
+                        x = x * x
+                x = tl.where(mask, x, _identity(x, OP))
+                acc, aux, cnt = _combine_state(acc, aux, cnt, x, cols, zero, OP)
+
+        acc, aux, cnt = _reduce_rows(acc, aux, cnt, OP)
+        if FINAL:
+            _store_result(out0, out1, rows, row_mask, acc, aux, cnt, N, correction, OP, ORD)
+        else:
+            mid = rows * num_splits + split
+            tl.store(out0 + mid, acc, mask=row_mask)
+            if (OP == ARGMAX) or (OP == ARGMIN) or (OP == VAR_MEAN):
+                tl.store(out1 + mid, aux, mask=row_mask)
+            if OP == VAR_MEAN:
+                tl.store(out2 + mid, cnt, mask=row_mask)
+
+
+@triton.jit
+def reduce_combine_kernel(
+    mid0,
+    mid1,
+    mid2,
+    out0,
+    out1,
+    M,
+    num_splits,
+    N,
+    correction,
+    OP: tl.constexpr,
+    ORD: tl.constexpr,
+    BLOCK_M: tl.constexpr,
+    BLOCK_S: tl.constexpr,
+):
+    """Merge the [M, num_splits] partial states written by reduce_kernel."""
+    pid = tl.program_id(0)
+    for row_tile in range(pid, tl.cdiv(M, BLOCK_M), tl.num_programs(0)):
+        rows = row_tile.to(tl.int64) * BLOCK_M + tl.arange(0, BLOCK_M)
+        row_mask = rows < M
+
+        zero = tl.zeros([BLOCK_M, BLOCK_S], dtype=mid0.dtype.element_ty)
+        acc = _identity(zero, OP)
+        if (OP == ARGMAX) or (OP == ARGMIN):
+            aux = tl.zeros([BLOCK_M, BLOCK_S], dtype=tl.int64)
+        else:
+            aux = zero
+        cnt = zero
+
+        for off in range(0, num_splits, BLOCK_S):
+            splits = off + tl.arange(0, BLOCK_S)[None, :]
+            mask = row_mask[:, None] & (splits < num_splits)
+            mid = rows[:, None] * num_splits + splits
+            v = tl.load(mid0 + mid, mask=mask, other=0)
+            if OP == VAR_MEAN:
+                m2 = tl.load(mid1 + mid, mask=mask, other=0)
+                n = tl.load(mid2 + mid, mask=mask, other=0)
+                acc, aux, cnt = _combine_state(acc, aux, cnt, v, m2, n, OP)
+            elif (OP == ARGMAX) or (OP == ARGMIN):
+                i = tl.load(mid1 + mid, mask=mask, other=0)
+                v = tl.where(mask, v, _identity(v, OP))
+                acc, aux, cnt = _combine_state(acc, aux, cnt, v, i, zero, OP)
+            else:
+                v = tl.where(mask, v, _identity(v, OP))
+                acc, aux, cnt = _combine_state(acc, aux, cnt, v, zero, zero, OP)
+
+        acc, aux, cnt = _reduce_rows(acc, aux, cnt, OP)
+        _store_result(out0, out1, rows, row_mask, acc, aux, cnt, N, correction, OP, ORD)
+
+
+# ------ segmented reductions ------
+# Rows [offsets[s], offsets[s + 1]) of a [T, D] input reduce to row s of the
+# output. The host plan cuts the rows into pieces of bounded length and packs
+# consecutive short pieces into one work item; segments longer than a piece are
+# split, their pieces write partial rows to `mid` and segment_combine_kernel
+# reduces those.
+
+
+@triton.jit
+def _reduce_segment_rows(
+    inp, begin, end, stride_t, cols, col_mask, OP: tl.constexpr, BLOCK_T: tl.constexpr, BLOCK_D: tl.constexpr
+):
+    """Reduce rows [begin, end) at columns `cols` to a vector; the tile is [BLOCK_D, BLOCK_T]."""
+    zero = _to_acc(tl.zeros([BLOCK_D, BLOCK_T], dtype=inp.dtype.element_ty))
+    acc = _identity(zero, OP)
+    for t in range(begin, end, BLOCK_T):
+        rows = t + tl.arange(0, BLOCK_T)
+        mask = col_mask[:, None] & (rows < end)[None, :]
+        x = _to_acc(tl.load(inp + rows[None, :] * stride_t + cols[:, None], mask=mask, other=0))
+        x = tl.where(mask, x, _identity(x, OP))
+        acc, aux, cnt = _combine_state(acc, zero, zero, x, zero, zero, OP)
+    acc, aux, cnt = _reduce_rows(acc, zero, zero, OP)
+    return acc
+
+
+@triton.jit
+def segment_reduce_kernel(
+    inp,
+    out,
+    mid,
+    pieces,
+    item_ptr,
+    num_items,
+    D,
+    stride_t,
+    OP: tl.constexpr,
+    BLOCK_T: tl.constexpr,
+    BLOCK_D: tl.constexpr,
+):
+    """pieces[p] = (segment, begin, end, slot): slot -1 writes out[segment], else mid[slot]."""
+    pid = tl.program_id(0)
+    cols = tl.program_id(1) * BLOCK_D + tl.arange(0, BLOCK_D)
+    col_mask = cols < D
+    for item in range(pid, num_items, tl.num_programs(0)):
+        for p in range(tl.load(item_ptr + item), tl.load(item_ptr + item + 1)):
+            seg = tl.load(pieces + p * 4)
+            begin = tl.load(pieces + p * 4 + 1)
+            end = tl.load(pieces + p * 4 + 2)
+            slot = tl.load(pieces + p * 4 + 3)
+            acc = _reduce_segment_rows(inp, begin, end, stride_t, cols, col_mask, OP, BLOCK_T, BLOCK_D)
+            if slot < 0:
+                if OP == MEAN:
+                    acc = acc / (end - begin)
+                tl.store(out + seg * D + cols, acc.to(out.dtype.element_ty), mask=col_mask)
+            else:
+                tl.store(mid + slot * D + cols, acc, mask=col_mask)
+
+
+@triton.jit
+def segment_combine_kernel(
+    mid,
+    out,
+    splits,
+    num_splits,
+    D,
+    OP: tl.constexpr,
+    BLOCK_T: tl.constexpr,
+    BLOCK_D: tl.constexpr,
+):
+    """splits[k] = (segment, first slot, end slot, rows of the segment)."""
+    pid = tl.program_id(0)
+    cols = tl.program_id(1) * BLOCK_D + tl.arange(0, BLOCK_D)
+    col_mask = cols < D
+    for k in range(pid, num_splits, tl.num_programs(0)):
+        seg = tl.load(splits + k * 4)
+        begin = tl.load(splits + k * 4 + 1)
+        end = tl.load(splits + k * 4 + 2)
+        acc = _reduce_segment_rows(mid, begin, end, D, cols, col_mask, OP, BLOCK_T, BLOCK_D)
+        if OP == MEAN:
+            acc = acc / tl.load(splits + k * 4 + 3)
+        tl.store(out + seg * D + cols, acc.to(out.dtype.element_ty), mask=col_mask)
@@ -0,0 +1,235 @@
+#include "segment_reduce_op.h"
+#include "common/backend_ops.h"
+#include "common/kernel_config.h"
+#include "common/op_registration.h"
+#include "fmt/core.h"
+#include "reduction.h"
+#include "triton_jit/jit_utils.h"
+#include "triton_jit/triton_jit_function.h"
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "ATen/native/ReduceOpsUtils.h"
+
+namespace my_ops {
+using namespace triton_jit;
+
+namespace {
+
+// a work item holds at least this many row tiles before it is closed
+constexpr int64_t kMinTilesPerItem = 4;
+// bound on cached plans; the cache is dropped when it grows past it
+constexpr size_t kMaxCachedPlans = 4096;
+
+int64_t next_power_of_2(int64_t n) {
+  int64_t p = 1;
+  while (p < n) {
+    p *= 2;
+  }
+  return p;
+}
+
+int64_t cdiv(int64_t a, int64_t b) {
+  return (a + b - 1) / b;
+}
+
+at::Tensor to_device(std::vector<int64_t>& values, int64_t cols, const at::Device& device) {
+  int64_t rows = static_cast<int64_t>(values.size()) / cols;
+  at::Tensor host = at::from_blob(values.data(), {rows, cols}, at::TensorOptions().dtype(at::kLong));
+  // always copy: on a CPU device .to() would alias the vector, which the cached plan outlives
+  return host.to(device, /*non_blocking=*/false, /*copy=*/true);
+}
+
+SegmentPlan build_plan(const std::vector<int64_t>& off,
+                       int64_t num_rows,
+                       int64_t row_size,
+                       const at::Device& device) {
+  constexpr auto cfg = triton_jit::ops::default_reduce_config();
+  SegmentPlan plan;
+  plan.block_d = std::min(cfg.BLOCK_N, next_power_of_2(std::max<int64_t>(row_size, 1)));
+  plan.block_t = std::max<int64_t>(1, cfg.BLOCK_M * cfg.BLOCK_N / plan.block_d);
+  const int64_t units = triton_jit::ops::num_compute_units(device);
+  plan.piece_rows = std::max(plan.block_t * kMinTilesPerItem, cdiv(num_rows, units * kMinTilesPerItem));
+
+  std::vector<int64_t> pieces, item_ptr = {0}, splits;
+  int64_t item_rows = 0;
+  auto close_item = [&]() {
+    int64_t num_pieces = static_cast<int64_t>(pieces.size()) / 4;
+    if (num_pieces > item_ptr.back()) {
+      item_ptr.push_back(num_pieces);
+    }
+    item_rows = 0;
+  };
+  const int64_t num_segments = static_cast<int64_t>(off.size()) - 1;
+  for (int64_t s = 0; s < num_segments; s++) {
+    const int64_t begin = off[s];
+    const int64_t end = off[s + 1];
+    TORCH_CHECK(begin >= 0 && begin <= end && end <= num_rows,
+                "segment_reduce: offsets must be non-decreasing within [0, ",
+                num_rows,
+                "], got ",
+                begin,
+                ", ",
+                end,
+                " for segment ",
+                s);
+    plan.has_empty_segment |= begin == end;
+    if (end - begin > plan.piece_rows) {
+      close_item();
+      const int64_t first_slot = plan.num_slots;
+      for (int64_t r = begin; r < end; r += plan.piece_rows) {
+        pieces.insert(pieces.end(), {s, r, std::min(r + plan.piece_rows, end), plan.num_slots++});
+        close_item();
+      }
+      splits.insert(splits.end(), {s, first_slot, plan.num_slots, end - begin});
+      continue;
+    }
+    // a piece costs at least one row tile, so runs of tiny segments are bounded too
+    const int64_t cost = std::max(end - begin, plan.block_t);
+    if (item_rows > 0 && item_rows + cost > plan.piece_rows) {
+      close_item();
+    }
+    pieces.insert(pieces.end(), {s, begin, end, -1});
+    item_rows += cost;
+  }
+  close_item();
+
+  plan.num_items = static_cast<int64_t>(item_ptr.size()) - 1;
+  plan.num_splits = static_cast<int64_t>(splits.size()) / 4;
+  plan.pieces = to_device(pieces, 4, device);
+  plan.item_ptr = to_device(item_ptr, 1, device).view({-1});
+  plan.splits = to_device(splits, 4, device);
+  return plan;
+}
+
+}  // namespace
+
+SegmentPlan plan_segments(const at::Tensor& offsets,
+                          int64_t num_rows,
+                          int64_t row_size,
+                          const at::Device& device) {
+  TORCH_CHECK(offsets.dim() == 1 && offsets.numel() >= 1,
+              "segment_reduce: offsets must be a 1-D tensor of num_segments + 1 entries");
+  TORCH_CHECK(!at::isFloatingType(offsets.scalar_type()), "segment_reduce: offsets must be integers");
+  at::Tensor host = offsets.to(at::kCPU, at::kLong).contiguous();
+  const int64_t* data = host.data_ptr<int64_t>();
+  const size_t bytes = static_cast<size_t>(host.numel()) * sizeof(int64_t);
+  std::string key = fmt::format(
+      "{}:{}:{}:{}:{:016x}", device.str(), num_rows, row_size, host.numel(), hash_bytes(data, bytes));
+
+  static std::mutex mutex;
+  static std::unordered_map<std::string, SegmentPlan> plans;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = plans.find(key);
+  if (it != plans.end()) {
+    return it->second;
+  }
+  if (plans.size() >= kMaxCachedPlans) {
+    plans.clear();
+  }
+  std::vector<int64_t> off(data, data + host.numel());
+  return plans.emplace(key, build_plan(off, num_rows, row_size, device)).first->second;
+}
+
+at::Tensor segment_reduce(const at::Tensor& data, c10::string_view reduce, const at::Tensor& offsets) {
+  TORCH_CHECK(data.dim() >= 1, "segment_reduce: data must have at least one dim");
+  ReduceOp op;
+  if (reduce == "sum") {
+    op = ReduceOp::SUM;
+  } else if (reduce == "mean") {
+    op = ReduceOp::MEAN;
+  } else if (reduce == "max") {
+    op = ReduceOp::MAX;
+  } else if (reduce == "min") {
+    op = ReduceOp::MIN;
+  } else {
+    TORCH_CHECK(false, "segment_reduce: reduce must be sum, mean, max or min, got ", reduce);
+  }
+  TORCH_CHECK(op != ReduceOp::MEAN || at::isFloatingType(data.scalar_type()),
+              "segment_reduce: mean needs floating point data, got ",
+              data.scalar_type());
+
+  // rows of D elements, with a row stride and dense rows
+  const int64_t T = data.size(0);
+  const int64_t D = c10::multiply_integers(data.sizes().slice(1));
+  at::Tensor rows = data.reshape({T, D});
+  if (D > 1 && rows.stride(1) != 1) {
+    rows = rows.contiguous();
+  }
+  const int64_t num_segments = offsets.numel() - 1;
+
+  std::vector<int64_t> shape = data.sizes().vec();
+  shape[0] = std::max<int64_t>(num_segments, 0);
+  at::ScalarType out_dtype = op == ReduceOp::SUM ? at::native::get_dtype_from_self(data, std::nullopt, true)
+                                                 : data.scalar_type();
+  at::Tensor out = triton_jit::ops::backend_empty(shape, out_dtype, data.device());
+  if (out.numel() == 0) {
+    return out;
+  }
+
+  const SegmentPlan plan = plan_segments(offsets, T, D, data.device());
+  TORCH_CHECK(!plan.has_empty_segment || at::isFloatingType(data.scalar_type()) ||
+                  op == ReduceOp::SUM,
+              "segment_reduce: ",
+              reduce,
+              " of an empty segment of integer data has no identity");
+
+  const at::ScalarType acc_dtype = reduction_acc_dtype(data.scalar_type());
+  at::Tensor mid =
+      triton_jit::ops::backend_empty({std::max<int64_t>(plan.num_slots, 1), D}, acc_dtype, data.device());
+  const int64_t op_code = static_cast<int64_t>(op);
+  const unsigned int col_blocks = cdiv(D, plan.block_d);
+  constexpr auto cfg = triton_jit::ops::default_reduce_config();
+
+  c10::DeviceGuard guard(out.device());
+  triton_jit::ops::RawStream stream = triton_jit::ops::get_device_stream(rows);
+  const TritonJITFunction& f =
+      TritonJITFunction::get_instance(std::string("reduction.py"), "segment_reduce_kernel");
+  f(stream,
+    triton_jit::ops::plan_num_blocks(plan.num_items, "aiv"),
+    col_blocks,
+    1,
+    cfg.num_warps,
+    cfg.num_stages,
+    rows,
+    out,
+    mid,
+    plan.pieces,
+    plan.item_ptr,
+    plan.num_items,
+    D,
+    rows.stride(0),
+    op_code,
+    plan.block_t,
+    plan.block_d);
+
+  if (plan.num_splits > 0) {
+    const TritonJITFunction& combine =
+        TritonJITFunction::get_instance(std::string("reduction.py"), "segment_combine_kernel");
+    combine(stream,
+            triton_jit::ops::plan_num_blocks(plan.num_splits, "aiv"),
+            col_blocks,
+            1,
+            cfg.num_warps,
+            cfg.num_stages,
+            mid,
+            out,
+            plan.splits,
+            plan.num_splits,
+            D,
+            op_code,
+            plan.block_t,
+            plan.block_d);
+  }
+  return out;
+}
+
+TORCH_LIBRARY_FRAGMENT(reduce_ops, m) {
+  m.def("segment_reduce(Tensor data, str reduce, Tensor offsets) -> Tensor");
+}
+
+REGISTER_TRITON_OP(reduce_ops, "segment_reduce", segment_reduce)
+
+}  // namespace my_ops
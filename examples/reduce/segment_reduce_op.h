@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include "torch/torch.h"
+
+namespace my_ops {
+
+/**
+ * @brief Work decomposition of a segmented reduction, reused for equal offsets
+ *
+ * Rows are cut into pieces of at most `piece_rows`. Consecutive short segments
+ * are packed into one work item, and a segment longer than a piece is split
+ * into pieces of its own whose partial rows are merged by a second kernel.
+ */
+struct SegmentPlan {
+  /// [P, 4] int64: segment, first row, end row, slot of the partial row (-1 for a whole segment)
+  at::Tensor pieces;
+  /// [num_items + 1] int64, pieces of item i are [item_ptr[i], item_ptr[i + 1])
+  at::Tensor item_ptr;
+  /// [num_splits, 4] int64: segment, first slot, end slot, rows of the segment
+  at::Tensor splits;
+  int64_t num_items = 0;
+  int64_t num_slots = 0;
+  int64_t num_splits = 0;
+  int64_t piece_rows = 0;
+  int64_t block_t = 1;
+  int64_t block_d = 1;
+  bool has_empty_segment = false;
+};
+
+/**
+ * @brief Plan for `offsets` over rows of `row_size` elements
+ *
+ * Plans are cached on the host by the content of `offsets`. Offsets on the
+ * device are copied to the host first, so callers that keep a host copy should
+ * pass that one.
+ */
+SegmentPlan plan_segments(const at::Tensor& offsets,
+                          int64_t num_rows,
+                          int64_t row_size,
+                          const at::Device& device);
+
+/**
+ * @brief Reduce rows [offsets[s], offsets[s + 1]) of `data` along dim 0 for every segment s
+ *
+ * reduce is "sum", "mean", "max" or "min". The result has shape
+ * [offsets.numel() - 1, *data.shape[1:]]. Empty segments produce 0 for sum, NaN
+ * for mean and -inf (+inf) for max (min); for integer data they are rejected by
+ * max and min.
+ */
+at::Tensor segment_reduce(const at::Tensor& data, c10::string_view reduce, const at::Tensor& offsets);
+
+}  // namespace my_ops
@@ -1,88 +1,46 @@
 #include "sum_op.h"
 #include "common/backend_ops.h"
-#include "common/kernel_config.h"
 #include "common/op_registration.h"
+#include "reduction.h"
 #include "torch/torch.h"
-#include "triton_jit/triton_jit_function.h"
 
-#include <filesystem>
-#include "ATen/WrapDimUtils.h"
 #include "ATen/native/ReduceOpsUtils.h"
-#include "c10/util/DimVector.h"
-
-std::tuple<at::Tensor, int64_t, int64_t> permute_reduction_axes_right(
-    const at::Tensor& tensor, at::OptionalIntArrayRef reduction_axes_opt) {
-  int64_t dim = tensor.dim();
-  c10::DimVector reduction_axes;
-
-  if (reduction_axes_opt.has_value()) {
-    reduction_axes = reduction_axes_opt.value().vec();
-  }
-
-  std::unordered_set<int64_t> reduction_set(reduction_axes.begin(), reduction_axes.end());
-
-  c10::DimVector left_axes, right_axes;
-  int64_t non_reduction_size = 1, reduction_size = 1;
-
-  for (int64_t i = 0; i < dim; ++i) {
-    if (reduction_set.count(i)) {
-      right_axes.push_back(i);
-      reduction_size *= tensor.size(i);
-    } else {
-      left_axes.push_back(i);
-      non_reduction_size *= tensor.size(i);
-    }
-  }
-
-  c10::DimVector permute_order = left_axes;
-  permute_order.insert(permute_order.end(), right_axes.begin(), right_axes.end());
-
-  return {tensor.permute(permute_order), non_reduction_size, reduction_size};
-}
 
 namespace my_ops {
-using namespace triton_jit;
 
 at::Tensor sum_dim(const at::Tensor& self,
                    at::OptionalIntArrayRef dim,
                    bool keepdim,
                    ::std::optional<at::ScalarType> dtype) {
-  at::DimVector dims_ = at::native::make_dim_vector(dim, self.dim());
-  at::maybe_wrap_dims(dims_, self.dim());
+  at::DimVector dims_ = reduction_dims(self, dim);
   at::DimVector shape = at::meta::get_reduction_shape(self, dims_, keepdim, false);
   c10::ScalarType out_dtype = at::native::get_dtype_from_self(self, dtype, true);
-  at::Tensor out = at::empty(shape, self.options());
-  auto [permuted_self, non_reduction_size, reduction_size] = permute_reduction_axes_right(self, dims_);
-  permuted_self = permuted_self.contiguous();
-
-  const TritonJITFunction& f = TritonJITFunction::get_instance("./sum.py", "sum_dim_kernel");
-
-  constexpr auto cfg = triton_jit::ops::default_reduce_sum_config();
-
-  const unsigned int num_blocks = (non_reduction_size + cfg.BLOCK_M - 1) / cfg.BLOCK_M;
-
-  c10::DeviceGuard guard(out.device());
-  triton_jit::ops::RawStream stream = triton_jit::ops::get_device_stream(permuted_self);
+  at::Tensor out = triton_jit::ops::backend_empty(shape, out_dtype, self.device());
+  run_reduction(self, dims_, ReduceOp::SUM, out);
+  return out;
+}
 
-  f(stream,
-    num_blocks,
-    1,
-    1,
-    cfg.num_warps,
-    cfg.num_stages,
-    permuted_self,
-    out,
-    non_reduction_size,
-    reduction_size,
-    cfg.BLOCK_M,
-    cfg.BLOCK_N);
+at::Tensor& sum_dim_out(const at::Tensor& self,
+                        at::OptionalIntArrayRef dim,
+                        bool keepdim,
+                        ::std::optional<at::ScalarType> dtype,
+                        at::Tensor& out) {
+  at::DimVector dims_ = reduction_dims(self, dim);
+  at::DimVector shape = at::meta::get_reduction_shape(self, dims_, keepdim, false);
+  c10::ScalarType out_dtype = at::native::get_dtype_from_self(self, dtype, true);
+  triton_jit::ops::check_out_tensor("sum_dim.out", out, shape, out_dtype, self.device());
+  run_reduction(self, dims_, ReduceOp::SUM, out);
   return out;
 }
 
 TORCH_LIBRARY(sum_ops, m) {
   m.def("sum_dim(Tensor self, int[1]? dim, bool keepdim=False, *, ScalarType? dtype=None) -> Tensor");
+  m.def(
+      "sum_dim.out(Tensor self, int[1]? dim, bool keepdim=False, *, ScalarType? dtype=None, "
+      "Tensor(a!) out) -> Tensor(a!)");
 }
 
 REGISTER_TRITON_OP(sum_ops, "sum_dim", sum_dim)
+REGISTER_TRITON_OP(sum_ops, "sum_dim.out", sum_dim_out)
 
 }  // namespace my_ops
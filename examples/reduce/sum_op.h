@@ -10,5 +10,10 @@ at::Tensor sum_dim(const at::Tensor& self,
                    at::OptionalIntArrayRef dim,
                    bool keepdim,
                    ::std::optional<at::ScalarType> dtype);
+at::Tensor& sum_dim_out(const at::Tensor& self,
+                        at::OptionalIntArrayRef dim,
+                        bool keepdim,
+                        ::std::optional<at::ScalarType> dtype,
+                        at::Tensor& out);
 
 }  // namespace my_ops
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "reduce_op.h"
+#include "reduction.h"
+#include "segment_reduce_op.h"
+#include "torch/torch.h"
+#include "triton_jit/backend_config.h"
+
+static at::Device test_device() {
+#if defined(BACKEND_NPU)
+  return at::Device("npu:0");
+#elif defined(BACKEND_MUSA)
+  return at::Device("musa:0");
+#elif defined(BACKEND_INTERPRETER)
+  return at::kCPU;
+#else
+  return at::kCUDA;
+#endif
+}
+
+TEST(reduce_test, mean_inner_and_outer) {
+  at::Tensor t = at::randn({64, 1000}, test_device());
+  at::Tensor inner = my_ops::mean_dim(t, {1}, false, std::nullopt);
+  at::Tensor outer = my_ops::mean_dim(t, {0}, true, std::nullopt);
+  EXPECT_TRUE(torch::allclose(inner, at::mean(t, {1}), 1e-4, 1e-5));
+  EXPECT_TRUE(torch::allclose(outer, at::mean(t, {0}, true), 1e-4, 1e-5));
+}
+
+TEST(reduce_test, strided_view_is_not_copied) {
+  at::Tensor t = at::randn({512, 256}, test_device());
+  my_ops::ReductionPlan plan = my_ops::plan_reduction(t, {0});
+  EXPECT_EQ(plan.input.data_ptr(), t.data_ptr());
+  EXPECT_EQ(plan.M, 256);
+  EXPECT_EQ(plan.N, 512);
+  EXPECT_EQ(plan.stride_m, 1);
+  EXPECT_EQ(plan.stride_n, 256);
+}
+
+TEST(reduce_test, full_reduction) {
+  at::Tensor t = at::randn({1 << 20}, test_device());
+  my_ops::ReductionPlan plan = my_ops::plan_reduction(t, {0});
+  EXPECT_EQ(plan.chunk % plan.block_n, 0);
+  EXPECT_GE(plan.chunk * plan.num_splits, plan.N);
+
+  at::Tensor mean_all = my_ops::mean_dim(t, std::nullopt, false, std::nullopt);
+  EXPECT_TRUE(torch::allclose(mean_all, at::mean(t), 1e-4, 1e-5));
+  EXPECT_TRUE(torch::equal(my_ops::amax(t, {}, false), at::amax(t)));
+  EXPECT_TRUE(torch::equal(my_ops::argmin(t, std::nullopt, false), at::argmin(t)));
+  auto [var, mean] = my_ops::var_mean(t, std::nullopt, 1.0, false);
+  EXPECT_TRUE(torch::allclose(var, at::var(t), 1e-4, 1e-5));
+  EXPECT_TRUE(torch::allclose(mean, at::mean(t), 1e-4, 1e-5));
+}
+
+TEST(reduce_test, max_min_argmax) {
+  at::Tensor t = at::randn({33, 17, 65}, test_device());
+  EXPECT_TRUE(torch::equal(my_ops::amax(t, {2}, false), at::amax(t, {2})));
+  EXPECT_TRUE(torch::equal(my_ops::amin(t, {0, 2}, true), at::amin(t, {0, 2}, true)));
+  EXPECT_TRUE(torch::equal(my_ops::argmax(t, 1, false), at::argmax(t, 1)));
+  EXPECT_TRUE(torch::equal(my_ops::argmax(t, std::nullopt, false), at::argmax(t)));
+}
+
+TEST(reduce_test, integer_inputs) {
+  at::Tensor t = at::randint(-100, 100, {40, 300}, at::TensorOptions().dtype(at::kInt).device(test_device()));
+  EXPECT_TRUE(torch::equal(my_ops::amax(t, {1}, false), at::amax(t, {1})));
+  EXPECT_TRUE(torch::equal(my_ops::argmin(t, 1, false), at::argmin(t, 1)));
+  at::Tensor small = at::randint(1, 3, {8, 20}, at::TensorOptions().dtype(at::kInt).device(test_device()));
+  at::Tensor prod = my_ops::prod_dim(small, 1, false, std::nullopt);
+  EXPECT_EQ(prod.scalar_type(), at::kLong);
+  EXPECT_TRUE(torch::equal(prod, at::prod(small, 1)));
+}
+
+TEST(reduce_test, norm_and_var_mean) {
+  at::Tensor t = at::randn({128, 777}, at::TensorOptions().dtype(at::kHalf).device(test_device()));
+  at::Tensor f = t.to(at::kFloat);
+  at::Tensor l2 = my_ops::vector_norm(t, 2, at::IntArrayRef {1}, false, std::nullopt);
+  at::Tensor l1 = my_ops::vector_norm(t, 1, at::IntArrayRef {1}, false, at::kFloat);
+  EXPECT_TRUE(torch::allclose(l2.to(at::kFloat), at::linalg_vector_norm(f, 2, {1}), 1e-2, 1e-2));
+  EXPECT_TRUE(torch::allclose(l1, at::linalg_vector_norm(f, 1, {1}), 1e-3, 1e-3));
+
+  auto [var, mean] = my_ops::var_mean(f, at::IntArrayRef {1}, 0.0, true);
+  auto [expected_var, expected_mean] = at::var_mean(f, {1}, 0, true);
+  EXPECT_TRUE(torch::allclose(var, expected_var, 1e-4, 1e-5));
+  EXPECT_TRUE(torch::allclose(mean, expected_mean, 1e-4, 1e-5));
+}
+
+TEST(reduce_test, empty_reduced_dim) {
+  at::Tensor t = at::randn({4, 0}, test_device());
+  EXPECT_TRUE(torch::equal(my_ops::prod_dim(t, 1, false, std::nullopt), at::ones({4}, t.options())));
+  EXPECT_THROW(my_ops::amax(t, {1}, false), c10::Error);
+}
+
+static at::Tensor reference_segment_reduce(const at::Tensor& data,
+                                           const std::string& reduce,
+                                           const std::vector<int64_t>& offsets) {
+  std::vector<at::Tensor> rows;
+  for (size_t s = 0; s + 1 < offsets.size(); s++) {
+    at::Tensor segment = data.slice(0, offsets[s], offsets[s + 1]);
+    if (reduce == "sum") {
+      rows.push_back(segment.sum(0));
+    } else if (reduce == "mean") {
+      rows.push_back(segment.mean(0));
+    } else {
+      rows.push_back(reduce == "max" ? std::get<0>(segment.max(0)) : std::get<0>(segment.min(0)));
+    }
+  }
+  return at::stack(rows);
+}
+
+TEST(segment_reduce_test, ragged_batch) {
+  // short segments packed together, and one long enough to be split
+  std::vector<int64_t> offsets = {0, 3, 3, 20, 21, 9000, 9100};
+  at::Tensor data = at::randn({9100, 96}, test_device());
+  at::Tensor offsets_t = at::tensor(offsets, at::TensorOptions().dtype(at::kLong));
+
+  my_ops::SegmentPlan plan = my_ops::plan_segments(offsets_t, 9100, 96, data.device());
+  EXPECT_GT(plan.num_splits, 0);
+
+  at::Tensor sum = my_ops::segment_reduce(data, "sum", offsets_t);
+  EXPECT_TRUE(torch::allclose(sum, reference_segment_reduce(data, "sum", offsets), 1e-3, 1e-3));
+  at::Tensor mean = my_ops::segment_reduce(data, "mean", offsets_t.to(test_device()));
+  at::Tensor expected_mean = reference_segment_reduce(data, "mean", offsets);
+  EXPECT_TRUE(torch::allclose(mean, expected_mean, 1e-4, 1e-5, /*equal_nan=*/true));
+
+  std::vector<int64_t> non_empty = {0, 3, 20, 21, 9000, 9100};
+  at::Tensor non_empty_t = at::tensor(non_empty, at::TensorOptions().dtype(at::kLong));
+  EXPECT_TRUE(torch::equal(my_ops::segment_reduce(data, "max", non_empty_t),
+                           reference_segment_reduce(data, "max", non_empty)));
+  EXPECT_TRUE(torch::equal(my_ops::segment_reduce(data, "min", non_empty_t),
+                           reference_segment_reduce(data, "min", non_empty)));
+}
+
+TEST(segment_reduce_test, plan_is_cached_by_offsets) {
+  at::Tensor a = at::tensor(std::vector<int64_t> {0, 5, 17}, at::TensorOptions().dtype(at::kLong));
+  at::Tensor b = a.clone();
+  my_ops::SegmentPlan p1 = my_ops::plan_segments(a, 17, 8, test_device());
+  my_ops::SegmentPlan p2 = my_ops::plan_segments(b, 17, 8, test_device());
+  EXPECT_EQ(p1.pieces.data_ptr(), p2.pieces.data_ptr());
+}
+
+TEST(segment_reduce_test, integer_data) {
+  at::Tensor data = at::randint(-50, 50, {300}, at::TensorOptions().dtype(at::kInt).device(test_device()));
+  std::vector<int64_t> offsets = {0, 1, 100, 300};
+  at::Tensor offsets_t = at::tensor(offsets, at::TensorOptions().dtype(at::kLong));
+  at::Tensor sum = my_ops::segment_reduce(data, "sum", offsets_t);
+  EXPECT_EQ(sum.scalar_type(), at::kLong);
+  EXPECT_TRUE(torch::equal(sum, reference_segment_reduce(data, "sum", offsets)));
+  EXPECT_TRUE(torch::equal(my_ops::segment_reduce(data, "max", offsets_t),
+                           reference_segment_reduce(data, "max", offsets)));
+}
@@ -8,6 +8,8 @@ static at::Device test_device() {
   return at::Device("npu:0");
 #elif defined(BACKEND_MUSA)
   return at::Device("musa:0");
+#elif defined(BACKEND_INTERPRETER)
+  return at::kCPU;
 #else
   return at::kCUDA;
 #endif
@@ -37,3 +39,19 @@ TEST(sum_test, keepdim) {
   EXPECT_TRUE(torch::allclose(result, expected, 1e-3, 1e-3));
   EXPECT_EQ(result.sizes(), expected.sizes());
 }
+
+TEST(sum_test, out_reuses_buffer) {
+  at::Tensor tensor = at::rand({16, 4 * 1024}, test_device());
+  at::Tensor out = at::empty({16}, tensor.options());
+  void* buffer = out.data_ptr();
+
+  at::Tensor& result = my_ops::sum_dim_out(tensor, {1}, false, c10::nullopt, out);
+  EXPECT_EQ(result.data_ptr(), buffer);
+  EXPECT_TRUE(torch::allclose(out, at::sum(tensor, {1}, false, c10::nullopt), 1e-3, 1e-3));
+}
+
+TEST(sum_test, out_keepdim_shape_checked) {
+  at::Tensor tensor = at::rand({16, 4 * 1024}, test_device());
+  at::Tensor out = at::empty({16}, tensor.options());
+  EXPECT_THROW(my_ops::sum_dim_out(tensor, {1}, true, c10::nullopt, out), c10::Error);
+}
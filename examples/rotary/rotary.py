@@ -0,0 +1,129 @@
+import torch
+import triton
+from triton import language as tl
+
+
+@triton.jit
+def rotate_heads(
+    X,
+    tokens,
+    heads,
+    x1_off,
+    x2_off,
+    cos,
+    sin,
+    token_mask,
+    dim_mask,
+    num_heads,
+    stride_t,
+    stride_h,
+):
+    mask = (
+        token_mask[:, None, None]
+        & (heads < num_heads)[None, :, None]
+        & dim_mask[None, None, :]
+    )
+    base = X + tokens[:, None, None] * stride_t + heads[None, :, None] * stride_h
+    x1 = tl.load(base + x1_off[None, None, :], mask=mask, other=0.0).to(tl.float32)
+    x2 = tl.load(base + x2_off[None, None, :], mask=mask, other=0.0).to(tl.float32)
+    o1 = x1 * cos - x2 * sin
+    o2 = x2 * cos + x1 * sin
+    tl.store(base + x1_off[None, None, :], o1.to(X.dtype.element_ty), mask=mask)
+    tl.store(base + x2_off[None, None, :], o2.to(X.dtype.element_ty), mask=mask)
+
+
+@triton.jit
+def rotary_embedding_kernel(
+    Q,
+    K,
+    Cos,
+    Sin,
+    Pos,
+    num_tokens,
+    q_heads,
+    k_heads,
+    q_stride_t,
+    q_stride_h,
+    k_stride_t,
+    k_stride_h,
+    cos_stride,
+    sin_stride,
+    HALF_DIM: tl.constexpr,
+    BLOCK_D: tl.constexpr,
+    INTERLEAVED: tl.constexpr,
+    BLOCK_N: tl.constexpr,
+    BLOCK_H: tl.constexpr,
+):
+    """Rotate Q and K in place; programs tile tokens (axis 0) and heads (axis 1)."""
+    pid_n = tl.program_id(0)
+    pid_h = tl.program_id(1)
+    tokens = pid_n * BLOCK_N + tl.arange(0, BLOCK_N)
+    heads = pid_h * BLOCK_H + tl.arange(0, BLOCK_H)
+    dims = tl.arange(0, BLOCK_D)
+    token_mask = tokens < num_tokens
+    dim_mask = dims < HALF_DIM
+
+    # cos/sin rows are gathered once per token tile and shared by Q and K
+    pos = tl.load(Pos + tokens, mask=token_mask, other=0)
+    cs_mask = token_mask[:, None] & dim_mask[None, :]
+    cos = tl.load(Cos + pos[:, None] * cos_stride + dims[None, :], mask=cs_mask, other=0.0)
+    sin = tl.load(Sin + pos[:, None] * sin_stride + dims[None, :], mask=cs_mask, other=0.0)
+    cos = cos.to(tl.float32)[:, None, :]
+    sin = sin.to(tl.float32)[:, None, :]
+
+    if INTERLEAVED:
+        x1_off = dims * 2
+        x2_off = dims * 2 + 1
+    else:
+        x1_off = dims
+        x2_off = dims + HALF_DIM
+
+    if pid_h * BLOCK_H < q_heads:
+        rotate_heads(
+            Q, tokens, heads, x1_off, x2_off, cos, sin,
+            token_mask, dim_mask, q_heads, q_stride_t, q_stride_h,
+        )
+    if pid_h * BLOCK_H < k_heads:
+        rotate_heads(
+            K, tokens, heads, x1_off, x2_off, cos, sin,
+            token_mask, dim_mask, k_heads, k_stride_t, k_stride_h,
+        )
+
+
+def rotary_embedding(q, k, cos, sin, positions, interleaved=False):
+    num_tokens, q_heads, _ = q.shape
+    k_heads = k.shape[1]
+    half_dim = cos.shape[-1]
+    BLOCK_N, BLOCK_H = 8, 4
+    grid = (triton.cdiv(num_tokens, BLOCK_N), triton.cdiv(max(q_heads, k_heads), BLOCK_H))
+    with torch.cuda.device(q.device):
+        rotary_embedding_kernel[grid](
+            q, k, cos, sin, positions,
+            num_tokens, q_heads, k_heads,
+            q.stride(0), q.stride(1), k.stride(0), k.stride(1),
+            cos.stride(0), sin.stride(0),
+            HALF_DIM=half_dim,
+            BLOCK_D=triton.next_power_of_2(half_dim),
+            INTERLEAVED=interleaved,
+            BLOCK_N=BLOCK_N,
+            BLOCK_H=BLOCK_H,
+        )
+
+
+if __name__ == "__main__":
+    qkv = torch.randn(16, 8 + 2 + 2, 64, device="cuda")
+    q, k = qkv[:, :8], qkv[:, 8:10]
+    angles = torch.randn(128, 32, device="cuda")
+    cos, sin = angles.cos(), angles.sin()
+    positions = torch.randint(0, 128, (16,), device="cuda")
+
+    def reference(x):
+        c = cos[positions][:, None, :]
+        s = sin[positions][:, None, :]
+        x1, x2 = x[..., :32], x[..., 32:]
+        return torch.cat([x1 * c - x2 * s, x2 * c + x1 * s], dim=-1)
+
+    expected_q, expected_k = reference(q), reference(k)
+    rotary_embedding(q, k, cos, sin, positions)
+    torch.testing.assert_close(q, expected_q)
+    torch.testing.assert_close(k, expected_k)
@@ -0,0 +1,98 @@
+#include "rotary_op.h"
+#include <algorithm>
+#include "common/backend_ops.h"
+#include "common/kernel_config.h"
+#include "common/op_registration.h"
+#include "triton_jit/triton_jit_function.h"
+
+namespace my_ops {
+using namespace triton_jit;
+
+// View [..., heads, head_dim] as [tokens, heads, head_dim] without copying
+static at::Tensor as_token_head_view(const at::Tensor& x, const char* name) {
+  TORCH_CHECK(x.dim() >= 3, "rotary_embedding: ", name, " must be [..., heads, head_dim]");
+  TORCH_CHECK(x.stride(-1) == 1, "rotary_embedding: ", name, " must be contiguous in head_dim");
+  return x.view({-1, x.size(-2), x.size(-1)});
+}
+
+void rotary_embedding(at::Tensor& query,
+                      at::Tensor& key,
+                      const at::Tensor& cos,
+                      const at::Tensor& sin,
+                      const at::Tensor& positions,
+                      bool interleaved) {
+  at::Tensor q = as_token_head_view(query, "query");
+  at::Tensor k = as_token_head_view(key, "key");
+  const int64_t num_tokens = q.size(0);
+  const int64_t head_dim = q.size(2);
+  TORCH_CHECK(k.size(0) == num_tokens && k.size(2) == head_dim,
+              "rotary_embedding: query and key must agree on tokens and head_dim");
+  TORCH_CHECK(query.scalar_type() == key.scalar_type(), "rotary_embedding: query and key dtypes differ");
+
+  TORCH_CHECK(cos.dim() == 2 && cos.sizes() == sin.sizes(),
+              "rotary_embedding: cos/sin must be [max_position, rotary_dim / 2]");
+  TORCH_CHECK(cos.stride(1) == 1 && sin.stride(1) == 1,
+              "rotary_embedding: cos/sin must be contiguous in the last dim");
+  const int64_t half_dim = cos.size(1);
+  TORCH_CHECK(half_dim > 0 && 2 * half_dim <= head_dim, "rotary_embedding: rotary_dim exceeds head_dim");
+
+  at::Tensor pos = positions.reshape({-1});
+  TORCH_CHECK(pos.numel() == num_tokens, "rotary_embedding: positions must have one entry per token");
+  if (pos.scalar_type() != at::kLong || !pos.is_contiguous()) {
+    pos = pos.to(at::kLong).contiguous();
+  }
+  if (num_tokens == 0) {
+    return;
+  }
+
+  constexpr auto cfg = triton_jit::ops::default_rotary_config();
+  int64_t block_d = 1;
+  while (block_d < half_dim) {
+    block_d *= 2;
+  }
+  const int64_t max_heads = std::max(q.size(1), k.size(1));
+  const unsigned int grid_n = static_cast<unsigned int>((num_tokens + cfg.BLOCK_N - 1) / cfg.BLOCK_N);
+  const unsigned int grid_h = static_cast<unsigned int>((max_heads + cfg.BLOCK_H - 1) / cfg.BLOCK_H);
+
+  const TritonJITFunction& f =
+      TritonJITFunction::get_instance(std::string("rotary.py"), "rotary_embedding_kernel");
+
+  c10::DeviceGuard guard(query.device());
+  triton_jit::ops::RawStream stream = triton_jit::ops::get_device_stream(q);
+
+  f(stream,
+    grid_n,
+    grid_h,
+    1,
+    cfg.num_warps,
+    cfg.num_stages,
+    q,
+    k,
+    cos,
+    sin,
+    pos,
+    num_tokens,
+    q.size(1),
+    k.size(1),
+    q.stride(0),
+    q.stride(1),
+    k.stride(0),
+    k.stride(1),
+    cos.stride(0),
+    sin.stride(0),
+    half_dim,
+    block_d,
+    interleaved,
+    cfg.BLOCK_N,
+    cfg.BLOCK_H);
+}
+
+TORCH_LIBRARY(rotary_ops, m) {
+  m.def(
+      "rotary_embedding(Tensor(a!) query, Tensor(b!) key, Tensor cos, Tensor sin, Tensor positions, "
+      "bool interleaved=False) -> ()");
+}
+
+REGISTER_TRITON_OP(rotary_ops, "rotary_embedding", rotary_embedding)
+
+}  // namespace my_ops
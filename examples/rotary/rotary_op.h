@@ -0,0 +1,16 @@
+#pragma once
+
+#include "torch/torch.h"
+
+namespace my_ops {
+
+// Rotate query [..., q_heads, head_dim] and key [..., k_heads, head_dim] in place.
+// cos/sin are [max_position, rotary_dim / 2], positions has one entry per token.
+void rotary_embedding(at::Tensor& query,
+                      at::Tensor& key,
+                      const at::Tensor& cos,
+                      const at::Tensor& sin,
+                      const at::Tensor& positions,
+                      bool interleaved);
+
+}  // namespace my_ops
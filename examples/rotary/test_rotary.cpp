@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "rotary_op.h"
+#include "torch/torch.h"
+#include "triton_jit/backend_config.h"
+
+static at::Device test_device() {
+#if defined(BACKEND_NPU)
+  return at::Device("npu:0");
+#elif defined(BACKEND_MUSA)
+  return at::Device("musa:0");
+#elif defined(BACKEND_INTERPRETER)
+  return at::kCPU;
+#else
+  return at::kCUDA;
+#endif
+}
+
+static at::Tensor reference_rotary(const at::Tensor& x,
+                                   const at::Tensor& cos,
+                                   const at::Tensor& sin,
+                                   const at::Tensor& positions,
+                                   bool interleaved) {
+  const int64_t half = cos.size(1);
+  at::Tensor c = cos.index_select(0, positions).unsqueeze(1);
+  at::Tensor s = sin.index_select(0, positions).unsqueeze(1);
+  at::Tensor rot = x.narrow(-1, 0, 2 * half);
+  at::Tensor x1, x2;
+  if (interleaved) {
+    x1 = rot.slice(-1, 0, 2 * half, 2);
+    x2 = rot.slice(-1, 1, 2 * half, 2);
+  } else {
+    x1 = rot.narrow(-1, 0, half);
+    x2 = rot.narrow(-1, half, half);
+  }
+  at::Tensor o1 = x1 * c - x2 * s;
+  at::Tensor o2 = x2 * c + x1 * s;
+  at::Tensor out = x.clone();
+  if (interleaved) {
+    out.narrow(-1, 0, 2 * half).copy_(at::stack({o1, o2}, -1).flatten(-2));
+  } else {
+    out.narrow(-1, 0, 2 * half).copy_(at::cat({o1, o2}, -1));
+  }
+  return out;
+}
+
+static void run_rotary(bool interleaved, int64_t head_dim, int64_t rotary_dim) {
+  const int64_t tokens = 37, q_heads = 8, k_heads = 2;
+  // q and k are strided slices of a fused qkv projection
+  at::Tensor qkv = at::randn({tokens, q_heads + 2 * k_heads, head_dim}, test_device());
+  at::Tensor q = qkv.narrow(1, 0, q_heads);
+  at::Tensor k = qkv.narrow(1, q_heads, k_heads);
+  at::Tensor angles = at::randn({256, rotary_dim / 2}, test_device());
+  at::Tensor cos = angles.cos();
+  at::Tensor sin = angles.sin();
+  at::Tensor positions =
+      at::randint(0, 256, {tokens}, at::TensorOptions().dtype(at::kLong).device(test_device()));
+
+  at::Tensor expected_q = reference_rotary(q, cos, sin, positions, interleaved);
+  at::Tensor expected_k = reference_rotary(k, cos, sin, positions, interleaved);
+  at::Tensor v_before = qkv.narrow(1, q_heads + k_heads, k_heads).clone();
+
+  my_ops::rotary_embedding(q, k, cos, sin, positions, interleaved);
+  EXPECT_TRUE(torch::allclose(q, expected_q, 1e-5, 1e-5));
+  EXPECT_TRUE(torch::allclose(k, expected_k, 1e-5, 1e-5));
+  EXPECT_TRUE(torch::equal(qkv.narrow(1, q_heads + k_heads, k_heads), v_before));
+}
+
+TEST(rotary_test, half_split) {
+  run_rotary(false, 64, 64);
+}
+
+TEST(rotary_test, interleaved_partial) {
+  run_rotary(true, 128, 64);
+}
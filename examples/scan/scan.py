@@ -0,0 +1,267 @@
+import torch
+import triton
+from triton import language as tl
+
+# OP constexpr values, kept in sync with ScanOp in scan_op.h
+SUM = tl.constexpr(0)
+PROD = tl.constexpr(1)
+
+
+@triton.jit
+def _combine(a, b, OP: tl.constexpr):
+    if OP == SUM:
+        r = a + b
+    else:
+        r = a * b
+    return r
+
+
+@triton.jit
+def _mul(a, b):
+    return a * b
+
+
+@triton.jit
+def _identity_like(x, OP: tl.constexpr):
+    r = tl.zeros_like(x)
+    if OP == PROD:
+        r += 1
+    return r
+
+
+@triton.jit
+def _tile_coords(t, I, tiles_per_row, BLOCK_I: tl.constexpr):
+    """Row tile, outer index and first column of tile t; the tiles of a row are consecutive."""
+    i_blocks = tl.cdiv(I, BLOCK_I)
+    row_tile = t % tiles_per_row
+    group = t // tiles_per_row
+    return row_tile, group // i_blocks, (group % i_blocks) * BLOCK_I
+
+
+@triton.jit
+def _load_tile(
+    inp,
+    t,
+    L,
+    I,
+    tiles_per_row,
+    stride_o,
+    stride_l,
+    stride_i,
+    acc_ty: tl.constexpr,
+    OP: tl.constexpr,
+    BLOCK_L: tl.constexpr,
+    BLOCK_I: tl.constexpr,
+):
+    """Tile t as [BLOCK_L, BLOCK_I] in the accumulator type, padded with the identity."""
+    row_tile, o, col0 = _tile_coords(t, I, tiles_per_row, BLOCK_I)
+    rows = row_tile * BLOCK_L + tl.arange(0, BLOCK_L)
+    cols = col0 + tl.arange(0, BLOCK_I)
+    mask = (rows[:, None] < L) & (cols[None, :] < I)
+    offsets = o * stride_o + rows[:, None] * stride_l + cols[None, :] * stride_i
+    x = tl.load(inp + offsets, mask=mask).to(acc_ty)
+    return tl.where(mask, x, _identity_like(x, OP))
+
+
+@triton.jit
+def _store_tile(out, t, L, I, tiles_per_row, y, BLOCK_L: tl.constexpr, BLOCK_I: tl.constexpr):
+    """Stores tile t of the dense [outer, L, I] output."""
+    row_tile, o, col0 = _tile_coords(t, I, tiles_per_row, BLOCK_I)
+    rows = row_tile * BLOCK_L + tl.arange(0, BLOCK_L)
+    cols = col0 + tl.arange(0, BLOCK_I)
+    mask = (rows[:, None] < L) & (cols[None, :] < I)
+    offsets = o * L * I + rows[:, None] * I + cols[None, :]
+    tl.store(out + offsets, y.to(out.dtype.element_ty), mask=mask)
+
+
+@triton.jit
+def _scan_tile(x, OP: tl.constexpr):
+    if OP == SUM:
+        r = tl.cumsum(x, axis=0)
+    else:
+        r = tl.cumprod(x, axis=0)
+    return r
+
+
+@triton.jit
+def _reduce_tile(x, OP: tl.constexpr):
+    if OP == SUM:
+        r = tl.sum(x, axis=0)
+    else:
+        r = tl.reduce(x, 0, _mul)
+    return r
+
+
+@triton.jit
+def scan_lookback_kernel(
+    inp,
+    out,
+    flags,
+    partials,
+    L,
+    I,
+    tiles_per_row,
+    num_tiles,
+    epoch,
+    stride_o,
+    stride_l,
+    stride_i,
+    OP: tl.constexpr,
+    BLOCK_L: tl.constexpr,
+    BLOCK_I: tl.constexpr,
+):
+    """Single-pass scan along L with decoupled look-back, one tile per program.
+
+    Tiles are numbered in the order programs start, taken from the counter at
+    flags[0], so every predecessor of a tile is already running. A tile
+    publishes its aggregate, looks back over its predecessors until one has
+    published its inclusive prefix, and then publishes its own prefix. Flags hold
+    2 * epoch (aggregate) or 2 * epoch + 1 (inclusive prefix) of the launch that
+    wrote them, so the pooled buffer is reused without being cleared.
+    """
+    t = tl.atomic_add(flags, 1)
+    if t == num_tiles - 1:
+        # every tile index has been handed out: reset the counter for the next launch
+        tl.atomic_xchg(flags, 0)
+    t = t.to(tl.int64)
+    flags += 1
+
+    acc_ty = partials.dtype.element_ty
+    x = _load_tile(inp, t, L, I, tiles_per_row, stride_o, stride_l, stride_i, acc_ty, OP, BLOCK_L, BLOCK_I)
+    total = _reduce_tile(x, OP)
+
+    aggregate_ready = epoch * 2
+    prefix_ready = epoch * 2 + 1
+    cols = tl.arange(0, BLOCK_I)
+    AGG = partials
+    INCL = partials + num_tiles * BLOCK_I
+    prefix = _identity_like(total, OP)
+    if t % tiles_per_row == 0:
+        tl.store(INCL + t * BLOCK_I + cols, total)
+        tl.atomic_xchg(flags + t, prefix_ready)
+    else:
+        tl.store(AGG + t * BLOCK_I + cols, total)
+        tl.atomic_xchg(flags + t, aggregate_ready)
+        j = t - 1
+        looking = True
+        while looking:
+            state = tl.atomic_add(flags + j, 0)
+            if state == prefix_ready:
+                prefix = _combine(tl.load(INCL + j * BLOCK_I + cols, volatile=True), prefix, OP)
+                looking = False
+            elif state == aggregate_ready:
+                prefix = _combine(tl.load(AGG + j * BLOCK_I + cols, volatile=True), prefix, OP)
+                j -= 1
+        tl.store(INCL + t * BLOCK_I + cols, _combine(prefix, total, OP))
+        tl.atomic_xchg(flags + t, prefix_ready)
+
+    y = _combine(prefix[None, :], _scan_tile(x, OP), OP)
+    _store_tile(out, t, L, I, tiles_per_row, y, BLOCK_L, BLOCK_I)
+
+
+@triton.jit
+def scan_reduce_kernel(
+    inp,
+    partials,
+    L,
+    I,
+    tiles_per_row,
+    stride_o,
+    stride_l,
+    stride_i,
+    OP: tl.constexpr,
+    BLOCK_L: tl.constexpr,
+    BLOCK_I: tl.constexpr,
+):
+    """Multi-kernel scan, pass 1: partials[t] = aggregate of tile t."""
+    t = tl.program_id(0).to(tl.int64)
+    acc_ty = partials.dtype.element_ty
+    x = _load_tile(inp, t, L, I, tiles_per_row, stride_o, stride_l, stride_i, acc_ty, OP, BLOCK_L, BLOCK_I)
+    tl.store(partials + t * BLOCK_I + tl.arange(0, BLOCK_I), _reduce_tile(x, OP))
+
+
+@triton.jit
+def scan_partials_kernel(
+    partials,
+    tiles_per_row,
+    OP: tl.constexpr,
+    BLOCK_T: tl.constexpr,
+    BLOCK_I: tl.constexpr,
+):
+    """Multi-kernel scan, pass 2: inclusive scan of the tile aggregates of one row group, in place."""
+    group = tl.program_id(0).to(tl.int64)
+    base = partials + group * tiles_per_row * BLOCK_I
+    cols = tl.arange(0, BLOCK_I)
+    carry = _identity_like(tl.zeros([BLOCK_I], dtype=partials.dtype.element_ty), OP)
+    for off in range(0, tiles_per_row, BLOCK_T):
+        tiles = off + tl.arange(0, BLOCK_T)
+        mask = tiles[:, None] < tiles_per_row
+        offsets = tiles[:, None] * BLOCK_I + cols[None, :]
+        p = tl.load(base + offsets, mask=mask)
+        p = tl.where(mask, p, _identity_like(p, OP))
+        tl.store(base + offsets, _combine(carry[None, :], _scan_tile(p, OP), OP), mask=mask)
+        carry = _combine(carry, _reduce_tile(p, OP), OP)
+
+
+@triton.jit
+def scan_apply_kernel(
+    inp,
+    out,
+    partials,
+    L,
+    I,
+    tiles_per_row,
+    stride_o,
+    stride_l,
+    stride_i,
+    OP: tl.constexpr,
+    BLOCK_L: tl.constexpr,
+    BLOCK_I: tl.constexpr,
+):
+    """Multi-kernel scan, pass 3: scans tile t again, seeded with the inclusive prefix of tile t - 1.
+
+    With a single tile per row this is the whole scan, and partials is not read.
+    """
+    t = tl.program_id(0).to(tl.int64)
+    acc_ty = partials.dtype.element_ty
+    x = _load_tile(inp, t, L, I, tiles_per_row, stride_o, stride_l, stride_i, acc_ty, OP, BLOCK_L, BLOCK_I)
+    y = _scan_tile(x, OP)
+    if t % tiles_per_row != 0:
+        prefix = tl.load(partials + (t - 1) * BLOCK_I + tl.arange(0, BLOCK_I))
+        y = _combine(prefix[None, :], y, OP)
+    _store_tile(out, t, L, I, tiles_per_row, y, BLOCK_L, BLOCK_I)
+
+
+def cumsum(x):
+    """Scan along the last dim of a contiguous 2-D tensor, with look-back."""
+    M, L = x.shape
+    BLOCK_L = 2048
+    tiles_per_row = triton.cdiv(L, BLOCK_L)
+    num_tiles = M * tiles_per_row
+    out = torch.empty_like(x)
+    flags = torch.zeros(num_tiles + 1, device=x.device, dtype=torch.int32)
+    partials = torch.empty(2 * num_tiles, device=x.device, dtype=torch.float32)
+    with torch.cuda.device(x.device):
+        scan_lookback_kernel[(num_tiles,)](
+            x,
+            out,
+            flags,
+            partials,
+            L,
+            1,
+            tiles_per_row,
+            num_tiles,
+            1,
+            L,
+            1,
+            0,
+            OP=0,
+            BLOCK_L=BLOCK_L,
+            BLOCK_I=1,
+        )
+    return out
+
+
+if __name__ == "__main__":
+    x = torch.randn(8, 100000, device="cuda")
+    torch.testing.assert_close(cumsum(x), torch.cumsum(x, 1), atol=1e-2, rtol=1e-3)
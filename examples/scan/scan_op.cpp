@@ -0,0 +1,235 @@
+#include "scan_op.h"
+#include "common/backend_ops.h"
+#include "common/kernel_config.h"
+#include "common/op_registration.h"
+#include "triton_jit/triton_jit_function.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <utility>
+#include "ATen/native/ReduceOpsUtils.h"
+
+namespace my_ops {
+using namespace triton_jit;
+
+namespace {
+
+// epochs are stored as 2 * epoch + 1 in int32 flags
+constexpr int32_t kMaxEpoch = (std::numeric_limits<int32_t>::max() - 1) / 2;
+
+int64_t next_power_of_2(int64_t n) {
+  int64_t p = 1;
+  while (p < n) {
+    p *= 2;
+  }
+  return p;
+}
+
+int64_t cdiv(int64_t a, int64_t b) {
+  return (a + b - 1) / b;
+}
+
+// Scratch of one scan launch: look-back flags and the tile partials
+struct ScanWorkspace {
+  at::Tensor flags;     // int32 [1 + tiles], entry 0 is the tile counter
+  at::Tensor partials;  // accumulator dtype
+  int32_t epoch = 0;
+};
+
+/**
+ * Flags and partials are pooled per device and stream, so a scan does not
+ * allocate or clear memory once the pool has grown. Launches on one stream run
+ * in order, and a launch only matches flags tagged with its own epoch, so flags
+ * left by earlier launches never need clearing; they are zeroed only when the
+ * buffer grows or the epoch wraps.
+ */
+ScanWorkspace acquire_workspace(const at::Device& device,
+                                triton_jit::ops::RawStream stream,
+                                int64_t num_tiles,
+                                int64_t num_partials,
+                                at::ScalarType acc_dtype) {
+  static std::mutex mutex;
+  static std::map<std::pair<int, const void*>, ScanWorkspace> pool;
+  std::lock_guard<std::mutex> lock(mutex);
+  ScanWorkspace& ws = pool[{device.index(), reinterpret_cast<const void*>(stream)}];
+
+  if (!ws.flags.defined() || ws.flags.numel() < num_tiles + 1) {
+    ws.flags = triton_jit::ops::backend_empty({next_power_of_2(num_tiles + 1)}, at::kInt, device);
+    ws.flags.zero_();
+    ws.epoch = 0;
+  } else if (ws.epoch == kMaxEpoch) {
+    ws.flags.zero_();
+    ws.epoch = 0;
+  }
+  ws.epoch++;
+
+  const int64_t bytes = std::max<int64_t>(num_partials, 1) * at::elementSize(acc_dtype);
+  if (!ws.partials.defined() || ws.partials.numel() < bytes) {
+    ws.partials = triton_jit::ops::backend_empty({next_power_of_2(bytes)}, at::kByte, device);
+  }
+  ScanWorkspace out = ws;
+  out.partials = ws.partials.slice(0, 0, bytes).view(acc_dtype);
+  return out;
+}
+
+at::ScalarType scan_acc_dtype(at::ScalarType dtype) {
+  if (dtype == at::kDouble) {
+    return at::kDouble;
+  }
+  return at::isFloatingType(dtype) ? at::kFloat : at::kLong;
+}
+
+}  // namespace
+
+at::Tensor run_scan(
+    const at::Tensor& self, int64_t dim, ScanOp op, at::ScalarType out_dtype, bool single_pass) {
+  const int64_t ndim = std::max<int64_t>(self.dim(), 1);
+  dim = at::maybe_wrap_dim(dim, ndim);
+  at::Tensor out = triton_jit::ops::backend_empty(self.sizes(), out_dtype, self.device());
+  if (out.numel() == 0) {
+    return out;
+  }
+
+  // [outer, L, inner] view of the input, read through its strides when possible
+  at::Tensor in = self.dim() == 0 ? self.reshape({1}) : self;
+  std::optional<int64_t> stride_o = triton_jit::ops::merged_stride(in, 0, dim);
+  std::optional<int64_t> stride_i = triton_jit::ops::merged_stride(in, dim + 1, ndim);
+  if (!stride_o.has_value() || !stride_i.has_value()) {
+    in = in.contiguous();
+    stride_o = triton_jit::ops::merged_stride(in, 0, dim);
+    stride_i = triton_jit::ops::merged_stride(in, dim + 1, ndim);
+  }
+  const int64_t L = in.size(dim);
+  const int64_t I = c10::multiply_integers(in.sizes().slice(dim + 1));
+  const int64_t outer = c10::multiply_integers(in.sizes().slice(0, dim));
+  const int64_t stride_l = in.stride(dim);
+
+  constexpr auto cfg = triton_jit::ops::default_scan_config();
+  const int64_t block_i = std::min(next_power_of_2(I), cfg.max_block_i);
+  const int64_t block_l = std::min(next_power_of_2(L), std::max<int64_t>(1, cfg.tile_size / block_i));
+  const int64_t tiles_per_row = cdiv(L, block_l);
+  const int64_t num_groups = outer * cdiv(I, block_i);
+  const int64_t num_tiles = num_groups * tiles_per_row;
+  TORCH_CHECK(num_tiles < std::numeric_limits<int32_t>::max(), "scan: too many tiles, got ", num_tiles);
+
+  const at::ScalarType acc_dtype = scan_acc_dtype(self.scalar_type());
+  const int64_t op_code = static_cast<int64_t>(op);
+  const bool lookback = single_pass && tiles_per_row > 1;
+  const unsigned int grid = static_cast<unsigned int>(num_tiles);
+
+  c10::DeviceGuard guard(out.device());
+  triton_jit::ops::RawStream stream = triton_jit::ops::get_device_stream(in);
+  // look-back keeps aggregates and inclusive prefixes, the other paths one partial per tile
+  const int64_t num_partials = tiles_per_row == 1 ? 0 : (lookback ? 2 : 1) * num_tiles * block_i;
+  ScanWorkspace ws =
+      acquire_workspace(out.device(), stream, lookback ? num_tiles : 0, num_partials, acc_dtype);
+
+  if (lookback) {
+    const TritonJITFunction& f =
+        TritonJITFunction::get_instance(std::string("scan.py"), "scan_lookback_kernel");
+    f(stream,
+      grid,
+      1,
+      1,
+      cfg.num_warps,
+      cfg.num_stages,
+      in,
+      out,
+      ws.flags,
+      ws.partials,
+      L,
+      I,
+      tiles_per_row,
+      num_tiles,
+      ws.epoch,
+      stride_o.value(),
+      stride_l,
+      stride_i.value(),
+      op_code,
+      block_l,
+      block_i);
+    return out;
+  }
+
+  if (tiles_per_row > 1) {
+    const TritonJITFunction& reduce =
+        TritonJITFunction::get_instance(std::string("scan.py"), "scan_reduce_kernel");
+    reduce(stream,
+           grid,
+           1,
+           1,
+           cfg.num_warps,
+           cfg.num_stages,
+           in,
+           ws.partials,
+           L,
+           I,
+           tiles_per_row,
+           stride_o.value(),
+           stride_l,
+           stride_i.value(),
+           op_code,
+           block_l,
+           block_i);
+    const int64_t block_t =
+        std::min(next_power_of_2(tiles_per_row), std::max<int64_t>(1, cfg.tile_size / block_i));
+    const TritonJITFunction& partials =
+        TritonJITFunction::get_instance(std::string("scan.py"), "scan_partials_kernel");
+    partials(stream,
+             static_cast<unsigned int>(num_groups),
+             1,
+             1,
+             cfg.num_warps,
+             cfg.num_stages,
+             ws.partials,
+             tiles_per_row,
+             op_code,
+             block_t,
+             block_i);
+  }
+  const TritonJITFunction& apply =
+      TritonJITFunction::get_instance(std::string("scan.py"), "scan_apply_kernel");
+  apply(stream,
+        grid,
+        1,
+        1,
+        cfg.num_warps,
+        cfg.num_stages,
+        in,
+        out,
+        ws.partials,
+        L,
+        I,
+        tiles_per_row,
+        stride_o.value(),
+        stride_l,
+        stride_i.value(),
+        op_code,
+        block_l,
+        block_i);
+  return out;
+}
+
+at::Tensor cumsum(const at::Tensor& self, int64_t dim, std::optional<at::ScalarType> dtype) {
+  constexpr auto cfg = triton_jit::ops::default_scan_config();
+  at::ScalarType out_dtype = at::native::get_dtype_from_self(self, dtype, true);
+  return run_scan(self, dim, ScanOp::SUM, out_dtype, cfg.single_pass);
+}
+
+at::Tensor cumprod(const at::Tensor& self, int64_t dim, std::optional<at::ScalarType> dtype) {
+  constexpr auto cfg = triton_jit::ops::default_scan_config();
+  at::ScalarType out_dtype = at::native::get_dtype_from_self(self, dtype, true);
+  return run_scan(self, dim, ScanOp::PROD, out_dtype, cfg.single_pass);
+}
+
+TORCH_LIBRARY(scan_ops, m) {
+  m.def("cumsum(Tensor self, int dim, *, ScalarType? dtype=None) -> Tensor");
+  m.def("cumprod(Tensor self, int dim, *, ScalarType? dtype=None) -> Tensor");
+}
+
+REGISTER_TRITON_OP(scan_ops, "cumsum", cumsum)
+REGISTER_TRITON_OP(scan_ops, "cumprod", cumprod)
+
+}  // namespace my_ops
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include "torch/torch.h"
+
+namespace my_ops {
+
+// Kept in sync with the OP constexprs in scan.py
+enum class ScanOp : int64_t {
+  SUM = 0,
+  PROD = 1,
+};
+
+/**
+ * @brief Inclusive scan of `self` along `dim` into a new tensor of `out_dtype`
+ *
+ * The dims before and after `dim` are read through their strides when they can
+ * be merged into one, otherwise `self` is copied first. A row that fits in one
+ * tile is scanned by a single kernel. Longer rows use the decoupled look-back
+ * kernel if `single_pass` is set, or a reduce, scan, apply sequence of three
+ * kernels otherwise.
+ */
+at::Tensor run_scan(
+    const at::Tensor& self, int64_t dim, ScanOp op, at::ScalarType out_dtype, bool single_pass);
+
+at::Tensor cumsum(const at::Tensor& self, int64_t dim, std::optional<at::ScalarType> dtype);
+
+at::Tensor cumprod(const at::Tensor& self, int64_t dim, std::optional<at::ScalarType> dtype);
+
+}  // namespace my_ops
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include "scan_op.h"
+#include "torch/torch.h"
+#include "triton_jit/backend_config.h"
+
+static at::Device test_device() {
+#if defined(BACKEND_NPU)
+  return at::Device("npu:0");
+#elif defined(BACKEND_MUSA)
+  return at::Device("musa:0");
+#elif defined(BACKEND_INTERPRETER)
+  return at::kCPU;
+#else
+  return at::kCUDA;
+#endif
+}
+
+TEST(scan_test, long_rows_both_paths) {
+  at::Tensor t = at::rand({4, 300000}, test_device());
+  at::Tensor expected = at::cumsum(t.to(at::kDouble), 1).to(at::kFloat);
+  for (bool single_pass : {true, false}) {
+    at::Tensor out = my_ops::run_scan(t, 1, my_ops::ScanOp::SUM, at::kFloat, single_pass);
+    EXPECT_TRUE(torch::allclose(out, expected, 1e-4, 1e-3)) << "single_pass=" << single_pass;
+  }
+  // the pooled flags are reused by the next launch without being cleared
+  at::Tensor again = my_ops::cumsum(t, -1, std::nullopt);
+  EXPECT_TRUE(torch::allclose(again, expected, 1e-4, 1e-3));
+}
+
+TEST(scan_test, strided_outer_and_inner_dims) {
+  // scan along the middle dim of a permuted view, with a non-unit inner stride
+  at::Tensor base = at::randn({40, 6, 5000}, test_device());
+  at::Tensor t = base.permute({1, 2, 0});
+  at::Tensor expected = at::cumsum(t, 1);
+  for (bool single_pass : {true, false}) {
+    at::Tensor out = my_ops::run_scan(t, 1, my_ops::ScanOp::SUM, at::kFloat, single_pass);
+    EXPECT_TRUE(torch::allclose(out, expected, 1e-4, 1e-3)) << "single_pass=" << single_pass;
+  }
+}
+
+TEST(scan_test, cumprod) {
+  at::Tensor t = at::rand({3, 7000}, test_device()) * 0.02 + 0.995;
+  at::Tensor expected = at::cumprod(t.to(at::kDouble), 1).to(at::kFloat);
+  for (bool single_pass : {true, false}) {
+    at::Tensor out = my_ops::run_scan(t, 1, my_ops::ScanOp::PROD, at::kFloat, single_pass);
+    EXPECT_TRUE(torch::allclose(out, expected, 1e-4, 1e-6)) << "single_pass=" << single_pass;
+  }
+}
+
+TEST(scan_test, integer_and_half_inputs) {
+  at::Tensor ints = at::randint(-5, 5, {10, 9000}, at::TensorOptions().dtype(at::kInt).device(test_device()));
+  at::Tensor sum = my_ops::cumsum(ints, 1, std::nullopt);
+  EXPECT_EQ(sum.scalar_type(), at::kLong);
+  EXPECT_TRUE(torch::equal(sum, at::cumsum(ints, 1)));
+
+  at::Tensor half = at::rand({2, 100}, at::TensorOptions().dtype(at::kHalf).device(test_device()));
+  at::Tensor out = my_ops::cumsum(half, 0, at::kFloat);
+  EXPECT_TRUE(torch::allclose(out, at::cumsum(half.to(at::kFloat), 0), 1e-5, 1e-5));
+}
@@ -0,0 +1,47 @@
+#include <chrono>
+#include <iostream>
+#include "common/backend_ops.h"
+#include "softmax_op.h"
+#include "torch/torch.h"
+
+// Times my_ops::softmax against at::softmax over a sweep of row lengths,
+// covering both the single-tile and the online kernel.
+static at::Device bench_device() {
+#if defined(BACKEND_NPU)
+  return at::Device("npu:0");
+#elif defined(BACKEND_MUSA)
+  return at::Device("musa:0");
+#elif defined(BACKEND_INTERPRETER)
+  return at::kCPU;
+#else
+  return at::kCUDA;
+#endif
+}
+
+template <typename F>
+static double time_us(F&& fn, const at::Device& device, int iters) {
+  for (int i = 0; i < 3; i++) fn();
+  triton_jit::ops::device_synchronize(device);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iters; i++) fn();
+  triton_jit::ops::device_synchronize(device);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() / iters;
+}
+
+int main() {
+  const at::Device device = bench_device();
+  constexpr int64_t total = int64_t(1) << 24;
+  constexpr int iters = 50;
+  std::cout << "dtype,rows,cols,triton_us,aten_us\n";
+  for (at::ScalarType dtype : {at::kFloat, at::kHalf, at::kBFloat16}) {
+    for (int64_t n = 128; n <= (int64_t(1) << 18); n *= 4) {
+      at::Tensor x = at::randn({total / n, n}, at::TensorOptions().dtype(dtype).device(device));
+      double triton_us = time_us([&]() { my_ops::softmax(x, -1, false); }, device, iters);
+      double aten_us = time_us([&]() { at::softmax(x, -1); }, device, iters);
+      std::cout << c10::toString(dtype) << "," << total / n << "," << n << "," << triton_us << "," << aten_us
+                << "\n";
+    }
+  }
+  return 0;
+}
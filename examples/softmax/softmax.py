@@ -0,0 +1,115 @@
+import torch
+import triton
+from triton import language as tl
+
+
+@triton.jit
+def softmax_one_tile_kernel(
+    X,
+    Y,
+    M,
+    N,
+    K,
+    x_stride_m,
+    x_stride_n,
+    x_stride_k,
+    TILE_N: tl.constexpr,
+    TILE_K: tl.constexpr,
+):
+    """Softmax over axis n of an (M, N, K) view, the whole row in one tile.
+
+    X is read through its strides, Y is dense. Programs loop over the
+    (m, column tile) tasks, so the grid stays within the backend's x limit.
+    """
+    k_tiles = tl.cdiv(K, TILE_K)
+    for task in range(tl.program_id(0), M * k_tiles, tl.num_programs(0)):
+        pid_m = (task // k_tiles).to(tl.int64)
+        pid_k = task % k_tiles
+        n = tl.arange(0, TILE_N)
+        k = pid_k * TILE_K + tl.arange(0, TILE_K)
+        mask = (n < N)[:, None] & (k < K)[None, :]
+
+        x_offsets = pid_m * x_stride_m + n[:, None] * x_stride_n + k[None, :] * x_stride_k
+        x = tl.load(X + x_offsets, mask=mask, other=-float("inf")).to(tl.float32)
+        m = tl.max(x, axis=0)
+        e = tl.exp(x - m[None, :])
+        z = tl.sum(e, axis=0)
+        y = e / z[None, :]
+        y_offsets = pid_m * N * K + n[:, None] * K + k[None, :]
+        tl.store(Y + y_offsets, y.to(Y.dtype.element_ty), mask=mask)
+
+
+@triton.jit
+def softmax_online_kernel(
+    X,
+    Y,
+    M,
+    N,
+    K,
+    x_stride_m,
+    x_stride_n,
+    x_stride_k,
+    TILE_N: tl.constexpr,
+    TILE_K: tl.constexpr,
+):
+    """Softmax over axis n of an (M, N, K) view for rows longer than one tile.
+
+    The first loop keeps a running max and a rescaled running sum (online
+    softmax), the second loop writes the normalized output.
+    """
+    k_tiles = tl.cdiv(K, TILE_K)
+    for task in range(tl.program_id(0), M * k_tiles, tl.num_programs(0)):
+        pid_m = (task // k_tiles).to(tl.int64)
+        pid_k = task % k_tiles
+        k = pid_k * TILE_K + tl.arange(0, TILE_K)
+        k_mask = k < K
+        x_row = X + pid_m * x_stride_m
+        y_row = Y + pid_m * N * K
+
+        m = tl.full([TILE_K], -float("inf"), dtype=tl.float32)
+        z = tl.zeros([TILE_K], dtype=tl.float32)
+        for start in range(0, N, TILE_N):
+            n = start + tl.arange(0, TILE_N)
+            offsets = n[:, None] * x_stride_n + k[None, :] * x_stride_k
+            mask = (n < N)[:, None] & k_mask[None, :]
+            x = tl.load(x_row + offsets, mask=mask, other=-float("inf")).to(tl.float32)
+            new_m = tl.maximum(m, tl.max(x, axis=0))
+            # while a row has only seen -inf, -inf - -inf is nan: keep z at 0 instead
+            seen = new_m != -float("inf")
+            alpha = tl.where(seen, tl.exp(m - new_m), 0.0)
+            e = tl.where(seen[None, :], tl.exp(x - new_m[None, :]), 0.0)
+            z = z * alpha + tl.sum(e, axis=0)
+            m = new_m
+
+        for start in range(0, N, TILE_N):
+            n = start + tl.arange(0, TILE_N)
+            offsets = n[:, None] * x_stride_n + k[None, :] * x_stride_k
+            mask = (n < N)[:, None] & k_mask[None, :]
+            x = tl.load(x_row + offsets, mask=mask, other=-float("inf")).to(tl.float32)
+            y = tl.exp(x - m[None, :]) / z[None, :]
+            tl.store(y_row + n[:, None] * K + k[None, :], y.to(Y.dtype.element_ty), mask=mask)
+
+
+def softmax(x, dim=-1):
+    dim = dim % x.ndim
+    x = x.contiguous()
+    N = x.shape[dim]
+    K = x.stride(dim)
+    M = x.numel() // (N * K)
+    y = torch.empty_like(x)
+    TILE_K = 1 if K == 1 else min(triton.next_power_of_2(K), 16)
+    TILE_N = triton.next_power_of_2(N)
+    grid = (M * triton.cdiv(K, TILE_K),)
+    with torch.cuda.device(x.device):
+        if TILE_N * TILE_K <= 4096:
+            softmax_one_tile_kernel[grid](x, y, M, N, K, N * K, K, 1, TILE_N=TILE_N, TILE_K=TILE_K)
+        else:
+            TILE_N = max(4096 // TILE_K, 1)
+            softmax_online_kernel[grid](x, y, M, N, K, N * K, K, 1, TILE_N=TILE_N, TILE_K=TILE_K)
+    return y
+
+
+if __name__ == "__main__":
+    for shape, dim in [((64, 1000), -1), ((8, 100000), -1), ((16, 512, 33), 1)]:
+        x = torch.randn(shape, device="cuda", dtype=torch.float16)
+        torch.testing.assert_close(softmax(x, dim), torch.softmax(x.float(), dim).half())
@@ -0,0 +1,121 @@
+#include "softmax_op.h"
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include "ATen/WrapDimUtils.h"
+#include "common/backend_ops.h"
+#include "common/kernel_config.h"
+#include "common/op_registration.h"
+#include "triton_jit/kernel_registry.h"
+#include "triton_jit/triton_jit_function.h"
+
+namespace my_ops {
+using namespace triton_jit;
+
+struct SoftmaxLaunch {
+  int64_t tile_n;
+  int64_t tile_k;
+};
+
+// ints of the ArgClass: {size_class(N), size_class(K)}.
+// For a non-last dim, programs cover TILE_K adjacent columns for coalesced loads.
+static int64_t softmax_tile_k(const ArgClass& c) {
+  return std::min<int64_t>(int64_t(1) << c.ints[1], 16);
+}
+
+// Rows of up to max_tile_n elements stay in registers, longer rows use the online kernel.
+static const KernelRegistry<SoftmaxLaunch>& softmax_registry() {
+  static KernelRegistry<SoftmaxLaunch> registry("softmax");
+  static const bool registered = [] {
+    constexpr int64_t max_tile_n = triton_jit::ops::default_softmax_config().max_tile_n;
+    registry
+        .add(
+            "one_tile",
+            "softmax.py",
+            "softmax_one_tile_kernel",
+            10,
+            [](const ArgClass& c) { return (int64_t(1) << c.ints[0]) * softmax_tile_k(c) <= max_tile_n; },
+            [](const ArgClass& c) { return SoftmaxLaunch {int64_t(1) << c.ints[0], softmax_tile_k(c)}; })
+        .add("online", "softmax.py", "softmax_online_kernel", 0, nullptr, [](const ArgClass& c) {
+          const int64_t tile_k = softmax_tile_k(c);
+          return SoftmaxLaunch {std::max<int64_t>(max_tile_n / tile_k, 1), tile_k};
+        });
+    return true;
+  }();
+  (void)registered;
+  return registry;
+}
+
+at::Tensor softmax(const at::Tensor& self, int64_t dim, bool half_to_float) {
+  TORCH_CHECK(self.scalar_type() == at::kFloat || self.scalar_type() == at::kHalf ||
+                  self.scalar_type() == at::kBFloat16,
+              "softmax: expected a floating point tensor, got ",
+              self.scalar_type());
+  TORCH_CHECK(!half_to_float || self.scalar_type() == at::kHalf,
+              "softmax: half_to_float requires a half input");
+  at::ScalarType out_dtype = half_to_float ? at::kFloat : self.scalar_type();
+  at::Tensor out = triton_jit::ops::backend_empty(self.sizes(), out_dtype, self.device());
+  if (self.numel() == 0) {
+    return out;
+  }
+  if (self.dim() == 0) {
+    return out.fill_(1);
+  }
+
+  // View the input as (M, N, K) with N the softmax dim and read it through its
+  // strides, so neither a non-last dim nor a strided view is permuted or copied.
+  // Only inputs whose outer or inner dims cannot be merged into one are copied.
+  dim = at::maybe_wrap_dim(dim, self.dim());
+  at::Tensor x = self;
+  std::optional<int64_t> stride_m = triton_jit::ops::merged_stride(x, 0, dim);
+  std::optional<int64_t> stride_k = triton_jit::ops::merged_stride(x, dim + 1, x.dim());
+  if (!stride_m.has_value() || !stride_k.has_value()) {
+    x = x.contiguous();
+    stride_m = triton_jit::ops::merged_stride(x, 0, dim);
+    stride_k = triton_jit::ops::merged_stride(x, dim + 1, x.dim());
+  }
+  const int64_t N = x.size(dim);
+  const int64_t K = c10::multiply_integers(x.sizes().slice(dim + 1));
+  const int64_t M = c10::multiply_integers(x.sizes().slice(0, dim));
+
+  constexpr auto cfg = triton_jit::ops::default_softmax_config();
+  const auto sel = softmax_registry().select({x}, {size_class(N), size_class(K)});
+  const TritonJITFunction& f = sel.function;
+  const int64_t tile_n = sel.config.tile_n;
+  const int64_t tile_k = sel.config.tile_k;
+
+  c10::DeviceGuard guard(out.device());
+  triton_jit::ops::RawStream stream = triton_jit::ops::get_device_stream(x);
+
+  // (row, column tile) tasks are folded into grid x and looped over inside the
+  // kernel, so a long inner dim is not bounded by the grid y limit
+  const int64_t num_tasks = M * ((K + tile_k - 1) / tile_k);
+  const auto grid_tasks =
+      static_cast<unsigned int>(std::min<int64_t>(num_tasks, std::numeric_limits<int32_t>::max()));
+  const unsigned int num_blocks = triton_jit::ops::plan_num_blocks(grid_tasks, "aiv");
+  f(stream,
+    num_blocks,
+    1,
+    1,
+    cfg.num_warps,
+    cfg.num_stages,
+    x,
+    out,
+    M,
+    N,
+    K,
+    stride_m.value(),
+    x.stride(dim),
+    stride_k.value(),
+    tile_n,
+    tile_k);
+  return out;
+}
+
+TORCH_LIBRARY(softmax_ops, m) {
+  m.def("softmax(Tensor self, int dim, bool half_to_float=False) -> Tensor");
+}
+
+REGISTER_TRITON_OP(softmax_ops, "softmax", softmax)
+
+}  // namespace my_ops
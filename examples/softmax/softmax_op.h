@@ -0,0 +1,9 @@
+#pragma once
+
+#include "torch/torch.h"
+
+namespace my_ops {
+
+at::Tensor softmax(const at::Tensor& self, int64_t dim, bool half_to_float);
+
+}  // namespace my_ops
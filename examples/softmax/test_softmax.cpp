@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include "softmax_op.h"
+#include "torch/torch.h"
+#include "triton_jit/backend_config.h"
+
+static at::Device test_device() {
+#if defined(BACKEND_NPU)
+  return at::Device("npu:0");
+#elif defined(BACKEND_MUSA)
+  return at::Device("musa:0");
+#elif defined(BACKEND_INTERPRETER)
+  return at::kCPU;
+#else
+  return at::kCUDA;
+#endif
+}
+
+TEST(softmax_test, last_dim_one_tile) {
+  at::Tensor x = at::randn({64, 1000}, test_device());
+  at::Tensor result = my_ops::softmax(x, -1, false);
+  EXPECT_TRUE(torch::allclose(result, at::softmax(x, -1), 1e-5, 1e-6));
+}
+
+TEST(softmax_test, last_dim_online) {
+  at::TensorOptions opts = at::TensorOptions().dtype(at::kHalf).device(test_device());
+  at::Tensor x = at::randn({8, 50000}, opts);
+  at::Tensor result = my_ops::softmax(x, -1, true);
+  EXPECT_EQ(result.scalar_type(), at::kFloat);
+  EXPECT_TRUE(torch::allclose(result, at::softmax(x.to(at::kFloat), -1), 1e-3, 1e-5));
+}
+
+TEST(softmax_test, inner_dim_bf16) {
+  at::TensorOptions opts = at::TensorOptions().dtype(at::kBFloat16).device(test_device());
+  at::Tensor x = at::randn({4, 300, 33}, opts);
+  at::Tensor result = my_ops::softmax(x, 1, false);
+  at::Tensor expected = at::softmax(x.to(at::kFloat), 1).to(at::kBFloat16);
+  EXPECT_TRUE(torch::allclose(result.to(at::kFloat), expected.to(at::kFloat), 1e-2, 1e-3));
+}
+
+TEST(softmax_test, strided_views_are_not_copied) {
+  // softmax dim with a non-unit stride, and a column slice with a row stride
+  at::Tensor t = at::randn({50, 20}, test_device()).t();
+  EXPECT_TRUE(torch::allclose(my_ops::softmax(t, -1, false), at::softmax(t, -1), 1e-5, 1e-6));
+  at::Tensor slice = at::randn({16, 2000}, test_device()).slice(1, 0, 1500);
+  EXPECT_TRUE(torch::allclose(my_ops::softmax(slice, 1, false), at::softmax(slice, 1), 1e-5, 1e-6));
+}
+
+TEST(softmax_test, long_inner_dim) {
+  // more column tiles than grid y allows (65535 * tile_k)
+  at::Tensor x = at::randn({3, 1100000}, test_device());
+  at::Tensor result = my_ops::softmax(x, 0, false);
+  EXPECT_TRUE(torch::allclose(result, at::softmax(x, 0), 1e-5, 1e-6));
+}
+
+TEST(softmax_test, online_leading_tile_all_masked) {
+  // rows longer than one tile whose first tile is all -inf, like left-padded attention rows
+  at::Tensor x = at::randn({4, 50000}, test_device());
+  x.slice(1, 0, 20000).fill_(-std::numeric_limits<float>::infinity());
+  at::Tensor result = my_ops::softmax(x, -1, false);
+  EXPECT_FALSE(result.isnan().any().item<bool>());
+  EXPECT_TRUE(torch::allclose(result, at::softmax(x, -1), 1e-5, 1e-6));
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "torch/torch.h"
+#include "triton_jit/backend_config.h"
+#include "triton_jit/runtime_metrics.h"
+#include "tuned_op.h"
+
+static at::Device test_device() {
+#if defined(BACKEND_NPU)
+  return at::Device("npu:0");
+#elif defined(BACKEND_MUSA)
+  return at::Device("musa:0");
+#elif defined(BACKEND_INTERPRETER)
+  return at::kCPU;
+#else
+  return at::kCUDA;
+#endif
+}
+
+static uint64_t benchmarked_configs() {
+  return triton_jit::RuntimeMetrics::instance().counter("autotune/benchmarked_configs");
+}
+
+TEST(tuned_test, row_sum_tunes_once_per_key) {
+  // the output is accumulated with atomics and reset_to_zero between configs, so a
+  // reset that is not ordered with the benchmark launches shows up in the result
+  at::Tensor x = at::randn({64, 5000}, test_device());
+  uint64_t before = benchmarked_configs();
+  at::Tensor out = my_ops::row_sum(x);
+  EXPECT_TRUE(torch::allclose(out, x.sum(1), 1e-4, 1e-3));
+#if !defined(BACKEND_INTERPRETER)
+  EXPECT_EQ(benchmarked_configs(), before + 3);
+#endif
+
+  // same key (N): cached, and the output of the tuned launch is not polluted by the benchmark
+  at::Tensor y = at::randn({7, 5000}, test_device());
+  uint64_t tuned = benchmarked_configs();
+  EXPECT_TRUE(torch::allclose(my_ops::row_sum(y), y.sum(1), 1e-4, 1e-3));
+  EXPECT_EQ(benchmarked_configs(), tuned);
+}
+
+TEST(tuned_test, row_sum_strided_half) {
+  at::TensorOptions opts = at::TensorOptions().dtype(at::kHalf).device(test_device());
+  at::Tensor x = at::randn({300, 40}, opts).t();
+  at::Tensor out = my_ops::row_sum(x);
+  EXPECT_EQ(out.scalar_type(), at::kFloat);
+  EXPECT_TRUE(torch::allclose(out, x.to(at::kFloat).sum(1), 1e-3, 1e-3));
+}
+
+TEST(tuned_test, scale_heuristics) {
+  // a multiple of the block (no mask), a ragged tail, and a strided input
+  for (int64_t n : {4096, 1000, 3}) {
+    at::Tensor x = at::randn({n}, test_device());
+    EXPECT_TRUE(torch::allclose(my_ops::scale(x, 0.5), x * 0.5));
+  }
+  at::Tensor strided = at::randn({2000}, test_device()).slice(0, 0, 2000, 2);
+  EXPECT_TRUE(torch::allclose(my_ops::scale(strided, -2.0), strided * -2.0));
+
+  at::Tensor half = at::randn({777}, at::TensorOptions().dtype(at::kHalf).device(test_device()));
+  at::Tensor out = my_ops::scale(half, 3.0);
+  EXPECT_EQ(out.scalar_type(), at::kHalf);
+  EXPECT_TRUE(torch::allclose(out, half * 3.0, 1e-3, 1e-3));
+}
@@ -0,0 +1,61 @@
+import triton
+from triton import language as tl
+
+
+@triton.autotune(
+    configs=[
+        triton.Config({"BLOCK_N": 256}, num_warps=2),
+        triton.Config({"BLOCK_N": 1024}, num_warps=4),
+        triton.Config({"BLOCK_N": 4096}, num_warps=8),
+    ],
+    key=["N"],
+    reset_to_zero=["Y"],
+)
+@triton.jit
+def row_sum_kernel(X, Y, M, N, stride_m, stride_n, BLOCK_N: tl.constexpr):
+    """Y[m] += sum(X[m, :]) in fp32; every program adds one BLOCK_N chunk of a row, so Y must start at zero"""
+    pid = tl.program_id(0)
+    num_chunks = tl.cdiv(N, BLOCK_N)
+    pid_m = pid // num_chunks
+    offs = (pid % num_chunks) * BLOCK_N + tl.arange(0, BLOCK_N)
+    x = tl.load(X + pid_m * stride_m + offs * stride_n, mask=offs < N, other=0.0).to(tl.float32)
+    tl.atomic_add(Y + pid_m, tl.sum(x, axis=0))
+
+
+# the outer heuristics run first, so the inner ones can read BLOCK_N
+@triton.heuristics(
+    {
+        "BLOCK_N": lambda args: min(triton.next_power_of_2(args["N"]), 1024),
+        "num_warps": lambda args: 8 if args["BLOCK_N"] >= 1024 else 4,
+    }
+)
+@triton.heuristics(
+    {
+        "EVEN_N": lambda args: args["N"] % args["BLOCK_N"] == 0,
+        "UNIT_STRIDE": lambda args: args["X"].stride(0) == 1,
+    }
+)
+@triton.jit
+def scale_kernel(
+    X,
+    Y,
+    N,
+    stride_x,
+    alpha,
+    BLOCK_N: tl.constexpr,
+    EVEN_N: tl.constexpr,
+    UNIT_STRIDE: tl.constexpr,
+):
+    """Y = X * alpha over a 1D tensor; the block size, masking and stride handling come from the heuristics"""
+    offs = tl.program_id(0) * BLOCK_N + tl.arange(0, BLOCK_N)
+    if UNIT_STRIDE:
+        x_ptrs = X + offs
+    else:
+        x_ptrs = X + offs * stride_x
+    if EVEN_N:
+        x = tl.load(x_ptrs)
+        tl.store(Y + offs, x * alpha)
+    else:
+        mask = offs < N
+        x = tl.load(x_ptrs, mask=mask)
+        tl.store(Y + offs, x * alpha, mask=mask)
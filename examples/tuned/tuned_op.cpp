@@ -0,0 +1,65 @@
+#include "tuned_op.h"
+#include "common/backend_ops.h"
+#include "common/op_registration.h"
+#include "triton_jit/triton_jit_function.h"
+
+#include <array>
+#include <limits>
+
+namespace my_ops {
+using namespace triton_jit;
+
+at::Tensor row_sum(const at::Tensor& input) {
+  TORCH_CHECK(input.dim() == 2, "row_sum: expected a 2D input, got ", input.dim(), " dims");
+  TORCH_CHECK(at::isFloatingType(input.scalar_type()),
+              "row_sum: expected a floating point input, got ",
+              input.scalar_type());
+  const int64_t M = input.size(0);
+  const int64_t N = input.size(1);
+  // rows are accumulated with atomics, so the output starts at zero
+  at::Tensor out = at::zeros({M}, input.options().dtype(at::kFloat));
+  if (M == 0 || N == 0) {
+    return out;
+  }
+
+  const TritonJITFunction& f = TritonJITFunction::get_instance(std::string("tuned.py"), "row_sum_kernel");
+  c10::DeviceGuard guard(out.device());
+  triton_jit::ops::RawStream stream = triton_jit::ops::get_device_stream(input);
+  auto grid = [M, N](const KernelConfig& config) {
+    const int64_t block_n = config.get("BLOCK_N");
+    const int64_t num_programs = M * ((N + block_n - 1) / block_n);
+    TORCH_CHECK(num_programs <= std::numeric_limits<int32_t>::max(), "row_sum: input is too large");
+    return std::array<unsigned int, 3> {static_cast<unsigned int>(num_programs), 1, 1};
+  };
+  f.launch_tuned(stream, grid, input, out, M, N, input.stride(0), input.stride(1));
+  return out;
+}
+
+at::Tensor scale(const at::Tensor& input, double alpha) {
+  TORCH_CHECK(input.dim() == 1, "scale: expected a 1D input, got ", input.dim(), " dims");
+  const int64_t N = input.size(0);
+  at::Tensor out = triton_jit::ops::backend_empty({N}, input.scalar_type(), input.device());
+  if (N == 0) {
+    return out;
+  }
+
+  const TritonJITFunction& f = TritonJITFunction::get_instance(std::string("tuned.py"), "scale_kernel");
+  c10::DeviceGuard guard(out.device());
+  triton_jit::ops::RawStream stream = triton_jit::ops::get_device_stream(input);
+  auto grid = [N](const KernelConfig& config) {
+    const int64_t block_n = config.get("BLOCK_N");
+    return std::array<unsigned int, 3> {static_cast<unsigned int>((N + block_n - 1) / block_n), 1, 1};
+  };
+  f.launch_tuned(stream, grid, input, out, N, input.stride(0), static_cast<float>(alpha));
+  return out;
+}
+
+TORCH_LIBRARY(tuned_ops, m) {
+  m.def("row_sum(Tensor input) -> Tensor");
+  m.def("scale(Tensor input, float alpha) -> Tensor");
+}
+
+REGISTER_TRITON_OP(tuned_ops, "row_sum", row_sum)
+REGISTER_TRITON_OP(tuned_ops, "scale", scale)
+
+}  // namespace my_ops
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "torch/torch.h"
+
+namespace my_ops {
+
+/**
+ * @brief Sum over the last dim of a 2D tensor, in float32
+ *
+ * The kernel is decorated with @triton.autotune: the first call with a new row
+ * length benchmarks the block sizes, later calls reuse the fastest one.
+ */
+at::Tensor row_sum(const at::Tensor& input);
+
+/**
+ * @brief input * alpha over a 1D tensor
+ *
+ * The kernel is decorated with @triton.heuristics: the block size, the number
+ * of warps, and whether the tail needs a mask or the input a stride are derived
+ * from the arguments on the first call with a new argument description.
+ */
+at::Tensor scale(const at::Tensor& input, double alpha);
+
+}  // namespace my_ops
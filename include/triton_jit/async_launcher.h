@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "triton_jit/backend_policy.h"
+#include "triton_jit/triton_jit_function.h"
+
+namespace triton_jit {
+
+/// A queued launch; records are linked intrusively into the submission queue
+struct LaunchRecord {
+  std::atomic<LaunchRecord*> next {nullptr};
+  int64_t submit_ns = 0;
+  std::promise<void> done;
+
+  virtual ~LaunchRecord() = default;
+  /// Runs on the launcher thread
+  virtual void launch() = 0;
+};
+
+/**
+ * @brief Launches JIT functions from a dedicated thread
+ *
+ * submit() copies the launch (function, stream, grid and arguments, with
+ * tensors held by reference count) and the caller's device context into a
+ * record, pushes it onto a lock-free multi-producer single-consumer queue and
+ * returns. The launcher thread builds the signature, looks up or compiles the
+ * overload and calls the driver, so the caller pays for one allocation and an
+ * atomic exchange instead.
+ *
+ * Records are launched one at a time in submission order, so launches
+ * submitted by one thread reach every stream in the order they were
+ * submitted. The returned future becomes ready once the launch has been
+ * enqueued on its stream (not when the kernel finishes), or holds the
+ * exception the launch threw.
+ *
+ * A function may be launched through a launcher and directly by other threads
+ * at the same time: its overload caches are synchronized, and kernels are
+ * compiled under the GIL, which the runtime releases after starting the
+ * interpreter. The launcher thread is pinned to the core given to the
+ * constructor; the shared instance() reads it from TRITON_JIT_LAUNCHER_CPU.
+ */
+class AsyncLauncher {
+ public:
+  /// Starts the launcher thread, pinned to `cpu` unless it is negative
+  explicit AsyncLauncher(int cpu = -1);
+  /// Launches everything submitted so far, then stops the thread
+  ~AsyncLauncher();
+
+  AsyncLauncher(const AsyncLauncher&) = delete;
+  AsyncLauncher& operator=(const AsyncLauncher&) = delete;
+
+  /// Process-wide launcher, started on first use
+  static AsyncLauncher& instance();
+
+  template <ContextBackend Backend, typename... Args>
+  std::future<void> submit(const TritonJITFunctionImpl<Backend>& function,
+                           typename Backend::StreamType stream,
+                           unsigned int grid_x,
+                           unsigned int grid_y,
+                           unsigned int grid_z,
+                           unsigned int num_warps,
+                           unsigned int num_stages,
+                           Args... args) {
+    auto* record = new JITLaunchRecord<Backend, Args...>(function,
+                                                         stream,
+                                                         Backend::get_current_context(),
+                                                         {grid_x, grid_y, grid_z},
+                                                         num_warps,
+                                                         num_stages,
+                                                         std::move(args)...);
+    std::future<void> future = record->done.get_future();
+    this->push(record);
+    return future;
+  }
+
+  /// Blocks until every launch submitted before the call has been issued
+  void flush();
+
+  /// Launches submitted and not yet issued
+  uint64_t pending() const;
+
+ private:
+  template <ContextBackend Backend, typename... Args>
+  struct JITLaunchRecord final : LaunchRecord {
+    const TritonJITFunctionImpl<Backend>& function;
+    typename Backend::StreamType stream;
+    typename Backend::ContextType context;
+    std::array<unsigned int, 3> grid;
+    unsigned int num_warps;
+    unsigned int num_stages;
+    std::tuple<std::decay_t<Args>...> args;
+
+    JITLaunchRecord(const TritonJITFunctionImpl<Backend>& function,
+                    typename Backend::StreamType stream,
+                    typename Backend::ContextType context,
+                    std::array<unsigned int, 3> grid,
+                    unsigned int num_warps,
+                    unsigned int num_stages,
+                    Args&&... args)
+        : function(function),
+          stream(stream),
+          context(context),
+          grid(grid),
+          num_warps(num_warps),
+          num_stages(num_stages),
+          args(std::move(args)...) {
+    }
+
+    void launch() override {
+      Backend::set_current_context(this->context);
+      std::apply(
+          [this](const auto&... a) {
+            this->function(this->stream,
+                           this->grid[0],
+                           this->grid[1],
+                           this->grid[2],
+                           this->num_warps,
+                           this->num_stages,
+                           a...);
+          },
+          this->args);
+    }
+  };
+
+  struct StopRecord final : LaunchRecord {
+    AsyncLauncher* launcher;
+    explicit StopRecord(AsyncLauncher* launcher) : launcher(launcher) {
+    }
+    void launch() override {
+      this->launcher->stopping_ = true;
+    }
+  };
+
+  /// Queue sentinel, never launched
+  struct StubRecord final : LaunchRecord {
+    void launch() override {
+    }
+  };
+
+  void push(LaunchRecord* record);
+  LaunchRecord* pop();
+  void run(int cpu);
+
+  // Vyukov's intrusive MPSC queue: producers exchange head_, the launcher thread owns tail_
+  std::atomic<LaunchRecord*> head_;
+  LaunchRecord* tail_;
+  StubRecord stub_;
+
+  /// Records pushed and records issued; the launcher thread sleeps on submitted_
+  std::atomic<uint64_t> submitted_ {0};
+  std::atomic<uint64_t> completed_ {0};
+  bool stopping_ = false;
+  std::thread thread_;
+};
+
+}  // namespace triton_jit
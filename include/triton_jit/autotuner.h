@@ -0,0 +1,246 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "c10/core/impl/VirtualGuardImpl.h"
+#include "c10/util/Logging.h"
+#include "fmt/core.h"
+#include "fmt/ranges.h"
+#include "torch/torch.h"
+#include "triton_jit/backend_policy.h"
+#include "triton_jit/jit_utils.h"
+
+namespace triton_jit {
+
+/**
+ * @brief Constexpr values and launch options chosen for a launch
+ *
+ * Holds the autotune config and the values computed by the heuristics. Passed
+ * to the grid callback of TritonJITFunctionImpl::launch_tuned, which reads the
+ * block sizes it needs with get().
+ */
+struct KernelConfig {
+  /// (parameter name, constexpr signature token)
+  std::vector<std::pair<std::string, std::string>> constexprs;
+  unsigned int num_warps = 4;
+  unsigned int num_stages = 3;
+
+  /// Integer (or boolean) value of a constexpr; throws std::runtime_error when it is not set
+  int64_t get(std::string_view name) const;
+
+  /// "BLOCK_M=64, BLOCK_N=128, num_warps=4, num_stages=3", for logging
+  std::string describe() const;
+};
+
+/**
+ * @brief Settings of a @triton.autotune decorator, extracted once per function
+ *
+ * Arguments are referred to by their index in the JIT function's parameter list.
+ */
+struct AutotuneSpec {
+  /// Parameters set by the configs, in the order of KernelConfig::constexprs
+  std::vector<int> tuned;
+  std::vector<KernelConfig> configs;
+  std::vector<int> key;
+  std::vector<int> reset_to_zero;
+  std::vector<int> restore_value;
+  int warmup_ms = 25;
+  int rep_ms = 100;
+  /// Decorator features the C++ runtime ignores, e.g. prune_configs_by
+  std::vector<std::string> unsupported;
+
+  /// Parse the json produced by gen_ssig.extract_autotune_spec; throws std::runtime_error
+  static AutotuneSpec from_json(const std::string& json);
+};
+
+/// A resolved launch: the chosen config and the full signature it compiles to
+struct TunedLaunch {
+  KernelConfig config;
+  std::string signature;
+};
+
+/// A value computed by a @triton.heuristics lambda
+struct HeuristicValue {
+  std::string name;
+  /// Index of the constexpr parameter it sets, -1 for a launch option (num_warps, num_stages)
+  int index = -1;
+};
+
+/**
+ * @brief Collects the autotune key, the tensors to reset or restore, and the
+ * argument description the heuristics are evaluated on, from the caller's arguments
+ *
+ * Walks the arguments like ArgHandle, skipping the parameters the runtime provides.
+ */
+struct TuningArgs {
+  /// nullptr when the function is not autotuned
+  const AutotuneSpec* spec;
+  const std::vector<bool>& provided;
+  /// Build `args` for the heuristics
+  bool describe;
+  std::string key;
+  /// json array with one entry per parameter, null for None and provided parameters
+  std::string args;
+  std::vector<at::Tensor> reset_to_zero;
+  std::vector<at::Tensor> restore_value;
+  int idx = 0;
+
+  template <typename T>
+  void handle_arg(const T& item) {
+    skip_provided();
+    if (spec != nullptr) {
+      if (contains(spec->key, idx)) {
+        key += ';';
+        append_key(item);
+      }
+      if constexpr (is_same_ignore_cvref<at::Tensor, T>::value) {
+        if (contains(spec->reset_to_zero, idx)) {
+          reset_to_zero.push_back(item);
+        }
+        if (contains(spec->restore_value, idx)) {
+          restore_value.push_back(item);
+        }
+      }
+    }
+    if (describe) {
+      args += args.empty() ? '[' : ',';
+      describe_arg(item);
+    }
+    idx++;
+  }
+
+  /// Account for provided parameters after the last argument
+  void finish() {
+    skip_provided();
+    if (describe) {
+      args += args.empty() ? "[]" : "]";
+    }
+  }
+
+ private:
+  static bool contains(const std::vector<int>& indices, int i) {
+    return std::find(indices.begin(), indices.end(), i) != indices.end();
+  }
+
+  void skip_provided() {
+    while (idx < static_cast<int>(provided.size()) && provided[idx]) {
+      if (describe) {
+        args += args.empty() ? "[null" : ",null";
+      }
+      idx++;
+    }
+  }
+
+  template <typename T>
+  void append_key(const T& item) {
+    if constexpr (is_optional<T>::value) {
+      if (item.has_value()) {
+        append_key(item.value());
+      } else {
+        key += "None";
+      }
+    } else if constexpr (is_same_ignore_cvref<at::Tensor, T>::value) {
+      key += fmt::format("{}{}", to_triton_typename(item.scalar_type()), fmt::join(item.sizes(), "x"));
+    } else if constexpr (is_same_ignore_cvref<c10::Scalar, T>::value) {
+      key += item.isIntegral(false) ? fmt::format("{}", item.toLong()) : fmt::format("{}", item.toDouble());
+    } else if constexpr (is_same_ignore_cvref<std::nullopt_t, T>::value ||
+                         is_same_ignore_cvref<std::nullptr_t, T>::value) {
+      key += "None";
+    } else {
+      key += fmt::format("{}", item);
+    }
+  }
+
+  /// Tensors are described by metadata only, with the address reduced to its alignment,
+  /// so that the description (and the memoized heuristics) is reused across allocations
+  template <typename T>
+  void describe_arg(const T& item) {
+    if constexpr (is_optional<T>::value) {
+      if (item.has_value()) {
+        describe_arg(item.value());
+      } else {
+        args += "null";
+      }
+    } else if constexpr (is_same_ignore_cvref<at::Tensor, T>::value) {
+      args += fmt::format(R"({{"dtype":"{}","shape":[{}],"stride":[{}],"data_ptr":{}}})",
+                          to_triton_typename(item.scalar_type()),
+                          fmt::join(item.sizes(), ","),
+                          fmt::join(item.strides(), ","),
+                          reinterpret_cast<std::uintptr_t>(item.data_ptr()) % 16);
+    } else if constexpr (is_same_ignore_cvref<c10::Scalar, T>::value) {
+      if (item.isBoolean()) {
+        args += item.toBool() ? "true" : "false";
+      } else if (item.isIntegral(false)) {
+        args += fmt::format("{}", item.toLong());
+      } else {
+        args += fmt::format("{}", item.toDouble());
+      }
+    } else if constexpr (is_same_ignore_cvref<std::nullopt_t, T>::value ||
+                         is_same_ignore_cvref<std::nullptr_t, T>::value) {
+      args += "null";
+    } else {
+      args += fmt::format("{}", item);
+    }
+  }
+};
+
+/// Block until torch's current stream of each tensor's device is idle, for copies made outside `stream`
+inline void synchronize_torch_streams(const std::vector<at::Tensor>& tensors) {
+  for (const at::Tensor& t : tensors) {
+    if (!t.is_cpu()) {
+      c10::impl::VirtualGuardImpl impl(t.device().type());
+      impl.getStream(t.device()).synchronize();
+    }
+  }
+}
+
+/// Block until an event has completed; event_query itself does not block
+template <BackendPolicy Backend>
+  requires EventBackend<Backend>
+void wait_event(typename Backend::EventType event) {
+  while (!Backend::event_query(event)) {
+    std::this_thread::yield();
+  }
+}
+
+/**
+ * @brief Mean device time of `run` in milliseconds, measured like triton.testing.do_bench
+ *
+ * A short estimate sizes the warmup and measurement loops to roughly
+ * `warmup_ms` and `rep_ms` of device time.
+ */
+template <BackendPolicy Backend, typename Run>
+  requires EventBackend<Backend>
+float benchmark_ms(typename Backend::StreamType stream, int warmup_ms, int rep_ms, Run&& run) {
+  typename Backend::EventType start = Backend::event_create();
+  typename Backend::EventType end = Backend::event_create();
+  auto time = [&](int n) {
+    Backend::event_record(start, stream);
+    for (int i = 0; i < n; i++) {
+      run();
+    }
+    Backend::event_record(end, stream);
+    wait_event<Backend>(end);
+    return Backend::event_elapsed_ms(start, end) / static_cast<float>(n);
+  };
+  try {
+    float estimate = std::max(time(5), 1e-3f);
+    time(std::max(1, static_cast<int>(static_cast<float>(warmup_ms) / estimate)));
+    float ms = time(std::max(1, static_cast<int>(static_cast<float>(rep_ms) / estimate)));
+    Backend::event_destroy(start);
+    Backend::event_destroy(end);
+    return ms;
+  } catch (...) {
+    Backend::event_destroy(start);
+    Backend::event_destroy(end);
+    throw;
+  }
+}
+
+}  // namespace triton_jit
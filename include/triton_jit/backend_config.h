@@ -6,6 +6,8 @@
 #include "triton_jit/backends/musa_backend.h"
 #elif defined(BACKEND_IX)
 #include "triton_jit/backends/ix_backend.h"
+#elif defined(BACKEND_INTERPRETER)
+#include "triton_jit/backends/interpreter_backend.h"
 #else
 #include "triton_jit/backends/cuda_backend.h"
 #endif
@@ -28,6 +30,10 @@ using DefaultBackend = CudaBackend;
 /// Default backend for IX (Tianshu)
 using DefaultBackend = IxBackend;
 
+#elif defined(BACKEND_INTERPRETER)
+/// Default backend for CPU-only runs through Triton's interpreter
+using DefaultBackend = InterpreterBackend;
+
 #else
 // Default to CUDA if no backend specified
 #warning "No backend specified, defaulting to CUDA. Use -DBACKEND=CUDA explicitly."
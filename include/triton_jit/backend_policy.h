@@ -47,4 +47,37 @@ concept BackendPolicy = requires {
   { T::prepare_launch(dir, name, shared_mem, sig, num_args) } -> std::same_as<typename T::LaunchOptions>;
 };
 
+/**
+ * Optional extension of BackendPolicy: device events for timing launches.
+ * event_query must not block; it returns true once the event has completed.
+ */
+template <typename T>
+concept EventBackend = BackendPolicy<T> && requires { typename T::EventType; } &&
+                       requires(typename T::EventType event, typename T::StreamType stream) {
+  { T::event_create() } -> std::same_as<typename T::EventType>;
+  { T::event_record(event, stream) } -> std::same_as<void>;
+  { T::event_query(event) } -> std::same_as<bool>;
+  { T::event_elapsed_ms(event, event) } -> std::same_as<float>;
+  { T::event_destroy(event) } -> std::same_as<void>;
+};
+
+/**
+ * Optional extension of BackendPolicy: fill device memory with zeros, ordered on
+ * a stream (used to reset autotune outputs on the benchmark stream).
+ */
+template <typename T>
+concept MemsetBackend = BackendPolicy<T> && requires(void* ptr, size_t bytes, typename T::StreamType stream) {
+  { T::memset_zero_async(ptr, bytes, stream) } -> std::same_as<void>;
+};
+
+/**
+ * Optional extension of BackendPolicy: the calling thread's device context can
+ * be captured and made current on another thread (used by AsyncLauncher).
+ */
+template <typename T>
+concept ContextBackend = BackendPolicy<T> && requires(typename T::ContextType ctx) {
+  { T::get_current_context() } -> std::same_as<typename T::ContextType>;
+  { T::set_current_context(ctx) } -> std::same_as<void>;
+};
+
 }  // namespace triton_jit
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cuda.h>
+#include <string>
+
+#include "c10/util/Logging.h"
+#include "fmt/core.h"
+#include "triton_jit/function_attributes.h"
+#include "triton_jit/jit_utils.h"
+
+namespace triton_jit {
+
+/**
+ * @brief Applies the driver-API function attributes shared by the CUDA-compatible backends
+ *
+ * Handles cache_preference, shared_carveout and max_dynamic_shared_bytes;
+ * non_portable_cluster_size_allowed depends on the device and is left to the backend.
+ */
+inline void apply_cu_function_attributes(CUfunction kernel,
+                                         CUdevice device,
+                                         const std::string& kernel_name,
+                                         unsigned int required_shared,
+                                         const FunctionAttributes& attrs) {
+  if (attrs.cache_preference) {
+    CUfunc_cache config = CU_FUNC_CACHE_PREFER_NONE;
+    switch (*attrs.cache_preference) {
+      case CachePreference::NONE:
+        config = CU_FUNC_CACHE_PREFER_NONE;
+        break;
+      case CachePreference::PREFER_SHARED:
+        config = CU_FUNC_CACHE_PREFER_SHARED;
+        break;
+      case CachePreference::PREFER_L1:
+        config = CU_FUNC_CACHE_PREFER_L1;
+        break;
+      case CachePreference::PREFER_EQUAL:
+        config = CU_FUNC_CACHE_PREFER_EQUAL;
+        break;
+    }
+    checkCudaErrors(cuFuncSetCacheConfig(kernel, config));
+    LOG(INFO) << fmt::format(
+        "{}: set cache_preference={}", kernel_name, cache_preference_name(*attrs.cache_preference));
+  }
+  if (attrs.shared_carveout) {
+    checkCudaErrors(cuFuncSetAttribute(kernel,
+                                       CU_FUNC_ATTRIBUTE_PREFERRED_SHARED_MEMORY_CARVEOUT,
+                                       *attrs.shared_carveout));
+    LOG(INFO) << fmt::format("{}: set shared_carveout={}", kernel_name, *attrs.shared_carveout);
+  }
+  if (attrs.max_dynamic_shared_bytes) {
+    int shared_optin;
+    checkCudaErrors(
+        cuDeviceGetAttribute(&shared_optin, CU_DEVICE_ATTRIBUTE_MAX_SHARED_MEMORY_PER_BLOCK_OPTIN, device));
+    int shared_static;
+    checkCudaErrors(cuFuncGetAttribute(&shared_static, CU_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES, kernel));
+    int bytes = *attrs.max_dynamic_shared_bytes;
+    if (bytes < static_cast<int>(required_shared) || bytes > shared_optin - shared_static) {
+      // below what the kernel needs the launch would fail, above the opt-in limit the call does
+      LOG(WARNING) << fmt::format("{}: ignoring max_dynamic_shared_bytes={}, must be in [{}, {}]",
+                                  kernel_name,
+                                  bytes,
+                                  required_shared,
+                                  shared_optin - shared_static);
+    } else {
+      checkCudaErrors(cuFuncSetAttribute(kernel, CU_FUNC_ATTRIBUTE_MAX_DYNAMIC_SHARED_SIZE_BYTES, bytes));
+      LOG(INFO) << fmt::format("{}: set max_dynamic_shared_bytes={}", kernel_name, bytes);
+    }
+  }
+}
+
+}  // namespace triton_jit
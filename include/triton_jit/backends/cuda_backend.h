@@ -1,14 +1,19 @@
 #pragma once
 
 #include <cuda.h>
+#include <chrono>
+#include <cstdint>
 #include <mutex>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "c10/util/Logging.h"
 #include "fmt/core.h"
 #include "triton_jit/backend_policy.h"
+#include "triton_jit/backends/cu_function_attributes.h"
+#include "triton_jit/function_attributes.h"
 #include "triton_jit/jit_utils.h"
 #include "triton_jit/kernel_metadata.h"
 
@@ -23,6 +28,7 @@ struct CudaBackend {
   using StreamType = CUstream;
   using ContextType = CUcontext;
   using KernelHandle = CUfunction;
+  using EventType = CUevent;
 
   // CUDA warp size is 32 threads
   static constexpr unsigned int WARP_SIZE = 32;
@@ -37,7 +43,17 @@ struct CudaBackend {
     CudaKernelMetadata metadata;
   };
 
+  /// A loaded module shared by all overloads with an identical binary and launch metadata
+  struct LoadedBinary {
+    CUmodule module;
+    CUfunction function;
+    uint64_t load_ns;
+    std::vector<char> binary;  // compared on a key hit, binary_content_key only hashes it
+  };
+
   static inline std::unordered_map<std::string, ModuleData> module_cache_;
+  /// Keyed by binary_content_key, see find_binary
+  static inline std::unordered_map<std::string, LoadedBinary> binary_registry_;
   static inline std::mutex cache_mutex_;
 
   static LaunchOptions prepare_launch(const std::string& /*dir*/,
@@ -97,6 +113,17 @@ struct CudaBackend {
     }
   }
 
+  /// Context of the calling thread, to be made current on another thread with set_current_context
+  static ContextType get_current_context() {
+    CUcontext ctx = nullptr;
+    checkCudaErrors(cuCtxGetCurrent(&ctx));
+    return ctx;
+  }
+
+  static void set_current_context(ContextType ctx) {
+    checkCudaErrors(cuCtxSetCurrent(ctx));
+  }
+
   static int get_device_index() {
     CUdevice device;
     CUresult result = cuCtxGetDevice(&device);
@@ -110,6 +137,47 @@ struct CudaBackend {
     return static_cast<int>(device);
   }
 
+  /// Compute capability of the current device as major * 10 + minor (e.g. 80 for sm_80)
+  static unsigned int get_device_arch() {
+    CUdevice device;
+    checkCudaErrors(cuCtxGetDevice(&device));
+    int major = 0, minor = 0;
+    checkCudaErrors(cuDeviceGetAttribute(&major, CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MAJOR, device));
+    checkCudaErrors(cuDeviceGetAttribute(&minor, CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MINOR, device));
+    return static_cast<unsigned int>(major * 10 + minor);
+  }
+
+  // ---- Events (optional EventBackend extension, used for sampled device timing) ----
+  static CUevent event_create() {
+    CUevent event;
+    checkCudaErrors(cuEventCreate(&event, CU_EVENT_DEFAULT));
+    return event;
+  }
+
+  static void event_record(CUevent event, CUstream stream) {
+    checkCudaErrors(cuEventRecord(event, stream));
+  }
+
+  /// Non-blocking: true once all work captured by the event has completed
+  static bool event_query(CUevent event) {
+    return cuEventQuery(event) == CUDA_SUCCESS;
+  }
+
+  static float event_elapsed_ms(CUevent start, CUevent end) {
+    float ms = 0.0f;
+    checkCudaErrors(cuEventElapsedTime(&ms, start, end));
+    return ms;
+  }
+
+  static void event_destroy(CUevent event) {
+    cuEventDestroy(event);
+  }
+
+  // ---- Memset (optional MemsetBackend extension, used to reset autotune outputs) ----
+  static void memset_zero_async(void* ptr, size_t bytes, CUstream stream) {
+    checkCudaErrors(cuMemsetD8Async(reinterpret_cast<CUdeviceptr>(ptr), 0, bytes, stream));
+  }
+
   static CUfunction load_kernel(const std::string& dir, const std::string& kernel_name) {
     std::string key = fmt::format("{}::{}", dir, kernel_name);
 
@@ -154,10 +222,23 @@ struct CudaBackend {
 
     // Load module
     std::string cubin_path = fmt::format("{}/{}.cubin", dir, kernel_name);
+    std::vector<char> cubin = read_binary_file(cubin_path);
+
+    // Signatures whose hints do not change codegen compile to identical cubins, share one module
+    std::string binary_key =
+        binary_content_key(static_cast<int>(device), kernel_name, cubin, metadata.shared);
+    auto bin_it = find_binary(binary_registry_, binary_key, cubin);
+    if (bin_it != binary_registry_.end()) {
+      LOG(INFO) << fmt::format("Reusing loaded module {} for {}", binary_key, cubin_path);
+      record_module_load(cubin.size(), bin_it->second.load_ns, true);
+      module_cache_[key] = ModuleData {bin_it->second.module, bin_it->second.function, metadata};
+      return bin_it->second.function;
+    }
     LOG(INFO) << fmt::format("Loading cubin from {}", cubin_path);
+    auto load_start = std::chrono::steady_clock::now();
 
     CUmodule module;
-    checkCudaErrors(cuModuleLoad(&module, cubin_path.c_str()));
+    checkCudaErrors(cuModuleLoadData(&module, cubin.data()));
 
     // Get function
     CUfunction kernel;
@@ -165,6 +246,13 @@ struct CudaBackend {
 
     // Configure shared memory if needed
     configure_shared_memory(kernel, device, metadata.shared);
+    apply_function_attributes(kernel, device, kernel_name, metadata.shared);
+
+    uint64_t load_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - load_start)
+                           .count();
+    record_module_load(cubin.size(), load_ns, false);
+    binary_registry_[binary_key] = LoadedBinary {module, kernel, load_ns, std::move(cubin)};
 
     // Cache the module and function
     module_cache_[key] = ModuleData {module, kernel, metadata};
@@ -223,8 +311,40 @@ struct CudaBackend {
       LOG(INFO) << fmt::format("Set dynamic shared memory to {}", shared_optin - shared_static);
     }
   }
+
+  // Applies the FunctionAttributePolicy once per loaded module
+  static void apply_function_attributes(CUfunction kernel,
+                                        CUdevice device,
+                                        const std::string& kernel_name,
+                                        unsigned int required_shared) {
+    FunctionAttributes attrs = FunctionAttributePolicy::instance().lookup(kernel_name);
+    if (attrs.empty()) {
+      return;
+    }
+
+    apply_cu_function_attributes(kernel, device, kernel_name, required_shared, attrs);
+    if (attrs.non_portable_cluster_size_allowed) {
+      int major = 0;
+      checkCudaErrors(cuDeviceGetAttribute(&major, CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MAJOR, device));
+      if (major < 9) {
+        // thread block clusters need sm_90
+        FunctionAttributes unsupported;
+        unsupported.non_portable_cluster_size_allowed = attrs.non_portable_cluster_size_allowed;
+        report_unsupported_function_attributes("CUDA", kernel_name, unsupported);
+      } else {
+        checkCudaErrors(cuFuncSetAttribute(kernel,
+                                           CU_FUNC_ATTRIBUTE_NON_PORTABLE_CLUSTER_SIZE_ALLOWED,
+                                           *attrs.non_portable_cluster_size_allowed ? 1 : 0));
+        LOG(INFO) << fmt::format("{}: set non_portable_cluster_size_allowed={}",
+                                 kernel_name,
+                                 *attrs.non_portable_cluster_size_allowed);
+      }
+    }
+  }
 };
 
 static_assert(BackendPolicy<CudaBackend>, "CudaBackend must satisfy BackendPolicy concept");
+static_assert(EventBackend<CudaBackend>, "CudaBackend must satisfy EventBackend concept");
+static_assert(MemsetBackend<CudaBackend>, "CudaBackend must satisfy MemsetBackend concept");
 
 }  // namespace triton_jit
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "triton_jit/backend_policy.h"
+
+namespace triton_jit {
+
+/**
+ * @brief Packed form of a tensor argument for the interpreter backend
+ *
+ * The interpreter needs host tensors, not raw device pointers, so a pointer
+ * argument also carries the number of bytes reachable from it (to the end of
+ * the tensor's storage). scripts/interpret_launch.py wraps the range as a CPU
+ * tensor without copying.
+ */
+struct HostPointerArg {
+  void* ptr;
+  int64_t nbytes;
+};
+
+/// A "compiled" interpreter kernel: where to import the Triton function from
+struct InterpreterKernel {
+  std::string source_path;
+  std::string function_name;
+  int num_stages;
+};
+
+/**
+ * @brief Host-simulation backend running kernels with Triton's interpreter
+ *
+ * Kernels run on CPU tensors via TRITON_INTERPRET=1 in the embedded Python
+ * interpreter. Signatures, argument packing and the overload cache go through
+ * the normal path; "compilation" only records where the function lives, and a
+ * launch decodes the packed arguments back into Python values. Streams and
+ * contexts are no-ops and launches are synchronous.
+ */
+struct InterpreterBackend {
+  using StreamType = void*;
+  using ContextType = void*;
+  using KernelHandle = const InterpreterKernel*;
+
+  // Only used to compute block dims, which the interpreter ignores
+  static constexpr unsigned int WARP_SIZE = 32;
+
+  struct LaunchOptions {
+    std::string signature;
+  };
+
+  static inline std::unordered_map<std::string, InterpreterKernel> module_cache_;
+  static inline std::mutex cache_mutex_;
+
+  static LaunchOptions prepare_launch(const std::string& /*dir*/,
+                                      const std::string& /*name*/,
+                                      unsigned int /*shared_mem*/,
+                                      const std::string& sig,
+                                      size_t /*num_args*/) {
+    return {.signature = sig};
+  }
+
+  static void launch_kernel(void* stream,
+                            const InterpreterKernel* kernel,
+                            unsigned grid_x,
+                            unsigned grid_y,
+                            unsigned grid_z,
+                            unsigned block_x,
+                            unsigned block_y,
+                            unsigned block_z,
+                            void** args,
+                            const LaunchOptions& opts);
+
+  static void ensure_context() {
+  }
+
+  static ContextType get_current_context() {
+    return nullptr;
+  }
+
+  static void set_current_context(ContextType /*ctx*/) {
+  }
+
+  static int get_device_index() {
+    return 0;
+  }
+
+  static const InterpreterKernel* load_kernel(const std::string& dir, const std::string& kernel_name);
+
+  static unsigned int get_shared_memory(const std::string& /*dir*/, const std::string& /*kernel_name*/) {
+    return 0;
+  }
+};
+
+static_assert(BackendPolicy<InterpreterBackend>, "InterpreterBackend must satisfy BackendPolicy concept");
+
+}  // namespace triton_jit
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <musa.h>
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <mutex>
@@ -12,6 +14,7 @@
 #include "c10/util/Logging.h"
 #include "fmt/core.h"
 #include "triton_jit/backend_policy.h"
+#include "triton_jit/function_attributes.h"
 #include "triton_jit/jit_utils.h"
 #include "triton_jit/kernel_metadata.h"
 
@@ -27,6 +30,7 @@ struct MusaBackend {
   using StreamType = MUstream;
   using ContextType = MUcontext;
   using KernelHandle = MUfunction;
+  using EventType = MUevent;
 
   // MUSA warp size: Triton MUSA backend uses 32, matching CUDA convention
   // Note: Actual MUSA hardware may have different warp size, but Triton compiles with 32
@@ -42,7 +46,17 @@ struct MusaBackend {
     MusaKernelMetadata metadata;
   };
 
+  /// A loaded module shared by all overloads with an identical binary and launch metadata
+  struct LoadedBinary {
+    MUmodule module;
+    MUfunction function;
+    uint64_t load_ns;
+    std::vector<char> binary;  // compared on a key hit, binary_content_key only hashes it
+  };
+
   static inline std::unordered_map<std::string, ModuleData> module_cache_;
+  /// Keyed by binary_content_key, see find_binary; only .mubin binaries are deduplicated
+  static inline std::unordered_map<std::string, LoadedBinary> binary_registry_;
   static inline std::mutex cache_mutex_;
 
   static LaunchOptions prepare_launch(const std::string& /*dir*/,
@@ -96,6 +110,17 @@ struct MusaBackend {
     }
   }
 
+  /// Context of the calling thread, to be made current on another thread with set_current_context
+  static ContextType get_current_context() {
+    MUcontext ctx = nullptr;
+    checkMusaErrors(muCtxGetCurrent(&ctx));
+    return ctx;
+  }
+
+  static void set_current_context(ContextType ctx) {
+    checkMusaErrors(muCtxSetCurrent(ctx));
+  }
+
   static int get_device_index() {
     MUdevice device;
     MUresult result = muCtxGetDevice(&device);
@@ -108,6 +133,37 @@ struct MusaBackend {
     return static_cast<int>(device);
   }
 
+  // ---- Events (optional EventBackend extension, used for sampled device timing) ----
+  static MUevent event_create() {
+    MUevent event;
+    checkMusaErrors(muEventCreate(&event, MU_EVENT_DEFAULT));
+    return event;
+  }
+
+  static void event_record(MUevent event, MUstream stream) {
+    checkMusaErrors(muEventRecord(event, stream));
+  }
+
+  /// Non-blocking: true once all work captured by the event has completed
+  static bool event_query(MUevent event) {
+    return muEventQuery(event) == MUSA_SUCCESS;
+  }
+
+  static float event_elapsed_ms(MUevent start, MUevent end) {
+    float ms = 0.0f;
+    checkMusaErrors(muEventElapsedTime(&ms, start, end));
+    return ms;
+  }
+
+  static void event_destroy(MUevent event) {
+    muEventDestroy(event);
+  }
+
+  // ---- Memset (optional MemsetBackend extension, used to reset autotune outputs) ----
+  static void memset_zero_async(void* ptr, size_t bytes, MUstream stream) {
+    checkMusaErrors(muMemsetD8Async(reinterpret_cast<MUdeviceptr>(ptr), 0, bytes, stream));
+  }
+
   static MUfunction load_kernel(const std::string& dir, const std::string& kernel_name) {
     std::string key = fmt::format("{}::{}", dir, kernel_name);
     std::lock_guard<std::mutex> lock(cache_mutex_);
@@ -129,19 +185,20 @@ struct MusaBackend {
     std::string so_path = fmt::format("{}/{}.so", dir, kernel_name);
     std::string llir_path = fmt::format("{}/{}.llir", dir, kernel_name);
 
+    std::string binary_key;
+    std::vector<char> mubin_data;
+    auto load_start = std::chrono::steady_clock::now();
     if (std::filesystem::exists(mubin_path)) {
-      // Read mubin file as binary
-      std::ifstream mubin_file(mubin_path, std::ios::binary | std::ios::ate);
-      if (!mubin_file.is_open()) {
-        throw std::runtime_error(fmt::format("Failed to open mubin file: {}", mubin_path));
-      }
-
-      std::streamsize size = mubin_file.tellg();
-      mubin_file.seekg(0, std::ios::beg);
-
-      std::vector<char> mubin_data(size);
-      if (!mubin_file.read(mubin_data.data(), size)) {
-        throw std::runtime_error(fmt::format("Failed to read mubin file: {}", mubin_path));
+      mubin_data = read_binary_file(mubin_path);
+
+      // Signatures whose hints do not change codegen compile to identical mubins, share one module
+      binary_key = binary_content_key(get_device_index(), kernel_name, mubin_data, metadata.shared);
+      auto bin_it = find_binary(binary_registry_, binary_key, mubin_data);
+      if (bin_it != binary_registry_.end()) {
+        LOG(INFO) << fmt::format("Reusing loaded module {} for {}", binary_key, mubin_path);
+        record_module_load(mubin_data.size(), bin_it->second.load_ns, true);
+        module_cache_[key] = ModuleData {bin_it->second.module, bin_it->second.function, metadata};
+        return bin_it->second.function;
       }
 
       // Use muModuleLoadData to load the compiled binary
@@ -174,6 +231,16 @@ struct MusaBackend {
     // Get function handle
     MUfunction kernel;
     checkMusaErrors(muModuleGetFunction(&kernel, module, kernel_name.c_str()));
+    report_unsupported_function_attributes(
+        "MUSA", kernel_name, FunctionAttributePolicy::instance().lookup(kernel_name));
+
+    if (!binary_key.empty()) {
+      uint64_t load_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - load_start)
+                             .count();
+      record_module_load(mubin_data.size(), load_ns, false);
+      binary_registry_[binary_key] = LoadedBinary {module, kernel, load_ns, std::move(mubin_data)};
+    }
 
     // Cache the loaded module and metadata
     module_cache_[key] = ModuleData {module, kernel, metadata};
@@ -196,5 +263,7 @@ struct MusaBackend {
 };
 
 static_assert(BackendPolicy<MusaBackend>, "MusaBackend must satisfy BackendPolicy concept");
+static_assert(EventBackend<MusaBackend>, "MusaBackend must satisfy EventBackend concept");
+static_assert(MemsetBackend<MusaBackend>, "MusaBackend must satisfy MemsetBackend concept");
 
 }  // namespace triton_jit
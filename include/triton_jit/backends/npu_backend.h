@@ -1,11 +1,17 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
 #include <fstream>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "acl/acl.h"
@@ -15,6 +21,7 @@
 #include "triton_jit/backend_policy.h"
 #include "triton_jit/backends/npu_arg_buffer.h"
 #include "triton_jit/backends/npu_types.h"
+#include "triton_jit/function_attributes.h"
 #include "triton_jit/jit_utils.h"
 #include "triton_jit/kernel_metadata.h"
 
@@ -24,6 +31,7 @@ struct NpuBackend {
   using StreamType = aclrtStream;
   using ContextType = aclrtContext;
   using KernelHandle = void*;
+  using EventType = aclrtEvent;
 
   // NPU does not use warp concept, but we need a non-zero value for block size calculation
   static constexpr unsigned int WARP_SIZE = 1;
@@ -37,16 +45,60 @@ struct NpuBackend {
   };
 
   struct ModuleData {
-    void* bin_handle;
+    std::string binary_key;  // key into binary_registry_
     void* fn_handle;
     NpuKernelMetadata metadata;
+    size_t users = 0;  // live TritonKernel handles; evictable when 0
+  };
+
+  /**
+   * @brief A device binary registration shared by all modules with identical contents
+   *
+   * Keyed by device, kernel name and binary content hash, so loading the same binary
+   * again (another cache dir, or after eviction of one user) reuses the registration
+   * and its function stub instead of registering a new one. The bytes are kept and
+   * compared on a key hit (see find_binary), the hash alone does not identify a binary.
+   */
+  struct BinaryRegistration {
+    void* bin_handle;
+    std::unique_ptr<size_t> func_stub;
+    size_t refcount;
+    /// Time the registration took, reported as saved by each reuse
+    uint64_t load_ns = 0;
+    std::vector<char> binary;
   };
 
   static inline std::unordered_map<std::string, ModuleData> module_cache_;
   static inline std::mutex cache_mutex_;
-  // Static storage for function stubs
-  static inline std::unordered_map<std::string, size_t> registered_names_;
-  static inline std::unordered_map<std::string, std::unique_ptr<size_t>> func_stubs_;
+  static inline std::unordered_map<std::string, BinaryRegistration> binary_registry_;
+  /// Modules with no live users, least recently released first
+  static inline std::list<std::string> evictable_;
+  static inline std::unordered_set<int> initialized_devices_;
+  static inline size_t next_stub_id_ = 0;
+  static inline size_t module_cache_capacity_ = []() {
+    const char* env = std::getenv("TRITON_JIT_NPU_MODULE_CACHE_CAPACITY");
+    return env ? static_cast<size_t>(std::strtoull(env, nullptr, 10)) : size_t(64);
+  }();
+
+  /// Physical AI core counts of a device, queried once per device
+  struct CoreInfo {
+    uint32_t vector_cores = 0;  // AIV
+    uint32_t cube_cores = 0;    // AIC
+  };
+
+  /**
+   * @brief Physical launch shape for a logical grid
+   *
+   * block_num is what gets passed to rtKernelLaunch (and sizes the workspace);
+   * logical_blocks is the number of tiles the kernel covers by looping over them.
+   */
+  struct LaunchPlan {
+    uint32_t block_num;
+    uint32_t logical_blocks;
+  };
+
+  static inline std::unordered_map<int, CoreInfo> core_info_cache_;
+  static inline std::mutex core_info_mutex_;
 
   static LaunchOptions prepare_launch(const std::string& dir,
                                       const std::string& name,
@@ -113,7 +165,7 @@ struct NpuBackend {
     // Build argument buffer dynamically
     NpuArgBuffer arg_buffer(layout.size() * 8 + 16);
 
-    // 1. Allocate workspace if needed
+    // 1. Allocate workspace if needed (sized by physical blocks, see plan_launch)
     void* workspace_addr = nullptr;
     if (opts.workspace_size > 0) {
       size_t total_workspace = opts.workspace_size * blockNum;
@@ -217,6 +269,23 @@ struct NpuBackend {
     }
   }
 
+  /// Context of the calling thread, to be made current on another thread with set_current_context
+  static ContextType get_current_context() {
+    aclrtContext ctx = nullptr;
+    aclError err = aclrtGetCurrentContext(&ctx);
+    if (err != ACL_ERROR_NONE) {
+      throw std::runtime_error(fmt::format("aclrtGetCurrentContext failed: {}", static_cast<int>(err)));
+    }
+    return ctx;
+  }
+
+  static void set_current_context(ContextType ctx) {
+    aclError err = aclrtSetCurrentContext(ctx);
+    if (err != ACL_ERROR_NONE) {
+      throw std::runtime_error(fmt::format("aclrtSetCurrentContext failed: {}", static_cast<int>(err)));
+    }
+  }
+
   static int get_device_index() {
     int device_id = -1;
     aclError err = aclrtGetDevice(&device_id);
@@ -228,6 +297,115 @@ struct NpuBackend {
     return device_id;
   }
 
+  /**
+   * @brief Get the vector/cube core counts of a device (cached after the first query)
+   *
+   * Counts are 0 when the runtime cannot report them, which disables capping.
+   */
+  static CoreInfo get_core_info(int device_id) {
+    std::lock_guard<std::mutex> lock(core_info_mutex_);
+    auto it = core_info_cache_.find(device_id);
+    if (it != core_info_cache_.end()) {
+      return it->second;
+    }
+
+    CoreInfo info;
+    int64_t value = 0;
+    if (aclrtGetDeviceInfo(static_cast<uint32_t>(device_id), ACL_DEV_ATTR_VECTOR_CORE_NUM, &value) ==
+        ACL_SUCCESS) {
+      info.vector_cores = static_cast<uint32_t>(value);
+    }
+    if (aclrtGetDeviceInfo(static_cast<uint32_t>(device_id), ACL_DEV_ATTR_AICORE_CORE_NUM, &value) ==
+        ACL_SUCCESS) {
+      info.cube_cores = static_cast<uint32_t>(value);
+    }
+    LOG(INFO) << fmt::format("NPU device {}: vector_cores={}, cube_cores={}",
+                             device_id,
+                             info.vector_cores,
+                             info.cube_cores);
+
+    core_info_cache_.emplace(device_id, info);
+    return info;
+  }
+
+  /**
+   * @brief Plan the physical block count for a logical grid
+   *
+   * Pure vector kernels ("aiv") are capped by the vector core count, cube and mixed
+   * kernels by the cube core count. The cap is a multiple of that core count
+   * (TRITON_JIT_NPU_BLOCKS_PER_CORE, default 1). Kernels launched with a capped grid
+   * must loop over the logical grid, e.g. `for tile in range(pid, num_tiles, tl.num_programs(0))`.
+   */
+  static LaunchPlan plan_launch(unsigned grid_x,
+                                unsigned grid_y,
+                                unsigned grid_z,
+                                const std::string& mix_mode) {
+    uint32_t logical = grid_x * grid_y * grid_z;
+
+    int device_id = -1;
+    if (aclrtGetDevice(&device_id) != ACL_SUCCESS) {
+      device_id = 0;
+    }
+    CoreInfo info = get_core_info(device_id);
+    uint32_t cores = (mix_mode == "aiv") ? info.vector_cores : info.cube_cores;
+    if (cores == 0) {
+      return {logical, logical};
+    }
+
+    static const uint32_t blocks_per_core = []() {
+      const char* env = std::getenv("TRITON_JIT_NPU_BLOCKS_PER_CORE");
+      int v = env ? std::atoi(env) : 1;
+      return static_cast<uint32_t>(v > 0 ? v : 1);
+    }();
+    uint32_t cap = cores * blocks_per_core;
+    return {std::min(logical, cap), logical};
+  }
+
+  // ---- Events (optional EventBackend extension, used for sampled device timing) ----
+  static aclrtEvent event_create() {
+    aclrtEvent event = nullptr;
+    aclError err = aclrtCreateEvent(&event);
+    if (err != ACL_SUCCESS) {
+      throw std::runtime_error(fmt::format("aclrtCreateEvent failed: {}", static_cast<int>(err)));
+    }
+    return event;
+  }
+
+  static void event_record(aclrtEvent event, aclrtStream stream) {
+    aclError err = aclrtRecordEvent(event, stream);
+    if (err != ACL_SUCCESS) {
+      throw std::runtime_error(fmt::format("aclrtRecordEvent failed: {}", static_cast<int>(err)));
+    }
+  }
+
+  /// Non-blocking: true once all work captured by the event has completed
+  static bool event_query(aclrtEvent event) {
+    aclrtEventRecordedStatus status = ACL_EVENT_RECORDED_STATUS_NOT_READY;
+    return aclrtQueryEventStatus(event, &status) == ACL_SUCCESS &&
+           status == ACL_EVENT_RECORDED_STATUS_COMPLETE;
+  }
+
+  static float event_elapsed_ms(aclrtEvent start, aclrtEvent end) {
+    float ms = 0.0f;
+    aclError err = aclrtEventElapsedTime(&ms, start, end);
+    if (err != ACL_SUCCESS) {
+      throw std::runtime_error(fmt::format("aclrtEventElapsedTime failed: {}", static_cast<int>(err)));
+    }
+    return ms;
+  }
+
+  static void event_destroy(aclrtEvent event) {
+    aclrtDestroyEvent(event);
+  }
+
+  // ---- Memset (optional MemsetBackend extension, used to reset autotune outputs) ----
+  static void memset_zero_async(void* ptr, size_t bytes, aclrtStream stream) {
+    aclError err = aclrtMemsetAsync(ptr, bytes, 0, bytes, stream);
+    if (err != ACL_SUCCESS) {
+      throw std::runtime_error(fmt::format("aclrtMemsetAsync failed: {}", static_cast<int>(err)));
+    }
+  }
+
   static void* load_kernel(const std::string& dir, const std::string& kernel_name) {
     std::string key = fmt::format("{}::{}", dir, kernel_name);
 
@@ -236,6 +414,9 @@ struct NpuBackend {
     // Check cache first
     auto it = module_cache_.find(key);
     if (it != module_cache_.end()) {
+      if (it->second.users++ == 0) {
+        evictable_.remove(key);
+      }
       return it->second.fn_handle;
     }
 
@@ -294,46 +475,89 @@ struct NpuBackend {
       device_id = 0;  // fallback
     }
 
-    // Set device
-    rtError_t rt_err = rtSetDevice(device_id);
-    if (rt_err != RT_ERROR_NONE) {
-      throw std::runtime_error(
-          fmt::format("rtSetDevice failed for device {}, error: {}", device_id, static_cast<int>(rt_err)));
+    // Set device once per device, not on every load
+    if (initialized_devices_.count(device_id) == 0) {
+      rtError_t rt_err = rtSetDevice(device_id);
+      if (rt_err != RT_ERROR_NONE) {
+        throw std::runtime_error(
+            fmt::format("rtSetDevice failed for device {}, error: {}", device_id, static_cast<int>(rt_err)));
+      }
+      initialized_devices_.insert(device_id);
     }
 
-    // Register binary with RT API
-    rtDevBinary_t binary;
-    binary.data = buffer.data();
-    binary.length = static_cast<uint32_t>(size);
-
-    binary.magic = (metadata.mix_mode == "aiv") ? RT_DEV_BINARY_MAGIC_ELF_AIVEC : RT_DEV_BINARY_MAGIC_ELF;
-    binary.version = 0;
-
-    void* rt_bin_handle = nullptr;
-    rt_err = rtDevBinaryRegister(&binary, &rt_bin_handle);
-    if (rt_err != RT_ERROR_NONE) {
-      throw std::runtime_error(fmt::format("rtDevBinaryRegister failed: {}", static_cast<int>(rt_err)));
+    // Reuse an existing registration of the same binary on this device
+    std::string binary_key = fmt::format("{}:{}:{:016x}:{}",
+                                         device_id,
+                                         kernel_name,
+                                         hash_bytes(buffer.data(), buffer.size()),
+                                         buffer.size());
+    auto reg_it = find_binary(binary_registry_, binary_key, buffer);
+    if (reg_it == binary_registry_.end()) {
+      report_unsupported_function_attributes(
+          "NPU", kernel_name, FunctionAttributePolicy::instance().lookup(kernel_name));
+      auto load_start = std::chrono::steady_clock::now();
+      reg_it = register_binary(binary_key, buffer, metadata, kernel_name);
+      reg_it->second.load_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - load_start)
+                                   .count();
+      record_module_load(buffer.size(), reg_it->second.load_ns, false);
+    } else {
+      VLOG(1) << fmt::format("Reusing NPU binary registration {}", binary_key);
+      record_module_load(buffer.size(), reg_it->second.load_ns, true);
     }
+    reg_it->second.refcount++;
+    void* func_stub_handle = reg_it->second.func_stub.get();
 
-    // Create function stub with unique name
-    std::string stubName = kernel_name;
-    stubName += "_" + std::to_string(registered_names_[kernel_name]);
-    registered_names_[kernel_name]++;
+    // Cache the module
+    module_cache_[key] = ModuleData {binary_key, func_stub_handle, metadata, 1};
 
-    auto registered = func_stubs_.emplace(stubName, std::make_unique<size_t>(0));
-    void* func_stub_handle = registered.first->second.get();
+    return func_stub_handle;
+  }
 
-    // Register function
-    rt_err =
-        rtFunctionRegister(rt_bin_handle, func_stub_handle, stubName.c_str(), (void*)kernel_name.c_str(), 0);
-    if (rt_err != RT_ERROR_NONE) {
-      throw std::runtime_error(fmt::format("rtFunctionRegister failed: {}", static_cast<int>(rt_err)));
+  /**
+   * @brief Drop one user of a loaded kernel
+   *
+   * Called when a TritonKernel handle is destroyed. Modules without users stay
+   * cached but become evictable; the least recently released ones are unregistered
+   * once more than the module cache capacity are idle.
+   */
+  static void release_kernel(const std::string& dir, const std::string& kernel_name) {
+    std::string key = fmt::format("{}::{}", dir, kernel_name);
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+
+    auto it = module_cache_.find(key);
+    if (it == module_cache_.end() || it->second.users == 0) {
+      return;
+    }
+    if (--it->second.users == 0) {
+      evictable_.push_back(key);
+      trim_module_cache_locked(module_cache_capacity_);
     }
+  }
 
-    // Cache the module
-    module_cache_[key] = ModuleData {rt_bin_handle, func_stub_handle, metadata};
+  /**
+   * @brief Unregister an idle kernel now
+   *
+   * @return false if the kernel is not loaded or still has users
+   */
+  static bool unload_kernel(const std::string& dir, const std::string& kernel_name) {
+    std::string key = fmt::format("{}::{}", dir, kernel_name);
+    std::lock_guard<std::mutex> lock(cache_mutex_);
 
-    return func_stub_handle;
+    auto it = module_cache_.find(key);
+    if (it == module_cache_.end() || it->second.users != 0) {
+      return false;
+    }
+    evictable_.remove(key);
+    erase_module_locked(it);
+    return true;
+  }
+
+  /// Set how many idle modules stay registered; evicts immediately if shrinking
+  static void set_module_cache_capacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    module_cache_capacity_ = capacity;
+    trim_module_cache_locked(capacity);
   }
 
   static unsigned int get_shared_memory(const std::string& dir, const std::string& kernel_name) {
@@ -363,8 +587,70 @@ struct NpuBackend {
 
     return nullptr;
   }
+
+ private:
+  static std::unordered_map<std::string, BinaryRegistration>::iterator register_binary(
+      const std::string& binary_key,
+      std::vector<char>& buffer,
+      const NpuKernelMetadata& metadata,
+      const std::string& kernel_name) {
+    // Register binary with RT API
+    rtDevBinary_t binary;
+    binary.data = buffer.data();
+    binary.length = static_cast<uint32_t>(buffer.size());
+
+    binary.magic = (metadata.mix_mode == "aiv") ? RT_DEV_BINARY_MAGIC_ELF_AIVEC : RT_DEV_BINARY_MAGIC_ELF;
+    binary.version = 0;
+
+    void* rt_bin_handle = nullptr;
+    rtError_t rt_err = rtDevBinaryRegister(&binary, &rt_bin_handle);
+    if (rt_err != RT_ERROR_NONE) {
+      throw std::runtime_error(fmt::format("rtDevBinaryRegister failed: {}", static_cast<int>(rt_err)));
+    }
+
+    // Create function stub with unique name
+    std::string stubName = fmt::format("{}_{}", kernel_name, next_stub_id_++);
+    auto func_stub = std::make_unique<size_t>(0);
+
+    // Register function
+    rt_err =
+        rtFunctionRegister(rt_bin_handle, func_stub.get(), stubName.c_str(), (void*)kernel_name.c_str(), 0);
+    if (rt_err != RT_ERROR_NONE) {
+      rtDevBinaryUnRegister(rt_bin_handle);
+      throw std::runtime_error(fmt::format("rtFunctionRegister failed: {}", static_cast<int>(rt_err)));
+    }
+
+    return binary_registry_
+        .emplace(binary_key, BinaryRegistration {rt_bin_handle, std::move(func_stub), 0, 0, buffer})
+        .first;
+  }
+
+  static void erase_module_locked(std::unordered_map<std::string, ModuleData>::iterator it) {
+    auto reg_it = binary_registry_.find(it->second.binary_key);
+    if (reg_it != binary_registry_.end() && --reg_it->second.refcount == 0) {
+      rtError_t rt_err = rtDevBinaryUnRegister(reg_it->second.bin_handle);
+      if (rt_err != RT_ERROR_NONE) {
+        LOG(WARNING) << fmt::format("rtDevBinaryUnRegister failed: {}", static_cast<int>(rt_err));
+      }
+      VLOG(1) << fmt::format("Unregistered NPU binary {}", reg_it->first);
+      binary_registry_.erase(reg_it);
+    }
+    module_cache_.erase(it);
+  }
+
+  static void trim_module_cache_locked(size_t capacity) {
+    while (evictable_.size() > capacity) {
+      auto it = module_cache_.find(evictable_.front());
+      evictable_.pop_front();
+      if (it != module_cache_.end()) {
+        erase_module_locked(it);
+      }
+    }
+  }
 };
 
 static_assert(BackendPolicy<NpuBackend>, "NpuBackend must satisfy BackendPolicy concept");
+static_assert(EventBackend<NpuBackend>, "NpuBackend must satisfy EventBackend concept");
+static_assert(MemsetBackend<NpuBackend>, "NpuBackend must satisfy MemsetBackend concept");
 
 }  // namespace triton_jit
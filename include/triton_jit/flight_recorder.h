@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace triton_jit {
+
+/**
+ * @brief Always-on, bounded record of the most recent kernel launches
+ *
+ * Every launching thread owns a fixed ring of RING_SIZE entries, allocated on
+ * its first launch and written without locks or allocation afterwards. Each
+ * entry stores a launch sequence number, timestamp, kernel/signature id, grid,
+ * stream and up to MAX_PTR_ARGS pointer arguments. Kernel names and signatures
+ * are interned once per compiled overload, so records only carry an id.
+ *
+ * The rings can be dumped on demand (dump), from a fatal signal handler
+ * (install_signal_handlers, or TRITON_JIT_FLIGHT_RECORDER_SIGNALS=1), and are
+ * dumped automatically when a backend launch throws. Dumps go to the file named
+ * by TRITON_JIT_FLIGHT_RECORDER_FILE, or stderr. TRITON_JIT_FLIGHT_RECORDER=0
+ * disables recording.
+ */
+class FlightRecorder {
+ public:
+  static constexpr size_t RING_SIZE = 4096;
+  static constexpr size_t MAX_PTR_ARGS = 8;
+
+  struct Entry {
+    /// 0 while empty or being written, otherwise 1 + the per-thread launch index
+    std::atomic<uint64_t> seq {0};
+    int64_t timestamp_ns;
+    uint32_t kernel_id;
+    uint32_t grid[3];
+    uint32_t num_warps;
+    uint32_t num_ptrs;
+    uintptr_t stream;
+    uintptr_t ptrs[MAX_PTR_ARGS];
+  };
+
+  static bool enabled();
+
+  /**
+   * @brief Register a compiled overload; returns its id (0 when recording is disabled)
+   *
+   * The signature is the full launch signature, used to locate the pointer
+   * arguments in the packed argument array.
+   */
+  static uint32_t intern(const std::string& kernel_name,
+                         const std::string& dir,
+                         const std::string& signature);
+
+  /// Hot path: append one launch to the calling thread's ring
+  static void record(uint32_t kernel_id,
+                     unsigned int grid_x,
+                     unsigned int grid_y,
+                     unsigned int grid_z,
+                     unsigned int num_warps,
+                     const void* stream,
+                     void** args) noexcept;
+
+  /// Write all rings, oldest launch first per thread
+  static void dump(std::ostream& os);
+
+  /// Async-signal-safe dump (no allocation, no locks)
+  static void dump_to_fd(int fd) noexcept;
+
+  /// Dump to the configured destination with a reason line
+  static void dump_on_failure(const char* reason) noexcept;
+
+  /// Dump on SIGSEGV, SIGBUS, SIGILL, SIGFPE and SIGABRT, then chain to the previous handler
+  static void install_signal_handlers();
+};
+
+}  // namespace triton_jit
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace triton_jit {
+
+/// L1 / shared memory preference of a kernel (cuFuncSetCacheConfig)
+enum class CachePreference {
+  NONE,
+  PREFER_SHARED,
+  PREFER_L1,
+  PREFER_EQUAL,
+};
+
+/// "none", "prefer_shared", "prefer_l1" or "prefer_equal", as used in the config file
+const char* cache_preference_name(CachePreference p);
+
+/**
+ * @brief Function attributes to apply to a kernel when it is loaded
+ *
+ * Unset fields keep the backend's default behaviour.
+ */
+struct FunctionAttributes {
+  /// Preferred shared memory carveout, in percent of the maximum (0-100)
+  std::optional<int> shared_carveout;
+  std::optional<CachePreference> cache_preference;
+  /// Maximum dynamic shared memory in bytes, raised above 48 KB for kernels that need less
+  std::optional<int> max_dynamic_shared_bytes;
+  std::optional<bool> non_portable_cluster_size_allowed;
+
+  bool empty() const {
+    return !shared_carveout && !cache_preference && !max_dynamic_shared_bytes &&
+           !non_portable_cluster_size_allowed;
+  }
+
+  /// Fields set in `other` override ours
+  void merge(const FunctionAttributes& other);
+
+  /// "name=value" for every set field, for logging
+  std::vector<std::string> describe() const;
+};
+
+/**
+ * @brief Process-wide, declarative function attribute policy
+ *
+ * Attributes are registered per kernel name, "*" applying to every kernel;
+ * kernel-specific fields win over "*". Backends query the policy once in
+ * load_kernel, apply what they support, log each applied attribute and report
+ * the unsupported ones.
+ *
+ * The policy can also be read from a JSON file named by
+ * TRITON_JIT_FUNC_ATTR_CONFIG, loaded on first use (lookup throws while it is malformed):
+ *
+ *   {"*": {"cache_preference": "prefer_shared"},
+ *    "mm_kernel": {"shared_carveout": 100, "max_dynamic_shared_bytes": 101376}}
+ *
+ * Keys: shared_carveout, cache_preference (none, prefer_shared, prefer_l1,
+ * prefer_equal), max_dynamic_shared_bytes, non_portable_cluster_size_allowed.
+ * Settings made through the C++ API override that file.
+ */
+class FunctionAttributePolicy {
+ public:
+  static FunctionAttributePolicy& instance();
+
+  /// Register attributes for a kernel name ("*" for all kernels); replaces earlier settings
+  void set(const std::string& kernel_name, const FunctionAttributes& attrs);
+
+  /// Effective attributes of a kernel
+  FunctionAttributes lookup(const std::string& kernel_name);
+
+  /// Merge a JSON policy file over the current settings; throws std::runtime_error on malformed files
+  void load_file(const std::string& path);
+
+  void clear();
+
+ private:
+  FunctionAttributePolicy() = default;
+  void ensure_env_loaded();
+
+  std::mutex mutex_;
+  bool env_loaded_ = false;
+  std::map<std::string, FunctionAttributes> attrs_;
+};
+
+/// Warn about attributes a backend cannot apply
+void report_unsupported_function_attributes(const char* backend,
+                                            const std::string& kernel_name,
+                                            const FunctionAttributes& attrs);
+
+}  // namespace triton_jit
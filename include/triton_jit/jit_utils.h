@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>
 #include <mutex>
@@ -14,6 +15,8 @@
 #include "acl/acl.h"
 #elif defined(BACKEND_MUSA)
 #include <musa.h>
+#elif defined(BACKEND_INTERPRETER)
+// no device runtime: kernels run through Triton's interpreter
 #else
 #include "cuda.h"
 #endif
@@ -46,6 +49,8 @@ constexpr const char* to_triton_typename(c10::ScalarType t) {
       return "i8";
     case c10::ScalarType::Float8_e4m3fn:
       return "fp8e4nv";
+    case c10::ScalarType::Float8_e5m2:
+      return "fp8e5";
     case c10::ScalarType::Byte:
       return "u8";
     case c10::ScalarType::Bool:
@@ -120,6 +125,9 @@ struct triton_type : triton_type_helper<std::remove_cv_t<std::remove_reference_t
 // path of python executable
 std::filesystem::path get_script_dir();
 
+// $HOME ($USERPROFILE on Windows)
+std::filesystem::path get_home_directory();
+
 #ifdef BACKEND_NPU
 // ACL error checking function
 inline void checkAclErrors(aclError code, const char* message = "") {
@@ -149,6 +157,8 @@ inline void __checkMusaErrors(MUresult code, const char* file, const int line) {
     throw std::runtime_error(error_string);
   }
 }
+#elif defined(BACKEND_INTERPRETER)
+// no device API errors to check
 #else
 void ensure_cuda_context();
 
@@ -170,6 +180,17 @@ inline void __checkCudaErrors(CUresult code, const char* file, const int line) {
 }
 #endif
 
+// FNV-1a hash of a byte range, used to recognize identical kernel binaries
+inline uint64_t hash_bytes(const void* data, size_t size) {
+  const auto* p = static_cast<const unsigned char*>(data);
+  uint64_t h = 14695981039346656037ull;
+  for (size_t i = 0; i < size; i++) {
+    h ^= p[i];
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
 inline std::string join_sig(const c10::SmallVector<std::string>& signature) {
   std::stringstream ss;
   for (size_t i = 0; i < signature.size(); i++) {
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "triton_jit/backends/npu_types.h"
 
@@ -24,4 +26,39 @@ NpuKernelMetadata load_npu_metadata(const std::string& dir, const std::string& k
 // Returns 0 if file not found or field missing.
 unsigned int load_shared_memory(const std::string& dir, const std::string& kernel_name);
 
+// Read a kernel binary into memory.
+// Throws std::runtime_error if the file is missing or empty.
+std::vector<char> read_binary_file(const std::string& path);
+
+// Key of a loaded binary: device, kernel name, content hash and size, and the
+// launch metadata. Overloads whose binaries share a key can share one module.
+std::string binary_content_key(int device,
+                               const std::string& kernel_name,
+                               const std::vector<char>& binary,
+                               unsigned int shared);
+
+// Whether a registered binary holds exactly the bytes of `binary`.
+bool same_binary(const std::vector<char>& registered, const std::vector<char>& binary);
+
+// Find the registry entry holding `binary` under `key`. The key only hashes the
+// bytes, so entries keep them and a colliding binary moves on to "<key>#1",
+// "<key>#2", ... `key` is set to the slot found; returns end() if it is free.
+template <typename Registry>
+typename Registry::iterator find_binary(Registry& registry,
+                                        std::string& key,
+                                        const std::vector<char>& binary) {
+  std::string base = key;
+  for (size_t probe = 1;; ++probe) {
+    auto it = registry.find(key);
+    if (it == registry.end() || same_binary(it->second.binary, binary)) {
+      return it;
+    }
+    key = base + "#" + std::to_string(probe);
+  }
+}
+
+// Record a module load in RuntimeMetrics. A reused load counts the bytes and
+// load time the first load of the same binary took as saved.
+void record_module_load(size_t bytes, uint64_t load_ns, bool reused);
+
 }  // namespace triton_jit
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "c10/util/Logging.h"
+#include "fmt/core.h"
+#include "torch/torch.h"
+#include "triton_jit/backend_config.h"
+#include "triton_jit/backend_policy.h"
+#include "triton_jit/jit_utils.h"
+#include "triton_jit/triton_jit_function.h"
+
+namespace triton_jit {
+
+/// Size class of an extent: ceil(log2(n)), 0 for n <= 1. Sizes with the same
+/// class share a next power of two, so configs derived from it are exact.
+inline int size_class(int64_t n) {
+  return n <= 1 ? 0 : static_cast<int>(std::bit_width(static_cast<uint64_t>(n - 1)));
+}
+
+/// Dispatch-relevant properties of one tensor argument
+struct TensorClass {
+  at::ScalarType dtype;
+  int ndim;
+  bool contiguous;
+  int numel_class;
+  int last_dim_class;
+
+  static TensorClass of(const at::Tensor& t) {
+    return {t.scalar_type(),
+            static_cast<int>(t.dim()),
+            t.is_contiguous(),
+            size_class(t.numel()),
+            t.dim() == 0 ? 0 : size_class(t.size(-1))};
+  }
+
+  bool operator==(const TensorClass&) const = default;
+};
+
+/**
+ * @brief Classified arguments of one op call
+ *
+ * Predicates and config producers only see this class, never the raw
+ * arguments, so the selection can be memoized per class. Op-specific integer
+ * classes (e.g. size_class of the reduced extent) go into `ints`.
+ */
+struct ArgClass {
+  std::vector<TensorClass> tensors;
+  std::vector<int64_t> ints;
+  unsigned int arch = 0;  // backend device arch, 0 when the backend does not report one
+
+  bool operator==(const ArgClass&) const = default;
+
+  uint64_t fingerprint() const {
+    std::vector<int64_t> words;
+    words.reserve(tensors.size() * 5 + ints.size() + 2);
+    for (const TensorClass& t : tensors) {
+      words.insert(words.end(),
+                   {static_cast<int64_t>(t.dtype), t.ndim, t.contiguous, t.numel_class, t.last_dim_class});
+    }
+    words.push_back(static_cast<int64_t>(tensors.size()));
+    words.insert(words.end(), ints.begin(), ints.end());
+    words.push_back(arch);
+    return hash_bytes(words.data(), words.size() * sizeof(int64_t));
+  }
+};
+
+struct ArgClassHash {
+  size_t operator()(const ArgClass& c) const {
+    return static_cast<size_t>(c.fingerprint());
+  }
+};
+
+/**
+ * @brief Op-level registry of Triton kernel variants with predicate-based dispatch
+ *
+ * Each variant names a Triton function, a predicate over the ArgClass and a
+ * producer of its launch config (an op-specific struct). On the first select()
+ * the variants are frozen into decision order: descending priority, then
+ * registration order. The first variant whose predicate holds wins, and the
+ * (variant, config) pair is memoized per ArgClass. Only memo misses run the
+ * predicates and log the decision, and the memo holds at most MAX_MEMO_ENTRIES
+ * classes.
+ *
+ * Usage (see examples/softmax/softmax_op.cpp):
+ *   static KernelRegistry<SoftmaxLaunch> registry("softmax");
+ *   static const bool registered = [] {
+ *     registry.add("one_tile", "softmax.py", "softmax_one_tile_kernel", 10, fits_one_tile, one_tile_config)
+ *         .add("online", "softmax.py", "softmax_online_kernel", 0, nullptr, online_config);
+ *     return true;
+ *   }();
+ *   auto sel = registry.select({x}, {size_class(N), size_class(K)});
+ *   sel.function(stream, ..., sel.config.tile_n);
+ *
+ * A null predicate always matches.
+ */
+template <BackendPolicy Backend, typename Config>
+class KernelRegistryImpl {
+ public:
+  using Predicate = std::function<bool(const ArgClass&)>;
+  using ConfigProducer = std::function<Config(const ArgClass&)>;
+
+  /// Config and variant are copies: the memo entry they came from may be dropped by a concurrent select()
+  struct Selection {
+    const TritonJITFunctionImpl<Backend>& function;
+    Config config;
+    std::string variant;
+  };
+
+  explicit KernelRegistryImpl(std::string op_name) : op_name_(std::move(op_name)) {
+  }
+
+  KernelRegistryImpl(const KernelRegistryImpl&) = delete;
+  KernelRegistryImpl& operator=(const KernelRegistryImpl&) = delete;
+
+  /// Register a variant. Must happen before the first select().
+  KernelRegistryImpl& add(std::string name,
+                          std::string file,
+                          std::string kernel,
+                          int priority,
+                          Predicate predicate,
+                          ConfigProducer config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (frozen_) {
+      throw std::runtime_error(
+          fmt::format("KernelRegistry {}: variant {} added after dispatch started", op_name_, name));
+    }
+    variants_.push_back(Variant {std::move(name),
+                                 std::move(file),
+                                 std::move(kernel),
+                                 priority,
+                                 std::move(predicate),
+                                 std::move(config),
+                                 nullptr});
+    return *this;
+  }
+
+  /// Classify tensors and op-specific ints; arch is that of the current device when the backend reports one
+  static ArgClass classify(std::initializer_list<at::Tensor> tensors,
+                           std::initializer_list<int64_t> ints = {}) {
+    ArgClass c;
+    c.tensors.reserve(tensors.size());
+    for (const at::Tensor& t : tensors) {
+      c.tensors.push_back(TensorClass::of(t));
+    }
+    c.ints.assign(ints.begin(), ints.end());
+    if constexpr (requires { Backend::get_device_arch(); }) {
+      c.arch = device_arch();
+    }
+    return c;
+  }
+
+  Selection select(const ArgClass& args) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    freeze_locked();
+
+    auto it = memo_.find(args);
+    if (it == memo_.end()) {
+      if (memo_.size() >= MAX_MEMO_ENTRIES) {
+        memo_.clear();
+        log_decisions_ = false;
+      }
+      it = memo_.emplace(args, decide_locked(args)).first;
+    }
+    const Decision& d = it->second;
+    Variant& v = variants_[d.variant];
+    if (v.function == nullptr) {
+      v.function = &TritonJITFunctionImpl<Backend>::get_instance(v.file, v.kernel);
+    }
+    return {*v.function, d.config, v.name};
+  }
+
+  Selection select(std::initializer_list<at::Tensor> tensors,
+                   std::initializer_list<int64_t> ints = {}) const {
+    return select(classify(tensors, ints));
+  }
+
+ private:
+  struct Variant {
+    std::string name;
+    std::string file;
+    std::string kernel;
+    int priority;
+    Predicate predicate;
+    ConfigProducer config;
+    const TritonJITFunctionImpl<Backend>* function;
+  };
+
+  struct Decision {
+    size_t variant;
+    Config config;
+  };
+
+  /// Bound on memoized decisions; the memo is dropped when it grows past it
+  static constexpr size_t MAX_MEMO_ENTRIES = 1024;
+  static constexpr int MAX_CACHED_DEVICES = 64;
+
+  std::string op_name_;
+  mutable std::vector<Variant> variants_;
+  mutable std::unordered_map<ArgClass, Decision, ArgClassHash> memo_;
+  mutable bool frozen_ = false;
+  /// Decisions are logged until the memo first overflows, so each class is logged once
+  mutable bool log_decisions_ = true;
+  mutable std::mutex mutex_;
+
+  /// Arch of the current device, queried from the driver once per device index
+  static unsigned int device_arch() {
+    static std::array<std::atomic<unsigned int>, MAX_CACHED_DEVICES> archs {};
+    const int index = Backend::get_device_index();
+    if (index < 0 || index >= MAX_CACHED_DEVICES) {
+      return Backend::get_device_arch();
+    }
+    unsigned int arch = archs[index].load(std::memory_order_relaxed);
+    if (arch == 0) {
+      arch = Backend::get_device_arch();
+      archs[index].store(arch, std::memory_order_relaxed);
+    }
+    return arch;
+  }
+
+  void freeze_locked() const {
+    if (frozen_) {
+      return;
+    }
+    std::stable_sort(variants_.begin(), variants_.end(), [](const Variant& a, const Variant& b) {
+      return a.priority > b.priority;
+    });
+    frozen_ = true;
+  }
+
+  Decision decide_locked(const ArgClass& args) const {
+    for (size_t i = 0; i < variants_.size(); i++) {
+      if (!variants_[i].predicate || variants_[i].predicate(args)) {
+        if (log_decisions_) {
+          LOG(INFO) << fmt::format("KernelRegistry {}: selected variant {} (fingerprint {:016x})",
+                                   op_name_,
+                                   variants_[i].name,
+                                   args.fingerprint());
+        }
+        return {i, variants_[i].config(args)};
+      }
+    }
+    throw std::runtime_error(fmt::format("KernelRegistry {}: no variant matches the arguments", op_name_));
+  }
+};
+
+template <typename Config>
+using KernelRegistry = KernelRegistryImpl<DefaultBackend, Config>;
+
+}  // namespace triton_jit
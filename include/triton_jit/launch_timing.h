@@ -0,0 +1,182 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "c10/util/Logging.h"
+#include "fmt/core.h"
+#include "triton_jit/backend_policy.h"
+#include "triton_jit/runtime_metrics.h"
+
+namespace triton_jit {
+
+/// Sampling period of device-side launch timing, from TRITON_JIT_TIMING_SAMPLE_EVERY (0 = disabled)
+inline uint64_t launch_timing_sample_every() {
+  static const uint64_t every = []() -> uint64_t {
+    const char* env = std::getenv("TRITON_JIT_TIMING_SAMPLE_EVERY");
+    long long v = env ? std::atoll(env) : 0;
+    return v > 0 ? static_cast<uint64_t>(v) : 0;
+  }();
+  return every;
+}
+
+/**
+ * @brief Times every Nth launch of one kernel with device events
+ *
+ * A sampled launch is bracketed by two events. Completed samples are collected
+ * without blocking on later sampled launches and recorded into the
+ * "device_time/<kernel>/<signature>" histogram of RuntimeMetrics, by the next
+ * sampled launch or by a metrics snapshot (flush hook).
+ */
+template <BackendPolicy Backend>
+  requires EventBackend<Backend>
+class LaunchTimingSampler {
+ public:
+  explicit LaunchTimingSampler(std::string kernel_name, uint64_t every)
+      : kernel_name_(std::move(kernel_name)), every_(every) {
+    flush_hook_ = RuntimeMetrics::instance().add_flush_hook([this]() { poll(); });
+  }
+  ~LaunchTimingSampler() {
+    RuntimeMetrics::instance().remove_flush_hook(flush_hook_);
+  }
+
+  LaunchTimingSampler(const LaunchTimingSampler&) = delete;
+  LaunchTimingSampler& operator=(const LaunchTimingSampler&) = delete;
+
+  bool should_sample() {
+    return launches_.fetch_add(1, std::memory_order_relaxed) % every_ == 0;
+  }
+
+  template <typename Launch>
+  void timed_launch(typename Backend::StreamType stream, const std::string& signature, Launch&& launch) {
+    poll();
+    bool full = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      full = pending_.size() >= MAX_PENDING;
+    }
+    if (full) {
+      RuntimeMetrics::instance().add("device_time/dropped_samples");
+      launch();
+      return;
+    }
+
+    typename Backend::EventType start = Backend::event_create();
+    typename Backend::EventType end = Backend::event_create();
+    try {
+      Backend::event_record(start, stream);
+      launch();
+      Backend::event_record(end, stream);
+    } catch (...) {
+      Backend::event_destroy(start);
+      Backend::event_destroy(end);
+      throw;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back(Sample {start, end, signature});
+  }
+
+  /// Collect completed samples without blocking, also run on every RuntimeMetrics snapshot
+  void poll() {
+    std::vector<std::pair<std::string, uint64_t>> done;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      size_t kept = 0;
+      for (size_t i = 0; i < pending_.size(); i++) {
+        Sample& s = pending_[i];
+        bool finished = false;
+        float ms = -1.0f;
+        try {
+          finished = Backend::event_query(s.end);
+          if (finished) {
+            ms = Backend::event_elapsed_ms(s.start, s.end);
+          }
+        } catch (const std::exception& e) {
+          // drop this sample only, the rest of pending_ is still compacted
+          LOG(WARNING) << "Dropping a timing sample of " << kernel_name_ << ": " << e.what();
+          finished = true;
+        }
+        if (!finished) {
+          if (kept != i) {
+            pending_[kept] = std::move(s);
+          }
+          kept++;
+          continue;
+        }
+        destroy_events(s);
+        if (ms >= 0.0f) {
+          done.emplace_back(std::move(s.signature), static_cast<uint64_t>(static_cast<double>(ms) * 1e6));
+        }
+      }
+      pending_.resize(kept);
+    }
+    // recorded outside mutex_, after pending_ is consistent again
+    for (const auto& [signature, ns] : done) {
+      RuntimeMetrics::instance().record_ns(fmt::format("device_time/{}/{}", kernel_name_, signature), ns);
+    }
+  }
+
+  /// Collect what has completed and drop the rest (the events are still destroyed)
+  void discard() noexcept {
+    try {
+      poll();
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to collect timing samples of " << kernel_name_ << ": " << e.what();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Sample& s : pending_) {
+      destroy_events(s);
+    }
+    pending_.clear();
+  }
+
+ private:
+  struct Sample {
+    typename Backend::EventType start;
+    typename Backend::EventType end;
+    std::string signature;
+  };
+
+  static constexpr size_t MAX_PENDING = 64;
+
+  void destroy_events(Sample& s) noexcept {
+    try {
+      Backend::event_destroy(s.start);
+      Backend::event_destroy(s.end);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to destroy timing events of " << kernel_name_ << ": " << e.what();
+    }
+  }
+
+  std::string kernel_name_;
+  uint64_t every_;
+  std::atomic<uint64_t> launches_ {0};
+  std::mutex mutex_;
+  std::vector<Sample> pending_;
+  uint64_t flush_hook_ = 0;
+};
+
+/// Sampler type of a backend; backends without events get an empty placeholder
+struct NoLaunchTiming {};
+
+namespace detail {
+template <typename Backend, bool HasEvents>
+struct launch_timing_sampler {
+  using type = NoLaunchTiming;
+};
+template <typename Backend>
+struct launch_timing_sampler<Backend, true> {
+  using type = LaunchTimingSampler<Backend>;
+};
+}  // namespace detail
+
+template <BackendPolicy Backend>
+using LaunchTimingSamplerFor = typename detail::launch_timing_sampler<Backend, EventBackend<Backend>>::type;
+
+}  // namespace triton_jit
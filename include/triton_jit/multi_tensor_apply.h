@@ -0,0 +1,236 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "fmt/core.h"
+#include "torch/torch.h"
+#include "triton_jit/backend_config.h"
+#include "triton_jit/backend_policy.h"
+#include "triton_jit/jit_utils.h"
+#include "triton_jit/triton_jit_function.h"
+
+namespace triton_jit {
+
+/**
+ * @brief Apply one chunked Triton kernel to many tensors with a single launch
+ *
+ * Every tensor is split into chunks of `chunk_size` elements and one program
+ * handles one chunk. Pointers, sizes and chunk offsets of all tensors are packed
+ * into an int64 table that is uploaded once per call, or reused when the same
+ * tensors are passed again.
+ *
+ * Table layout for T tensors and C chunks:
+ *   [T records of (NumLists + 1): ptr of list 0, ..., ptr of list NumLists-1, numel]
+ *   [C records of 2: tensor index, chunk start]
+ *
+ * The kernel must have the parameters
+ *   (Table, num_tensors, Ref_0, ..., Ref_{NumLists-1}, extra args..., CHUNK_SIZE: tl.constexpr)
+ * where Ref_l is a tensor of list l, only used for its element type when casting
+ * the table entries back to pointers (see examples/foreach/foreach_axpy.py).
+ *
+ * When the tensors exceed the table limits, the work is split into several launches.
+ * Lists may mix dtypes: the reference tensors give one element type per list
+ * and launch, so tensors are grouped by their dtypes across the lists, in order
+ * of first appearance, and every group gets its own launches.
+ */
+template <BackendPolicy Backend, size_t NumLists>
+class MultiTensorApplyImpl {
+ public:
+  struct Limits {
+    size_t max_tensors = 512;   // tensor records per launch
+    size_t max_chunks = 65535;  // programs per launch
+  };
+
+  using TensorLists = std::array<std::vector<at::Tensor>, NumLists>;
+
+  MultiTensorApplyImpl(const TritonJITFunctionImpl<Backend>& f, int64_t chunk_size, Limits limits = {})
+      : f_(f), chunk_size_(chunk_size), limits_(limits) {
+    TORCH_CHECK(chunk_size_ > 0, "chunk_size must be positive");
+    TORCH_CHECK(limits_.max_tensors > 0 && limits_.max_chunks > 0, "limits must be positive");
+  }
+
+  /**
+   * @brief Launch the kernel over all tensors of the lists
+   *
+   * The table is uploaded on the current torch stream of the tensors' device, so
+   * `stream` is expected to be that stream.
+   */
+  template <typename... Args>
+  void operator()(typename Backend::StreamType stream,
+                  unsigned int num_warps,
+                  unsigned int num_stages,
+                  const TensorLists& lists,
+                  Args... extra) const {
+    const size_t num_tensors = check_lists(lists);
+    if (num_tensors == 0) {
+      return;
+    }
+
+    size_t first = 0;
+    bool tensor_in_group = false;
+    std::vector<int64_t> records;
+    std::vector<int64_t> chunks;
+    auto flush = [&]() {
+      if (chunks.empty()) {
+        return;
+      }
+      size_t group_tensors = records.size() / (NumLists + 1);
+      at::Tensor table = upload_table(records, chunks, lists[0][first].device());
+      launch_group(stream,
+                   num_warps,
+                   num_stages,
+                   table,
+                   static_cast<int64_t>(group_tensors),
+                   static_cast<unsigned int>(chunks.size() / 2),
+                   lists,
+                   first,
+                   std::make_index_sequence<NumLists> {},
+                   extra...);
+      records.clear();
+      chunks.clear();
+      tensor_in_group = false;
+    };
+
+    for (const std::vector<size_t>& group : dtype_groups(lists, num_tensors)) {
+      for (size_t t : group) {
+        const int64_t numel = lists[0][t].numel();
+        tensor_in_group = false;
+        for (int64_t start = 0; start < numel; start += chunk_size_) {
+          if (!tensor_in_group) {
+            if (records.size() / (NumLists + 1) == limits_.max_tensors) {
+              flush();
+            }
+            if (records.empty()) {
+              first = t;
+            }
+            for (size_t l = 0; l < NumLists; l++) {
+              records.push_back(reinterpret_cast<int64_t>(lists[l][t].data_ptr()));
+            }
+            records.push_back(numel);
+            tensor_in_group = true;
+          }
+          chunks.push_back(static_cast<int64_t>(records.size() / (NumLists + 1) - 1));
+          chunks.push_back(start);
+          if (chunks.size() / 2 == limits_.max_chunks) {
+            flush();
+          }
+        }
+      }
+      // a launch never spans two groups, its reference tensors carry the group's dtypes
+      flush();
+    }
+  }
+
+ private:
+  const TritonJITFunctionImpl<Backend>& f_;
+  int64_t chunk_size_;
+  Limits limits_;
+
+  /// Uploaded tables keyed by a hash of their host contents
+  mutable std::unordered_map<uint64_t, std::pair<std::vector<int64_t>, at::Tensor>> table_cache_;
+  mutable std::mutex table_mutex_;
+  static constexpr size_t MAX_CACHED_TABLES = 64;
+
+  static size_t check_lists(const TensorLists& lists) {
+    const size_t num_tensors = lists[0].size();
+    for (size_t l = 0; l < NumLists; l++) {
+      TORCH_CHECK(lists[l].size() == num_tensors,
+                  fmt::format("tensor list {} has {} tensors, expected {}", l, lists[l].size(), num_tensors));
+      for (size_t t = 0; t < num_tensors; t++) {
+        const at::Tensor& x = lists[l][t];
+        TORCH_CHECK(x.is_contiguous(), fmt::format("tensor {} of list {} is not contiguous", t, l));
+        TORCH_CHECK(x.numel() == lists[0][t].numel(),
+                    fmt::format("tensor {} of list {} has a different number of elements", t, l));
+        TORCH_CHECK(x.device() == lists[0][0].device(), "all tensors must be on the same device");
+      }
+    }
+    return num_tensors;
+  }
+
+  /// Tensor indices grouped by their dtypes across the lists, groups in order of first appearance
+  static std::vector<std::vector<size_t>> dtype_groups(const TensorLists& lists, size_t num_tensors) {
+    std::vector<std::array<at::ScalarType, NumLists>> keys;
+    std::vector<std::vector<size_t>> groups;
+    for (size_t t = 0; t < num_tensors; t++) {
+      std::array<at::ScalarType, NumLists> key;
+      for (size_t l = 0; l < NumLists; l++) {
+        key[l] = lists[l][t].scalar_type();
+      }
+      auto it = std::find(keys.begin(), keys.end(), key);
+      if (it == keys.end()) {
+        keys.push_back(key);
+        groups.emplace_back();
+        it = keys.end() - 1;
+      }
+      groups[it - keys.begin()].push_back(t);
+    }
+    return groups;
+  }
+
+  at::Tensor upload_table(const std::vector<int64_t>& records,
+                          const std::vector<int64_t>& chunks,
+                          const at::Device& device) const {
+    std::vector<int64_t> packed;
+    packed.reserve(records.size() + chunks.size() + 1);
+    packed.insert(packed.end(), records.begin(), records.end());
+    packed.insert(packed.end(), chunks.begin(), chunks.end());
+    uint64_t key = hash_bytes(packed.data(), packed.size() * sizeof(int64_t)) ^
+                   static_cast<uint64_t>(device.index());
+
+    std::lock_guard<std::mutex> lock(table_mutex_);
+    auto it = table_cache_.find(key);
+    if (it != table_cache_.end() && it->second.first == packed && it->second.second.device() == device) {
+      return it->second.second;
+    }
+
+    at::TensorOptions host_options = at::TensorOptions().dtype(at::kLong);
+#if !defined(BACKEND_NPU) && !defined(BACKEND_MUSA) && !defined(BACKEND_INTERPRETER)
+    host_options = host_options.pinned_memory(true);
+#endif
+    at::Tensor host = at::empty({static_cast<int64_t>(packed.size())}, host_options);
+    std::copy(packed.begin(), packed.end(), host.data_ptr<int64_t>());
+    at::Tensor table = host.to(device, /*non_blocking=*/true);
+
+    if (table_cache_.size() >= MAX_CACHED_TABLES) {
+      table_cache_.clear();
+    }
+    table_cache_[key] = {std::move(packed), table};
+    return table;
+  }
+
+  template <size_t... I, typename... Args>
+  void launch_group(typename Backend::StreamType stream,
+                    unsigned int num_warps,
+                    unsigned int num_stages,
+                    const at::Tensor& table,
+                    int64_t num_tensors,
+                    unsigned int num_chunks,
+                    const TensorLists& lists,
+                    size_t first,
+                    std::index_sequence<I...>,
+                    Args... extra) const {
+    f_(stream,
+       num_chunks,
+       1,
+       1,
+       num_warps,
+       num_stages,
+       table,
+       num_tensors,
+       lists[I][first]...,
+       extra...,
+       chunk_size_);
+  }
+};
+
+template <size_t NumLists>
+using MultiTensorApply = MultiTensorApplyImpl<DefaultBackend, NumLists>;
+
+}  // namespace triton_jit
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace triton_jit {
+
+/**
+ * @brief Histogram with power-of-two buckets over nanosecond values
+ *
+ * Bucket i counts values v with bit_width(v) == i, i.e. v in [2^(i-1), 2^i).
+ */
+struct Histogram {
+  static constexpr size_t NUM_BUCKETS = 65;
+
+  uint64_t count = 0;
+  uint64_t sum_ns = 0;
+  uint64_t min_ns = UINT64_MAX;
+  uint64_t max_ns = 0;
+  std::array<uint64_t, NUM_BUCKETS> buckets {};
+
+  void record(uint64_t ns);
+};
+
+/**
+ * @brief Process-wide runtime metrics: named counters and latency histograms
+ *
+ * Names are free-form, by convention "<area>/<what>[/<key>]", e.g.
+ * "device_time/<kernel>/<signature>". Recording takes a mutex, so hot paths
+ * should sample rather than record every event.
+ */
+class RuntimeMetrics {
+ public:
+  static RuntimeMetrics& instance();
+
+  void add(std::string_view counter, uint64_t delta = 1);
+  void record_ns(std::string_view histogram, uint64_t ns);
+
+  uint64_t counter(std::string_view name) const;
+  /// Flushes first, see flush()
+  Histogram histogram(std::string_view name) const;
+
+  /// Hooks let deferred recorders (e.g. pending device timings) push what they have before a snapshot
+  uint64_t add_flush_hook(std::function<void()> hook);
+  void remove_flush_hook(uint64_t id);
+  /// Runs every flush hook; a throwing hook is logged and skipped
+  void flush() const;
+
+  /// {"counters": {name: value}, "histograms": {name: {count, sum_ns, min_ns, max_ns, buckets}}}
+  /// Flushes first, see flush()
+  std::string to_json() const;
+  void write_json(const std::string& path) const;
+  void reset();
+
+ private:
+  RuntimeMetrics() = default;
+
+  mutable std::mutex mutex_;
+  std::map<std::string, uint64_t, std::less<>> counters_;
+  std::map<std::string, Histogram, std::less<>> histograms_;
+
+  // separate from mutex_: hooks record into the metrics while this is held
+  mutable std::mutex hooks_mutex_;
+  uint64_t next_hook_id_ = 0;
+  std::map<uint64_t, std::function<void()>> flush_hooks_;
+};
+
+/// Records the host time between construction and destruction into a histogram
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(std::string name) : name_(std::move(name)), start_(std::chrono::steady_clock::now()) {
+  }
+  ~ScopedTimer() {
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    RuntimeMetrics::instance().record_ns(
+        name_, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  std::string name_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace triton_jit
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <cstring>
+#include <limits>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <string>
@@ -11,6 +14,7 @@
 #include <vector>
 
 #include "fmt/core.h"
+#include "triton_jit/autotuner.h"
 #include "triton_jit/backend_config.h"
 #include "triton_jit/backend_policy.h"
 #include "triton_jit/jit_utils.h"
@@ -89,14 +93,25 @@ struct ArgHandle {
   ParameterBuffer& buf;
   c10::SmallVector<std::string>& signature;
   int idx;
+  /// Parameters the caller does not pass (set by autotune configs), nullptr when the caller passes all
+  const std::vector<bool>* provided = nullptr;
 
   template <typename... Args>
   void handle_args(Args... args) {
     (handle_arg(args), ...);
   }
 
+  /// Leave an empty signature token for each provided parameter at the current position
+  void skip_provided() {
+    while (provided != nullptr && idx < static_cast<int>(provided->size()) && (*provided)[idx]) {
+      signature.push_back("");
+      idx++;
+    }
+  }
+
   template <typename T>
   void handle_arg(const T& item) {
+    skip_provided();
     if constexpr (is_optional<decltype(item)>::value) {
       handle_optional(item);
     } else if constexpr (is_same_ignore_cvref<c10::Scalar, T>::value) {
@@ -157,7 +172,14 @@ struct ArgHandle {
     // Assumption: Tensor is never constexpr
     TORCH_CHECK(this->ssig.at(idx) != ArgType::CONSTEXPR);
     void* p_item = item.data_ptr();
+#if defined(BACKEND_INTERPRETER)
+    // the interpreter rebuilds a host tensor over [p_item, end of storage)
+    int64_t nbytes =
+        static_cast<int64_t>(item.storage().nbytes()) - item.storage_offset() * item.element_size();
+    this->buf.push_arg(HostPointerArg {p_item, nbytes});
+#else
     this->buf.push_arg(p_item);
+#endif
     const char* dtype = to_triton_typename(item.scalar_type());
 
     const char* specialization = "";
@@ -220,9 +242,29 @@ class TritonJITFunctionImpl {
   std::string function_name_;
   StaticSignature static_sig_;
 
-  /// Cached compiled kernels (keyed by signature)
+  /// @triton.autotune settings, when the Python function is autotuned
+  std::optional<AutotuneSpec> autotune_;
+  /// @triton.heuristics values, in evaluation order; empty when there are none
+  std::vector<HeuristicValue> heuristics_;
+  /// Parameters set by the autotune configs or the heuristics instead of the caller
+  std::vector<bool> provided_;
+
+  /// Cached compiled kernels (keyed by signature), loaded before they are inserted
   mutable std::unordered_map<std::string, TritonKernelImpl<Backend>> overloads_;
 
+  /// Guards overloads_; not held while compiling, so concurrent misses of one overload may compile it twice
+  mutable std::mutex overloads_mutex_;
+
+  /// Index of the winning config per autotune key
+  mutable std::unordered_map<std::string, size_t> best_config_;
+
+  /// Resolved launches per autotune key, and argument description when there are heuristics
+  mutable std::unordered_map<std::string, TunedLaunch> tuned_;
+
+  /// Guards best_config_ and tuned_; never held across Python or a benchmark, so concurrent
+  /// first launches of a key may both tune it and the first result is kept
+  mutable std::mutex tuning_mutex_;
+
   /// Global registry of all TritonJITFunctionImpl instances
   static std::unordered_map<std::string, std::unique_ptr<TritonJITFunctionImpl<Backend>>> functions_;
 
@@ -244,14 +286,30 @@ class TritonJITFunctionImpl {
   TritonJITFunctionImpl(const TritonJITFunctionImpl&) = delete;
   TritonJITFunctionImpl& operator=(const TritonJITFunctionImpl&) = delete;
 
-  // Default move constructor and assignment
-  TritonJITFunctionImpl(TritonJITFunctionImpl&&) = default;
-  TritonJITFunctionImpl& operator=(TritonJITFunctionImpl&&) = default;
+  // Instances live in the registry and own mutexes, so they are never moved
+  TritonJITFunctionImpl(TritonJITFunctionImpl&&) = delete;
+  TritonJITFunctionImpl& operator=(TritonJITFunctionImpl&&) = delete;
 
   const StaticSignature& get_static_sig() const {
     return this->static_sig_;
   }
 
+  /**
+   * @brief Drop all compiled overloads of this function
+   *
+   * Long-running services with many dynamic shapes can call this to bound the
+   * in-memory cache; backends that reference-count loaded modules may then evict
+   * them. Must not race with launches of this function, which may still hold a
+   * dropped overload.
+   */
+  void clear_overloads() const {
+    std::lock_guard<std::mutex> lock(this->overloads_mutex_);
+    for (auto& [key, kernel] : this->overloads_) {
+      kernel.release_handle();
+    }
+    this->overloads_.clear();
+  }
+
   template <typename... Args>
   void operator()(typename Backend::StreamType stream,
                   unsigned int grid_x,
@@ -272,9 +330,10 @@ class TritonJITFunctionImpl {
     ArgHandle handler = {this->static_sig_, buffer, signature, 0};
     (handler.handle_arg(args), ...);
 
-#if !defined(BACKEND_NPU)
+#if !defined(BACKEND_NPU) && !defined(BACKEND_INTERPRETER)
     // global scratch: introduced in triton 3.3
-    // NPU backend does not use global scratch (handled differently via workspace)
+    // NPU backend does not use global scratch (handled differently via workspace),
+    // the interpreter calls the Python function with its declared parameters only
     handler.append_global_scratch();
     handler.append_global_scratch();
 #endif
@@ -300,6 +359,77 @@ class TritonJITFunctionImpl {
                                  ptrs.size());
   }
 
+  /**
+   * @brief Launch a kernel decorated with @triton.autotune and/or @triton.heuristics
+   *
+   * The caller passes every argument except the constexprs set by the configs
+   * and the heuristics, like a Python call of the decorated kernel. `grid` maps
+   * the chosen KernelConfig to the grid, `{x, y, z}` as
+   * `std::array<unsigned int, 3>`.
+   *
+   * On the first launch with a new autotune key (the values of the key
+   * arguments and the signature), every config is benchmarked and the fastest
+   * is cached. Heuristics are evaluated in Python over a description of the
+   * arguments (dtypes, shapes, strides, alignment, scalar values) and memoized
+   * per description. Launches that hit both caches never enter Python.
+   */
+  template <typename Grid, typename... Args>
+  void launch_tuned(typename Backend::StreamType stream, Grid&& grid, Args... args) const {
+    TORCH_CHECK(this->autotune_.has_value() || !this->heuristics_.empty(),
+                this->function_name_,
+                " has neither @triton.autotune nor @triton.heuristics, launch it with operator()");
+    const int num_args = this->static_sig_.num_args;
+
+    ParameterBuffer buffer;
+    buffer.reserve(num_args);
+    c10::SmallVector<std::string> signature;
+    signature.reserve(num_args);
+
+    ArgHandle handler = {this->static_sig_, buffer, signature, 0, &this->provided_};
+    (handler.handle_arg(args), ...);
+    handler.skip_provided();
+
+#if !defined(BACKEND_NPU) && !defined(BACKEND_INTERPRETER)
+    handler.append_global_scratch();
+    handler.append_global_scratch();
+#endif
+
+    Backend::ensure_context();
+    int device_index = Backend::get_device_index();
+
+    TuningArgs tuning = {
+        this->autotune_ ? &*this->autotune_ : nullptr, this->provided_, !this->heuristics_.empty()};
+    (tuning.handle_arg(args), ...);
+    tuning.finish();
+    std::string key = fmt::format("{};{}{}", join_sig(signature), device_index, tuning.key);
+    std::string launch_key = this->heuristics_.empty() ? key : fmt::format("{}|{}", key, tuning.args);
+
+    c10::SmallVector<void*> ptrs = buffer.get_ptrs();
+    // entries are never erased and map nodes are stable, so the pointer outlives the lock
+    const TunedLaunch* tuned_ptr = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(this->tuning_mutex_);
+      auto it = this->tuned_.find(launch_key);
+      if (it != this->tuned_.end()) {
+        tuned_ptr = &it->second;
+      }
+    }
+    if (tuned_ptr == nullptr) {
+      // resolved without the lock: a caller holding the GIL must not wait on it behind Python
+      const KernelConfig& config =
+          this->choose_config(stream, grid, signature, ptrs, tuning, device_index, key);
+      TunedLaunch resolved = this->resolve_config(signature, config, tuning.args);
+      std::lock_guard<std::mutex> lock(this->tuning_mutex_);
+      tuned_ptr = &this->tuned_.emplace(std::move(launch_key), std::move(resolved)).first->second;
+    }
+    const TunedLaunch& tuned = *tuned_ptr;
+    const TritonKernelImpl<Backend>& kernel =
+        this->get_kernel(tuned.signature, tuned.config.num_warps, tuned.config.num_stages, device_index);
+    std::array<unsigned int, 3> g = grid(tuned.config);
+    kernel.launch_with_signature(
+        g[0], g[1], g[2], tuned.config.num_warps, stream, ptrs.data(), tuned.signature, ptrs.size());
+  }
+
   void launch_with_raw_args(typename Backend::StreamType stream,
                             unsigned int grid_x,
                             unsigned int grid_y,
@@ -320,6 +450,164 @@ class TritonJITFunctionImpl {
 
  private:
   TritonJITFunctionImpl(std::string_view path, std::string_view name);
+
+  /// Values of the heuristics for an argument description and config, aligned with heuristics_
+  std::vector<std::string> evaluate_heuristics(const std::string& args, const KernelConfig& config) const;
+
+  /// Fill the provided parameters of `signature` with the config and the heuristics
+  TunedLaunch resolve_config(const c10::SmallVector<std::string>& signature,
+                             const KernelConfig& config,
+                             const std::string& args) const {
+    TunedLaunch launch {config, ""};
+    c10::SmallVector<std::string> full = signature;
+    if (this->autotune_) {
+      for (size_t i = 0; i < this->autotune_->tuned.size(); i++) {
+        full[this->autotune_->tuned[i]] = config.constexprs[i].second;
+      }
+    }
+    if (!this->heuristics_.empty()) {
+      std::vector<std::string> values = this->evaluate_heuristics(args, config);
+      for (size_t i = 0; i < this->heuristics_.size(); i++) {
+        const HeuristicValue& h = this->heuristics_[i];
+        if (h.name == "num_warps") {
+          launch.config.num_warps = std::stoul(values[i]);
+        } else if (h.name == "num_stages") {
+          launch.config.num_stages = std::stoul(values[i]);
+        } else {
+          full[h.index] = values[i];
+          launch.config.constexprs.emplace_back(h.name, values[i]);
+        }
+      }
+    }
+    launch.signature = join_sig(full);
+    return launch;
+  }
+
+  /// The autotune config for a key, benchmarking the configs on a miss
+  template <typename Grid>
+  const KernelConfig& choose_config(typename Backend::StreamType stream,
+                                    Grid& grid,
+                                    const c10::SmallVector<std::string>& signature,
+                                    c10::SmallVector<void*>& ptrs,
+                                    TuningArgs& tuning,
+                                    int device_index,
+                                    const std::string& key) const {
+    static const KernelConfig default_config;
+    if (!this->autotune_) {
+      return default_config;
+    }
+    {
+      std::lock_guard<std::mutex> lock(this->tuning_mutex_);
+      auto it = this->best_config_.find(key);
+      if (it != this->best_config_.end()) {
+        return this->autotune_->configs[it->second];
+      }
+    }
+    size_t best = this->autotune(stream, grid, signature, ptrs, tuning, device_index);
+    std::lock_guard<std::mutex> lock(this->tuning_mutex_);
+    // a concurrent miss of the same key may have finished first, its choice is kept
+    auto it = this->best_config_.emplace(key, best).first;
+    return this->autotune_->configs[it->second];
+  }
+
+  /// Benchmark every config for one key and return the index of the fastest
+  template <typename Grid>
+  size_t autotune(typename Backend::StreamType stream,
+                  Grid& grid,
+                  const c10::SmallVector<std::string>& signature,
+                  c10::SmallVector<void*>& ptrs,
+                  TuningArgs& tuning,
+                  int device_index) const {
+    const AutotuneSpec& spec = *this->autotune_;
+    if (spec.configs.size() == 1) {
+      return 0;
+    }
+    if constexpr (!EventBackend<Backend> || !MemsetBackend<Backend>) {
+      LOG(WARNING) << fmt::format("Backend cannot time launches, {} uses its first autotune config: {}",
+                                  this->function_name_,
+                                  spec.configs.front().describe());
+      return 0;
+    } else {
+      ScopedTimer timer("jit/autotune");
+      // zeroed with a memset on the benchmark stream: zero_() would run on torch's current stream
+      for (const at::Tensor& t : tuning.reset_to_zero) {
+        TORCH_CHECK(t.is_non_overlapping_and_dense(),
+                    "reset_to_zero argument of ",
+                    this->function_name_,
+                    " must be non-overlapping and dense");
+      }
+      // the caller's data is restored after every config, so the tuned launch sees it unchanged
+      std::vector<at::Tensor> touched = tuning.reset_to_zero;
+      touched.insert(touched.end(), tuning.restore_value.begin(), tuning.restore_value.end());
+      std::vector<at::Tensor> saved;
+      saved.reserve(touched.size());
+      for (const at::Tensor& t : touched) {
+        saved.push_back(t.clone());
+      }
+      // the copies run on torch's current stream, the benchmark on `stream`
+      synchronize_torch_streams(touched);
+
+      size_t best = 0;
+      float best_ms = std::numeric_limits<float>::infinity();
+      for (size_t i = 0; i < spec.configs.size(); i++) {
+        float ms = std::numeric_limits<float>::infinity();
+        try {
+          TunedLaunch candidate = this->resolve_config(signature, spec.configs[i], tuning.args);
+          const TritonKernelImpl<Backend>& kernel = this->get_kernel(
+              candidate.signature, candidate.config.num_warps, candidate.config.num_stages, device_index);
+          std::array<unsigned int, 3> g = grid(candidate.config);
+          auto run = [&]() {
+            for (const at::Tensor& t : tuning.reset_to_zero) {
+              Backend::memset_zero_async(t.data_ptr(), t.numel() * t.element_size(), stream);
+            }
+            kernel.launch_with_signature(g[0],
+                                         g[1],
+                                         g[2],
+                                         candidate.config.num_warps,
+                                         stream,
+                                         ptrs.data(),
+                                         candidate.signature,
+                                         ptrs.size());
+          };
+          ms = benchmark_ms<Backend>(stream, spec.warmup_ms, spec.rep_ms, run);
+        } catch (const std::exception& e) {
+          LOG(WARNING) << fmt::format("Autotune config {} of {} failed: {}",
+                                      spec.configs[i].describe(),
+                                      this->function_name_,
+                                      e.what());
+        }
+        for (size_t j = 0; j < touched.size(); j++) {
+          touched[j].copy_(saved[j]);
+        }
+        synchronize_torch_streams(touched);
+        LOG(INFO) << fmt::format("Autotune {} [{}]: {} -> {:.4f} ms",
+                                 this->function_name_,
+                                 tuning.key,
+                                 spec.configs[i].describe(),
+                                 ms);
+        if (ms < best_ms) {
+          best = i;
+          best_ms = ms;
+        }
+      }
+      RuntimeMetrics::instance().add("autotune/benchmarked_configs", spec.configs.size());
+      TORCH_CHECK(best_ms < std::numeric_limits<float>::infinity(),
+                  "Every autotune config of ",
+                  this->function_name_,
+                  " failed");
+      LOG(INFO) << fmt::format("Autotune {} [{}]: best config {} ({:.4f} ms)",
+                               this->function_name_,
+                               tuning.key,
+                               spec.configs[best].describe(),
+                               best_ms);
+      return best;
+    }
+  }
+
+  /// Record the per-stage wall times returned by lookup_or_compile_a_kernel
+  void record_compile_stages(const std::string& signature,
+                             const std::vector<std::pair<std::string, double>>& stages) const;
+
   const TritonKernelImpl<Backend>& get_kernel(std::string_view signature,
                                               int num_warps,
                                               int num_stages,
@@ -331,9 +619,4 @@ template <BackendPolicy Backend>
 std::unordered_map<std::string, std::unique_ptr<TritonJITFunctionImpl<Backend>>>
     TritonJITFunctionImpl<Backend>::functions_;
 
-// Compile-time checks
-template <BackendPolicy Backend>
-static inline constexpr bool is_triton_jit_function_move_constructible_v =
-    std::is_move_constructible_v<TritonJITFunctionImpl<Backend>>;
-
 }  // namespace triton_jit
@@ -1,13 +1,18 @@
 #pragma once
 
+#include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
 
+#include "c10/util/Logging.h"
 #include "triton_jit/backend_policy.h"
+#include "triton_jit/flight_recorder.h"
 #include "triton_jit/jit_utils.h"
+#include "triton_jit/launch_timing.h"
+#include "triton_jit/runtime_metrics.h"
 
 namespace triton_jit {
 
@@ -23,11 +28,23 @@ class TritonKernelImpl {
   mutable bool loaded_ = false;
   mutable typename Backend::KernelHandle kernel_handle_;
 
+  /// Id of this overload in the FlightRecorder, 0 when not recorded
+  uint32_t recorder_id_ = 0;
+
+  /// Sampled device timing, only allocated when TRITON_JIT_TIMING_SAMPLE_EVERY is set
+  using TimingSampler = LaunchTimingSamplerFor<Backend>;
+  std::unique_ptr<TimingSampler> timing_;
+
  public:
   TritonKernelImpl() = default;
 
   TritonKernelImpl(std::string_view dir, std::string_view kernel_name)
       : dir_(std::string(dir)), kernel_name_(std::string(kernel_name)), loaded_(false) {
+    if constexpr (EventBackend<Backend>) {
+      if (uint64_t every = launch_timing_sample_every(); every > 0) {
+        timing_ = std::make_unique<TimingSampler>(kernel_name_, every);
+      }
+    }
   }
 
   // Delete copy constructor and assignment
@@ -78,16 +95,33 @@ class TritonKernelImpl {
     auto opts = Backend::prepare_launch(dir_, kernel_name_, shared_memory, signature, num_args);
 
     // Launch kernel using backend policy (unified interface)
-    Backend::launch_kernel(stream,
-                           kernel_handle_,
-                           grid_x,
-                           grid_y,
-                           grid_z,
-                           block_x,
-                           block_y,
-                           block_z,
-                           args,
-                           opts);
+    auto launch = [&]() {
+      Backend::launch_kernel(stream,
+                             kernel_handle_,
+                             grid_x,
+                             grid_y,
+                             grid_z,
+                             block_x,
+                             block_y,
+                             block_z,
+                             args,
+                             opts);
+    };
+    if (recorder_id_ != 0) {
+      FlightRecorder::record(recorder_id_, grid_x, grid_y, grid_z, num_warps, stream, args);
+    }
+    try {
+      if constexpr (EventBackend<Backend>) {
+        if (timing_ && timing_->should_sample()) {
+          timing_->timed_launch(stream, signature, launch);
+          return;
+        }
+      }
+      launch();
+    } catch (const std::exception& e) {
+      FlightRecorder::dump_on_failure(e.what());
+      throw;
+    }
   }
 
   const std::string& get_dir() const {
@@ -109,10 +143,31 @@ class TritonKernelImpl {
     }
 
     // Note: For thread safety, the backend's load_kernel should be thread-safe
+    ScopedTimer timer("jit/module_load");
     kernel_handle_ = Backend::load_kernel(dir_, kernel_name_);
     loaded_ = true;
   }
 
+  // Backends that reference-count loaded modules (e.g. NPU) are told when a handle is dropped.
+  // Not done in the destructor: kernels owned by static caches outlive the backend runtime.
+  void release_handle() const noexcept {
+    if constexpr (requires { Backend::release_kernel(dir_, kernel_name_); }) {
+      if (loaded_) {
+        try {
+          Backend::release_kernel(dir_, kernel_name_);
+        } catch (const std::exception& e) {
+          LOG(WARNING) << "Failed to release kernel " << kernel_name_ << ": " << e.what();
+        }
+      }
+    }
+    if constexpr (EventBackend<Backend>) {
+      if (timing_) {
+        timing_->discard();
+      }
+    }
+    loaded_ = false;
+  }
+
   // Friend declaration for TritonJITFunction
   friend class TritonJITFunctionImpl<Backend>;
 };
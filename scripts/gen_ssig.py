@@ -1,4 +1,5 @@
 import importlib.util
+import json
 from argparse import ArgumentParser
 from dataclasses import dataclass
 from pathlib import Path
@@ -6,6 +7,26 @@ from typing import List
 
 import triton
 
+# triton signature type names of tensor element types -> torch dtype names; torch itself is
+# only imported when heuristics are evaluated, signature extraction does not need it
+TORCH_DTYPES = {
+    "i1": "bool",
+    "i8": "int8",
+    "i16": "int16",
+    "i32": "int32",
+    "i64": "int64",
+    "u8": "uint8",
+    "u16": "uint16",
+    "u32": "uint32",
+    "u64": "uint64",
+    "fp16": "float16",
+    "bf16": "bfloat16",
+    "fp32": "float32",
+    "fp64": "float64",
+    "fp8e4nv": "float8_e4m3fn",
+    "fp8e5": "float8_e5m2",
+}
+
 
 @dataclass
 class Signature:
@@ -30,16 +51,249 @@ def static_signature(f: triton.runtime.JITFunction):
     )
 
 
-def extract_static_signature(source_path, fn_name):
+def unwrap_jit_function(fn) -> triton.runtime.JITFunction:
+    """unwrap JITFunction from Autotuner or Heuristics, contarct: decorated fn is stored in the fn attribute.
+
+    With TRITON_INTERPRET=1, triton.jit yields an InterpretedFunction instead, a JITFunction
+    is rebuilt from the wrapped python function to read its parameters.
+    """
+    while not (type(fn) is triton.runtime.JITFunction):
+        if type(fn).__name__ == "InterpretedFunction":
+            return triton.runtime.JITFunction(fn.fn)
+        fn = fn.fn
+    return fn
+
+
+def _constexpr_token(value) -> str:
+    """format a config value the way ArgHandle formats a C++ constexpr"""
+    if value is None:
+        return "nullopt"
+    if isinstance(value, bool):
+        return "true" if value else "false"
+    return str(value)
+
+
+def _arg_indices(arg_names, names, what):
+    indices = []
+    for name in names or []:
+        if name not in arg_names:
+            raise ValueError(f"{what} names unknown argument {name}")
+        indices.append(arg_names.index(name))
+    return indices
+
+
+def _autotune_spec(tuner, jit_fn) -> dict:
+    arg_names = jit_fn.arg_names
+    configs = tuner.configs
+    tuned_names = []
+    for config in configs:
+        for name in config.kwargs:
+            if name not in tuned_names:
+                tuned_names.append(name)
+    tuned = _arg_indices(arg_names, tuned_names, "autotune config")
+    for i in tuned:
+        if not jit_fn.params[i].is_constexpr:
+            raise ValueError(f"autotuned argument {arg_names[i]} must be a tl.constexpr")
+
+    # reset_to_zero/restore_value are names in recent versions, reset_idx/restore_idx in older ones
+    reset_to_zero = getattr(tuner, "reset_to_zero", None)
+    reset_to_zero = (
+        _arg_indices(arg_names, reset_to_zero, "reset_to_zero")
+        if reset_to_zero is not None
+        else list(getattr(tuner, "reset_idx", []))
+    )
+    restore_value = getattr(tuner, "restore_value", None)
+    restore_value = (
+        _arg_indices(arg_names, restore_value, "restore_value")
+        if restore_value is not None
+        else list(getattr(tuner, "restore_idx", []))
+    )
+
+    unsupported = []
+    if getattr(tuner, "early_config_prune", None) or getattr(tuner, "perf_model", None):
+        unsupported.append("prune_configs_by")
+    if getattr(tuner, "user_defined_pre_hook", False) or getattr(tuner, "user_defined_post_hook", False):
+        unsupported.append("pre_hook/post_hook")
+    if any(config.pre_hook is not None for config in configs):
+        unsupported.append("Config.pre_hook")
+
+    config_list = []
+    for config in configs:
+        missing = [name for name in tuned_names if name not in config.kwargs]
+        if missing:
+            raise ValueError(f"autotune config {config} does not set {missing}")
+        config_list.append(
+            {
+                "values": [_constexpr_token(config.kwargs[name]) for name in tuned_names],
+                "num_warps": config.num_warps,
+                "num_stages": config.num_stages,
+            }
+        )
+    return {
+        "tuned": [{"name": name, "index": i} for name, i in zip(tuned_names, tuned)],
+        "configs": config_list,
+        "key": _arg_indices(arg_names, tuner.keys, "autotune key"),
+        "reset_to_zero": reset_to_zero,
+        "restore_value": restore_value,
+        "warmup_ms": getattr(tuner, "num_warmups", None) or 25,
+        "rep_ms": getattr(tuner, "num_reps", None) or 100,
+        "unsupported": unsupported,
+    }
+
+
+def extract_autotune_spec(source_path, fn_name):
+    """The @triton.autotune settings of a kernel as a json string, None if it is not autotuned.
+
+    Config values are formatted as constexpr signature tokens; arguments are referred to by
+    their index in the JITFunction's parameter list.
+    """
     source_path = Path(source_path)
     spec = importlib.util.spec_from_file_location(source_path.stem, source_path)
     mod = importlib.util.module_from_spec(spec)
     spec.loader.exec_module(mod)
     fn = getattr(mod, fn_name)
 
-    # unwrap JITFunction from Autotuner or Heuristics, contarct: decorated fn is stored in the fn attribute
-    while not (type(fn) is triton.runtime.JITFunction):
+    tuner = None
+    obj = fn
+    while type(obj) is not triton.runtime.JITFunction and hasattr(obj, "fn"):
+        if isinstance(obj, triton.runtime.Autotuner):
+            tuner = obj
+            break
+        obj = obj.fn
+    if tuner is None:
+        return None
+    return json.dumps(_autotune_spec(tuner, unwrap_jit_function(fn)))
+
+
+# (source_path, fn_name) -> (heuristics chain, argument names), filled by extract_heuristics
+_heuristics = {}
+
+
+def _heuristics_chain(fn) -> list:
+    """Heuristics wrappers of a kernel, outermost first, the order they run in"""
+    chain = []
+    while type(fn) is not triton.runtime.JITFunction and hasattr(fn, "fn"):
+        if isinstance(fn, triton.runtime.Heuristics):
+            chain.append(fn)
         fn = fn.fn
+    return chain
+
+
+def extract_heuristics(source_path, fn_name):
+    """The values computed by @triton.heuristics as a json string, None if there are none.
+
+    Each value is a constexpr parameter of the kernel, or a launch option (num_warps,
+    num_stages) with index -1.
+    """
+    source_path = Path(source_path)
+    spec = importlib.util.spec_from_file_location(source_path.stem, source_path)
+    mod = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(mod)
+    fn = getattr(mod, fn_name)
+
+    chain = _heuristics_chain(fn)
+    if not chain:
+        return None
+    jit_fn = unwrap_jit_function(fn)
+    derived = []
+    for heuristics in chain:
+        for name in heuristics.values:
+            if name in ("num_warps", "num_stages"):
+                derived.append({"name": name, "index": -1})
+                continue
+            (index,) = _arg_indices(jit_fn.arg_names, [name], "heuristics")
+            if not jit_fn.params[index].is_constexpr:
+                raise ValueError(f"heuristic value {name} must be a tl.constexpr")
+            derived.append({"name": name, "index": index})
+    _heuristics[(str(source_path), fn_name)] = (chain, jit_fn.arg_names)
+    return json.dumps({"derived": derived})
+
+
+class TensorProxy:
+    """Stands in for a tensor argument of a heuristic: metadata only, no storage.
+
+    data_ptr() is the address modulo 16, which is all alignment checks need and keeps
+    the results reusable across allocations.
+    """
+
+    def __init__(self, dtype, shape, stride, data_ptr):
+        import torch
+
+        self.dtype = getattr(torch, TORCH_DTYPES[dtype])
+        self.shape = torch.Size(shape)
+        self._stride = tuple(stride)
+        self._data_ptr = data_ptr
+
+    @property
+    def ndim(self):
+        return len(self.shape)
+
+    def dim(self):
+        return len(self.shape)
+
+    def size(self, dim=None):
+        return self.shape if dim is None else self.shape[dim]
+
+    def stride(self, dim=None):
+        return self._stride if dim is None else self._stride[dim]
+
+    def numel(self):
+        return self.shape.numel()
+
+    def element_size(self):
+        import torch
+
+        return torch.empty((), dtype=self.dtype).element_size()
+
+    def data_ptr(self):
+        return self._data_ptr
+
+    def is_contiguous(self):
+        expected = 1
+        for size, stride in reversed(list(zip(self.shape, self._stride))):
+            if size != 1 and stride != expected:
+                return False
+            expected *= size
+        return True
+
+
+def _heuristic_arg(arg):
+    if isinstance(arg, dict):
+        return TensorProxy(arg["dtype"], arg["shape"], arg["stride"], arg["data_ptr"])
+    return arg
+
+
+def evaluate_heuristics(source_path, fn_name, args_json, config_json):
+    """Run the heuristics of a kernel over argument descriptions built by the C++ runtime.
+
+    args_json lists one entry per kernel parameter: a tensor description, a scalar, or
+    null for None and parameters the runtime provides. config_json holds the
+    [name, token] constexprs chosen so far (autotune config). Returns [name, token]
+    pairs, tokens formatted like C++ constexpr arguments.
+    """
+    from standalone_compile import constexpr
+
+    chain, arg_names = _heuristics[(str(Path(source_path)), fn_name)]
+    named = {name: _heuristic_arg(arg) for name, arg in zip(arg_names, json.loads(args_json))}
+    for name, token in json.loads(config_json):
+        named[name] = constexpr(token)
+    values = []
+    for heuristics in chain:
+        for name, heuristic in heuristics.values.items():
+            value = heuristic(named)
+            named[name] = value
+            values.append([name, _constexpr_token(value)])
+    return values
+
+
+def extract_static_signature(source_path, fn_name):
+    source_path = Path(source_path)
+    spec = importlib.util.spec_from_file_location(source_path.stem, source_path)
+    mod = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(mod)
+    fn = getattr(mod, fn_name)
+
+    fn = unwrap_jit_function(fn)
 
     sig = static_signature(fn)
 
@@ -0,0 +1,59 @@
+"""Launch a Triton JIT function through Triton's interpreter (INTERPRETER backend).
+
+InterpreterBackend::launch_kernel decodes the packed C++ arguments and calls
+`launch`. Pointer arguments arrive as (address, nbytes, dtype) tuples over host
+memory; they are wrapped as CPU tensors without copying, so the kernel writes
+straight into the caller's tensors.
+"""
+
+import ctypes
+import importlib.util
+import os
+from pathlib import Path
+
+# must be set before triton is imported
+os.environ["TRITON_INTERPRET"] = "1"
+
+import torch  # noqa: E402
+
+from gen_ssig import TORCH_DTYPES  # noqa: E402
+from standalone_compile import constexpr  # noqa: E402
+
+
+_functions = {}
+
+
+def _load_function(source_path: str, fn_name: str):
+    key = (source_path, fn_name)
+    fn = _functions.get(key)
+    if fn is None:
+        path = Path(source_path)
+        spec = importlib.util.spec_from_file_location(path.stem, path)
+        mod = importlib.util.module_from_spec(spec)
+        spec.loader.exec_module(mod)
+        fn = getattr(mod, fn_name)
+        _functions[key] = fn
+    return fn
+
+
+def _host_tensor(address: int, nbytes: int, dtype: str) -> torch.Tensor:
+    torch_dtype = getattr(torch, TORCH_DTYPES[dtype])
+    itemsize = torch.empty((), dtype=torch_dtype).element_size()
+    numel = nbytes // itemsize
+    if numel == 0:
+        return torch.empty(0, dtype=torch_dtype)
+    buffer = (ctypes.c_byte * (numel * itemsize)).from_address(address)
+    return torch.frombuffer(buffer, dtype=torch.uint8).view(torch_dtype)
+
+
+def _decode(arg):
+    if isinstance(arg, tuple):
+        return _host_tensor(*arg)
+    if isinstance(arg, str):
+        return constexpr(arg)
+    return arg
+
+
+def launch(source_path, fn_name, grid, num_warps, num_stages, args):
+    fn = _load_function(source_path, fn_name)
+    fn[tuple(grid)](*map(_decode, args), num_warps=num_warps, num_stages=num_stages)
@@ -1,9 +1,11 @@
 import importlib.util
 import json
 import os
+import time
 from argparse import ArgumentParser
+from contextlib import contextmanager, nullcontext
 from pathlib import Path
-from typing import List, Tuple, Union
+from typing import Dict, List, Optional, Tuple, Union
 
 # NPU and MTGPU require this before importing triton
 backend_env = os.environ.get("TRITON_JIT_BACKEND", "").upper()
@@ -206,14 +208,11 @@ def kernel_suffix(signature, specialization):
     return suffix
 
 
-def _compile_a_kernel(
-    fn: triton.runtime.JITFunction,
-    signature: str,
-    num_warps: int = 4,
-    num_stages: int = 3,
-    device_id: int = 0,
-) -> Tuple[str, str]:
-    """compile a kernel."""
+def _build_source(fn: triton.runtime.JITFunction, signature: str):
+    """Build the ASTSource for a full signature.
+
+    Returns the source, the signature split into tokens and the constexpr indices.
+    """
     # static signature
     constexpr_indices = [i for (i, p) in enumerate(fn.params) if p.is_constexpr]
     # non_constexpr_indices = [i for (i, p) in enumerate(fn.params) if not p.is_constexpr]
@@ -331,23 +330,134 @@ def _compile_a_kernel(
             attrs=attrs,
         )
 
+    return src, signature, constexpr_indices
+
+
+def _current_target(device_id: int):
+    if get_backend() in ["NPU", "MUSA", "MTGPU"]:
+        return triton.runtime.driver.active.get_current_target()
+    with torch.cuda.device(device_id):
+        return triton.runtime.driver.active.get_current_target()
+
+
+def _write_npu_arg_layout(
+    cache_dir: str, kernel_name: str, signature: List[str], constexpr_indices: List[int]
+):
+    """NPU: the C++ runtime reads arg_layout from the metadata JSON to pack arguments."""
+    # Generate arg_layout from the original signature
+    arg_layout = generate_arg_layout(signature, constexpr_indices)
+
+    # Look for existing metadata JSON file
+    metadata_path = Path(cache_dir) / f"{kernel_name}.json"
+
+    if metadata_path.exists():
+        # Read existing metadata
+        with open(metadata_path, "r") as f:
+            metadata = json.load(f)
+    else:
+        # Create new metadata
+        metadata = {}
+
+    # Add arg_layout to metadata
+    metadata["arg_layout"] = arg_layout
+
+    # Write back
+    with open(metadata_path, "w") as f:
+        json.dump(metadata, f, indent=2)
+
+    print(
+        f"[NPU] Generated arg_layout with {len(arg_layout)} runtime args: {arg_layout}"
+    )
+
+
+class StageTimer:
+    """Wall time of the steps of a compile, in milliseconds, in the order they first ran"""
+
+    def __init__(self):
+        self.stages: Dict[str, float] = {}
+
+    @contextmanager
+    def time(self, name: str):
+        start = time.perf_counter()
+        try:
+            yield
+        finally:
+            elapsed_ms = (time.perf_counter() - start) * 1e3
+            self.stages[name] = self.stages.get(name, 0.0) + elapsed_ms
+
+    def wrap(self, name: str, fn):
+        def timed(*args, **kwargs):
+            with self.time(name):
+                return fn(*args, **kwargs)
+
+        return timed
+
+
+@contextmanager
+def _timed_compiler_stages(timer: StageTimer):
+    """Time each stage triton.compile runs (ttir, ttgir, llir, ptx, cubin, ...).
+
+    The stages are registered by backend.add_stages; the backend made by triton.compile
+    gets an add_stages that wraps each registered stage. Nothing runs on a cache hit.
+    """
+    from triton.compiler import compiler
+
+    make_backend = compiler.make_backend
+
+    def timed_make_backend(*args, **kwargs):
+        backend = make_backend(*args, **kwargs)
+        add_stages = backend.add_stages
+
+        def timed_add_stages(stages, *stage_args, **stage_kwargs):
+            add_stages(stages, *stage_args, **stage_kwargs)
+            for name, stage in list(stages.items()):
+                stages[name] = timer.wrap(name, stage)
+
+        backend.add_stages = timed_add_stages
+        return backend
+
+    compiler.make_backend = timed_make_backend
+    try:
+        yield
+    finally:
+        compiler.make_backend = make_backend
+
+
+def _compile_a_kernel(
+    fn: triton.runtime.JITFunction,
+    signature: str,
+    num_warps: int = 4,
+    num_stages: int = 3,
+    device_id: int = 0,
+    timer: Optional[StageTimer] = None,
+    built: Optional[tuple] = None,
+) -> Tuple[str, str]:
+    """compile a kernel, reusing the _build_source result `built` when given."""
     # STEP1: JITFunction, constants, signature, specialization
+    if built is None:
+        with timer.time("build_source") if timer else nullcontext():
+            built = _build_source(fn, signature)
+    src, signature, constexpr_indices = built
+    if timer:
+        # code generation from the python AST, before the ttir stage
+        src.make_ir = timer.wrap("ast_to_ttir", src.make_ir)
 
     # STEP2: compile options for the backend
     opts = {"num_warps": num_warps, "num_stages": num_stages}
 
     # STEP3: ast source, target, compile options (backend-specific)
     backend = get_backend()
-    if backend in ["NPU", "MUSA", "MTGPU"]:
-        # NPU/MUSA/MTGPU: no device context manager
-        # Note: MTGPU is the Triton backend name for MUSA (Moore Threads GPU)
-        target = triton.runtime.driver.active.get_current_target()
-        ccinfo = triton.compile(src, target=target, options=opts)
-    else:
-        # CUDA / IX: use CUDA device context
-        with torch.cuda.device(device_id):
+    with _timed_compiler_stages(timer) if timer else nullcontext():
+        if backend in ["NPU", "MUSA", "MTGPU"]:
+            # NPU/MUSA/MTGPU: no device context manager
+            # Note: MTGPU is the Triton backend name for MUSA (Moore Threads GPU)
             target = triton.runtime.driver.active.get_current_target()
             ccinfo = triton.compile(src, target=target, options=opts)
+        else:
+            # CUDA / IX: use CUDA device context
+            with torch.cuda.device(device_id):
+                target = triton.runtime.driver.active.get_current_target()
+                ccinfo = triton.compile(src, target=target, options=opts)
 
     # kernel's hash may not equals the dir in cache
     from triton.runtime.cache import get_cache_manager
@@ -357,33 +467,7 @@ def _compile_a_kernel(
 
     # For NPU backend, generate and write arg_layout to metadata JSON
     if backend == "NPU":
-        # Generate arg_layout from the original signature
-        arg_layout = generate_arg_layout(signature, constexpr_indices)
-
-        # Find the kernel name (usually the function name)
-        kernel_name = fn.__name__
-
-        # Look for existing metadata JSON file
-        metadata_path = Path(cache_dir) / f"{kernel_name}.json"
-
-        if metadata_path.exists():
-            # Read existing metadata
-            with open(metadata_path, "r") as f:
-                metadata = json.load(f)
-        else:
-            # Create new metadata
-            metadata = {}
-
-        # Add arg_layout to metadata
-        metadata["arg_layout"] = arg_layout
-
-        # Write back
-        with open(metadata_path, "w") as f:
-            json.dump(metadata, f, indent=2)
-
-        print(
-            f"[NPU] Generated arg_layout with {len(arg_layout)} runtime args: {arg_layout}"
-        )
+        _write_npu_arg_layout(cache_dir, fn.__name__, signature, constexpr_indices)
 
     # For MTGPU backend: Use official mtgpu.translate_llvmir_to_mubin() for compilation
     elif backend == "MTGPU":
@@ -411,9 +495,10 @@ def _compile_a_kernel(
                     capability = capability[0] * 10 + capability[1]
 
                 # Use official compilation function (same as Triton MUSA backend)
-                asm_str, mubin_tmp_path = mtgpu.translate_llvmir_to_mubin(
-                    llir_content, opt_option, capability, 0
-                )
+                with timer.time("mubin") if timer else nullcontext():
+                    asm_str, mubin_tmp_path = mtgpu.translate_llvmir_to_mubin(
+                        llir_content, opt_option, capability, 0
+                    )
 
                 # Copy mubin to cache directory
                 mubin_path = Path(cache_dir) / f"{kernel_name}.mubin"
@@ -436,6 +521,125 @@ def _compile_a_kernel(
     return cache_dir
 
 
+def _record_interpreted_kernel(
+    source_path: Path,
+    fn_name: str,
+    signature: str,
+    num_warps: int,
+    num_stages: int,
+) -> str:
+    """INTERPRETER backend: nothing to compile, record where the function lives.
+
+    The metadata is written to <cache_dir>/<fn_name>.json and read back by
+    InterpreterBackend::load_kernel; kernels run through interpret_launch.py.
+    """
+    import hashlib
+
+    from triton.runtime.cache import get_cache_manager
+
+    source_path = source_path.resolve()
+    key = f"interpreter;{source_path};{fn_name};{signature};{num_warps};{num_stages}"
+    cache_manager = get_cache_manager(hashlib.sha256(key.encode()).hexdigest())
+    metadata = {
+        "source_path": str(source_path),
+        "name": fn_name,
+        "signature": signature,
+        "num_warps": num_warps,
+        "num_stages": num_stages,
+    }
+    cache_manager.put(json.dumps(metadata, indent=2), f"{fn_name}.json", binary=False)
+    return cache_manager.cache_dir
+
+
+def _load_jit_function(source_path: Path, fn_name: str) -> triton.runtime.JITFunction:
+    spec = importlib.util.spec_from_file_location(source_path.stem, source_path)
+    mod = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(mod)
+    fn = getattr(mod, fn_name)
+
+    # unwrap JITFunction from Autotuner or Heuristics, contarct: decorated fn is stored in the fn attribute
+    while not (type(fn) is triton.runtime.JITFunction):
+        fn = fn.fn
+    return fn
+
+
+def _triton_cache_key(src, target, opts: dict) -> str:
+    """The cache key triton.compile would use for (src, target, opts)."""
+    import hashlib
+
+    from triton.compiler import compiler as triton_compiler
+
+    backend = triton_compiler.make_backend(target)
+    options = backend.parse_options(dict(opts, **src.parse_options()))
+    env_vars = triton_compiler.get_cache_invalidating_env_vars()
+    if hasattr(triton_compiler, "get_cache_key"):  # triton >= 3.4
+        key = triton_compiler.get_cache_key(src, backend, options, env_vars=env_vars)
+    else:
+        key = (
+            f"{triton_compiler.triton_key()}-{src.hash()}-{backend.hash()}-"
+            f"{options.hash()}-{str(sorted(env_vars.items()))}"
+        )
+    return hashlib.sha256(key.encode("utf-8")).hexdigest()
+
+
+def lookup_a_kernel(
+    source_path,
+    fn_name,
+    signature: str,
+    num_warps: int = 4,
+    num_stages: int = 3,
+    device_id: int = 0,
+):
+    """Find a kernel already compiled into the Triton cache, e.g. by Python Triton.
+
+    Computes Triton's own cache key for the function, signature, options and
+    current target, and returns the cache dir when its artifacts are complete,
+    otherwise None. Nothing is compiled.
+    """
+    if get_backend() == "INTERPRETER":
+        return None
+
+    fn = _load_jit_function(Path(source_path), fn_name)
+    built = _build_source(fn, signature)
+    return _lookup_built(fn, built, num_warps, num_stages, device_id)
+
+
+def _lookup_built(fn, built: tuple, num_warps: int, num_stages: int, device_id: int):
+    """lookup_a_kernel for a function whose _build_source result is already at hand."""
+    backend = get_backend()
+    src, signature, constexpr_indices = built
+    opts = {"num_warps": num_warps, "num_stages": num_stages}
+    try:
+        key = _triton_cache_key(src, _current_target(device_id), opts)
+    except (AttributeError, TypeError) as e:
+        # triton internals moved, fall back to compiling
+        print(f"Triton cache lookup unavailable: {e}")
+        return None
+
+    from triton.runtime.cache import get_cache_manager
+
+    cache_manager = get_cache_manager(key)
+    metadata_filename = f"{src.name}.json"
+    group = cache_manager.get_group(metadata_filename)
+    if not group or metadata_filename not in group:
+        return None
+    if not all(os.path.exists(path) for path in group.values()):
+        return None
+
+    cache_dir = cache_manager.cache_dir
+    if backend == "NPU":
+        # compiled outside this runtime: arg_layout has to be added
+        with open(Path(cache_dir) / metadata_filename, "r") as f:
+            has_arg_layout = "arg_layout" in json.load(f)
+        if not has_arg_layout:
+            _write_npu_arg_layout(cache_dir, fn.__name__, signature, constexpr_indices)
+    elif backend == "MTGPU":
+        # the mubin is produced by our compile path only
+        if not (Path(cache_dir) / f"{fn.__name__}.mubin").exists():
+            return None
+    return cache_dir
+
+
 def compile_a_kernel(
     source_path,
     fn_name,
@@ -446,18 +650,93 @@ def compile_a_kernel(
 ):
     # get jit function
     source_path = Path(source_path)
-    spec = importlib.util.spec_from_file_location(source_path.stem, source_path)
-    mod = importlib.util.module_from_spec(spec)
-    spec.loader.exec_module(mod)
-    fn = getattr(mod, fn_name)
-
-    # unwrap JITFunction from Autotuner or Heuristics, contarct: decorated fn is stored in the fn attribute
-    while not (type(fn) is triton.runtime.JITFunction):
-        fn = fn.fn
+    if get_backend() == "INTERPRETER":
+        return _record_interpreted_kernel(
+            source_path, fn_name, signature, num_warps, num_stages
+        )
 
+    fn = _load_jit_function(source_path, fn_name)
     return _compile_a_kernel(fn, signature, num_warps, num_stages, device_id)
 
 
+def compile_a_kernel_with_stats(
+    source_path,
+    fn_name,
+    signature: str,
+    num_warps: int = 4,
+    num_stages: int = 3,
+    device_id: int = 0,
+):
+    """compile_a_kernel, also returning the wall time of each step in milliseconds.
+
+    Steps: import (executing the kernel source), build_source (signature parsing and
+    specialization), ast_to_ttir, then one entry per triton.compile stage of the
+    backend (ttir, ttgir, llir, ptx, cubin on CUDA), and total. Only import,
+    build_source and total are present when triton.compile hits its cache.
+    """
+    timer = StageTimer()
+    start = time.perf_counter()
+    source_path = Path(source_path)
+    if get_backend() == "INTERPRETER":
+        cache_dir = _record_interpreted_kernel(
+            source_path, fn_name, signature, num_warps, num_stages
+        )
+    else:
+        with timer.time("import"):
+            fn = _load_jit_function(source_path, fn_name)
+        cache_dir = _compile_a_kernel(
+            fn, signature, num_warps, num_stages, device_id, timer
+        )
+    timer.stages["total"] = (time.perf_counter() - start) * 1e3
+    return cache_dir, timer.stages
+
+
+def lookup_or_compile_a_kernel(
+    source_path,
+    fn_name,
+    signature: str,
+    num_warps: int = 4,
+    num_stages: int = 3,
+    device_id: int = 0,
+    lookup: bool = True,
+):
+    """lookup_a_kernel, then compile_a_kernel_with_stats on a miss, in one call.
+
+    The kernel source is imported and specialized once and shared by the lookup and
+    the compile. Returns (cache_dir, stages, hit); stages are those of
+    compile_a_kernel_with_stats plus cache_lookup when the cache was searched.
+    A failing lookup is reported and treated as a miss.
+    """
+    timer = StageTimer()
+    start = time.perf_counter()
+    source_path = Path(source_path)
+    if get_backend() == "INTERPRETER":
+        cache_dir = _record_interpreted_kernel(
+            source_path, fn_name, signature, num_warps, num_stages
+        )
+        timer.stages["total"] = (time.perf_counter() - start) * 1e3
+        return cache_dir, timer.stages, False
+
+    with timer.time("import"):
+        fn = _load_jit_function(source_path, fn_name)
+    with timer.time("build_source"):
+        built = _build_source(fn, signature)
+    cache_dir = None
+    if lookup:
+        with timer.time("cache_lookup"):
+            try:
+                cache_dir = _lookup_built(fn, built, num_warps, num_stages, device_id)
+            except Exception as e:
+                print(f"Triton cache lookup failed, compiling instead: {e}")
+    hit = cache_dir is not None
+    if not hit:
+        cache_dir = _compile_a_kernel(
+            fn, signature, num_warps, num_stages, device_id, timer, built
+        )
+    timer.stages["total"] = (time.perf_counter() - start) * 1e3
+    return cache_dir, timer.stages, hit
+
+
 if __name__ == "__main__":
     # command-line arguments
     parser = ArgumentParser(description=DESC)
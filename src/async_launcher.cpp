@@ -0,0 +1,156 @@
+#include "triton_jit/async_launcher.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "c10/util/Logging.h"
+#include "fmt/core.h"
+#include "triton_jit/runtime_metrics.h"
+
+namespace triton_jit {
+
+namespace {
+
+// one launch in this many records its queueing delay, to keep the metrics mutex off the hot path
+constexpr uint64_t kLatencySampleInterval = 64;
+
+int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void pin_launcher_thread([[maybe_unused]] int cpu) {
+#if defined(__linux__)
+  pthread_setname_np(pthread_self(), "triton_launcher");
+  if (cpu < 0) {
+    return;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  if (err != 0) {
+    LOG(WARNING) << fmt::format("Cannot pin the launcher thread to cpu {}: error {}", cpu, err);
+  }
+#else
+  if (cpu >= 0) {
+    LOG(WARNING) << "Pinning the launcher thread is only supported on Linux";
+  }
+#endif
+}
+
+}  // namespace
+
+AsyncLauncher::AsyncLauncher(int cpu) : head_(&stub_), tail_(&stub_) {
+  this->thread_ = std::thread(&AsyncLauncher::run, this, cpu);
+}
+
+AsyncLauncher::~AsyncLauncher() {
+  this->push(new StopRecord(this));
+  this->thread_.join();
+}
+
+AsyncLauncher& AsyncLauncher::instance() {
+  static AsyncLauncher launcher([]() {
+    const char* env = std::getenv("TRITON_JIT_LAUNCHER_CPU");
+    return env == nullptr ? -1 : std::atoi(env);
+  }());
+  return launcher;
+}
+
+void AsyncLauncher::push(LaunchRecord* record) {
+  record->submit_ns = now_ns();
+  record->next.store(nullptr, std::memory_order_relaxed);
+  // counted before it is linked, so completed_ never runs ahead of submitted_
+  this->submitted_.fetch_add(1, std::memory_order_release);
+  LaunchRecord* prev = this->head_.exchange(record, std::memory_order_acq_rel);
+  prev->next.store(record, std::memory_order_release);
+  this->submitted_.notify_one();
+}
+
+LaunchRecord* AsyncLauncher::pop() {
+  LaunchRecord* tail = this->tail_;
+  LaunchRecord* next = tail->next.load(std::memory_order_acquire);
+  if (tail == &this->stub_) {
+    if (next == nullptr) {
+      return nullptr;
+    }
+    this->tail_ = next;
+    tail = next;
+    next = next->next.load(std::memory_order_acquire);
+  }
+  if (next != nullptr) {
+    this->tail_ = next;
+    return tail;
+  }
+  if (tail != this->head_.load(std::memory_order_acquire)) {
+    // a producer has swapped the head but not linked its record yet
+    return nullptr;
+  }
+  // tail is the last record: put the stub behind it so tail can be handed out
+  this->stub_.next.store(nullptr, std::memory_order_relaxed);
+  LaunchRecord* prev = this->head_.exchange(&this->stub_, std::memory_order_acq_rel);
+  prev->next.store(&this->stub_, std::memory_order_release);
+  next = tail->next.load(std::memory_order_acquire);
+  if (next != nullptr) {
+    this->tail_ = next;
+    return tail;
+  }
+  return nullptr;
+}
+
+void AsyncLauncher::run(int cpu) {
+  pin_launcher_thread(cpu);
+  uint64_t issued = 0;
+  while (!this->stopping_) {
+    LaunchRecord* record = this->pop();
+    if (record == nullptr) {
+      uint64_t submitted = this->submitted_.load(std::memory_order_acquire);
+      if (issued < submitted) {
+        // a record is being linked, it is visible shortly
+        std::this_thread::yield();
+      } else {
+        this->submitted_.wait(submitted, std::memory_order_acquire);
+      }
+      continue;
+    }
+
+    if (issued % kLatencySampleInterval == 0) {
+      RuntimeMetrics::instance().record_ns("async_launch/queue_ns",
+                                           static_cast<uint64_t>(now_ns() - record->submit_ns));
+    }
+    try {
+      record->launch();
+      record->done.set_value();
+    } catch (...) {
+      RuntimeMetrics::instance().add("async_launch/failed");
+      record->done.set_exception(std::current_exception());
+    }
+    delete record;
+    this->completed_.store(++issued, std::memory_order_release);
+    this->completed_.notify_all();
+  }
+}
+
+void AsyncLauncher::flush() {
+  const uint64_t target = this->submitted_.load(std::memory_order_acquire);
+  uint64_t completed = this->completed_.load(std::memory_order_acquire);
+  while (completed < target) {
+    this->completed_.wait(completed, std::memory_order_acquire);
+    completed = this->completed_.load(std::memory_order_acquire);
+  }
+}
+
+uint64_t AsyncLauncher::pending() const {
+  // completed_ first: it never exceeds submitted_, which only grows, so this cannot underflow
+  const uint64_t completed = this->completed_.load(std::memory_order_acquire);
+  return this->submitted_.load(std::memory_order_acquire) - completed;
+}
+
+}  // namespace triton_jit
@@ -0,0 +1,72 @@
+#include "triton_jit/autotuner.h"
+
+#include <charconv>
+#include <stdexcept>
+
+#include "fmt/core.h"
+#include "nlohmann/json.hpp"
+
+namespace triton_jit {
+
+int64_t KernelConfig::get(std::string_view name) const {
+  for (const auto& [param, token] : constexprs) {
+    if (param != name) {
+      continue;
+    }
+    if (token == "true" || token == "false") {
+      return token == "true";
+    }
+    int64_t value = 0;
+    auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+    if (ec != std::errc() || end != token.data() + token.size()) {
+      throw std::runtime_error(fmt::format("constexpr {}={} is not an integer", name, token));
+    }
+    return value;
+  }
+  throw std::runtime_error(fmt::format("constexpr {} is not set by the kernel config", name));
+}
+
+std::string KernelConfig::describe() const {
+  std::string out;
+  for (const auto& [param, token] : constexprs) {
+    out += fmt::format("{}={}, ", param, token);
+  }
+  out += fmt::format("num_warps={}, num_stages={}", num_warps, num_stages);
+  return out;
+}
+
+AutotuneSpec AutotuneSpec::from_json(const std::string& json) {
+  AutotuneSpec spec;
+  try {
+    nlohmann::json j = nlohmann::json::parse(json);
+    std::vector<std::string> names;
+    for (const auto& tuned : j.at("tuned")) {
+      names.push_back(tuned.at("name").get<std::string>());
+      spec.tuned.push_back(tuned.at("index").get<int>());
+    }
+    for (const auto& c : j.at("configs")) {
+      KernelConfig config;
+      const auto& values = c.at("values");
+      for (size_t i = 0; i < names.size(); i++) {
+        config.constexprs.emplace_back(names[i], values.at(i).get<std::string>());
+      }
+      config.num_warps = c.at("num_warps").get<unsigned int>();
+      config.num_stages = c.at("num_stages").get<unsigned int>();
+      spec.configs.push_back(std::move(config));
+    }
+    spec.key = j.at("key").get<std::vector<int>>();
+    spec.reset_to_zero = j.at("reset_to_zero").get<std::vector<int>>();
+    spec.restore_value = j.at("restore_value").get<std::vector<int>>();
+    spec.warmup_ms = j.value("warmup_ms", spec.warmup_ms);
+    spec.rep_ms = j.value("rep_ms", spec.rep_ms);
+    spec.unsupported = j.value("unsupported", std::vector<std::string> {});
+  } catch (const nlohmann::json::exception& e) {
+    throw std::runtime_error(fmt::format("Failed to parse autotune spec: {}", e.what()));
+  }
+  if (spec.configs.empty()) {
+    throw std::runtime_error("Autotune spec has no configs");
+  }
+  return spec;
+}
+
+}  // namespace triton_jit
@@ -0,0 +1,457 @@
+#include "triton_jit/flight_recorder.h"
+
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include "c10/util/Logging.h"
+#include "fmt/core.h"
+
+namespace triton_jit {
+
+namespace {
+
+constexpr size_t MAX_KERNELS = 16384;
+constexpr size_t MAX_RINGS = 256;
+
+struct KernelInfo {
+  std::string name;
+  std::string dir;
+  std::string signature;
+  uint32_t num_ptr_slots = 0;
+  std::array<uint16_t, FlightRecorder::MAX_PTR_ARGS> ptr_slots {};
+};
+
+struct Ring {
+  std::array<FlightRecorder::Entry, FlightRecorder::RING_SIZE> entries;
+  std::atomic<uint64_t> next {0};
+  std::atomic<bool> in_use {false};
+  std::atomic<uint64_t> owner {0};
+};
+
+// Interned overloads, published through atomics so the signal handler can read them
+std::array<std::atomic<const KernelInfo*>, MAX_KERNELS> g_kernels {};
+std::atomic<uint32_t> g_num_kernels {0};
+std::mutex g_intern_mutex;
+
+// Rings are never freed; a ring is handed to a new thread once its owner exits
+std::array<std::atomic<Ring*>, MAX_RINGS> g_rings {};
+std::atomic<size_t> g_num_rings {0};
+std::mutex g_ring_mutex;
+
+int g_signal_fd = STDERR_FILENO;
+
+bool is_triton_scalar_type(std::string_view t) {
+  static constexpr std::string_view types[] = {
+      "i1", "i8", "i16", "i32", "i64", "u8", "u16", "u32", "u64", "fp16", "bf16", "fp32", "fp64"};
+  for (std::string_view x : types) {
+    if (t == x) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Positions of pointer arguments in the packed argument array. Mirrors ArgHandle:
+// pointers and non-constexpr scalars are packed, constexprs, nullopt and
+// integers specialized to 1 are not.
+void locate_pointer_args(const std::string& signature, KernelInfo& info) {
+  uint16_t slot = 0;
+  size_t begin = 0;
+  while (begin <= signature.size()) {
+    size_t end = signature.find(',', begin);
+    if (end == std::string::npos) {
+      end = signature.size();
+    }
+    std::string_view tok(signature.data() + begin, end - begin);
+    begin = end + 1;
+    if (tok.empty()) {
+      continue;
+    }
+    if (tok[0] == '*') {
+      if (info.num_ptr_slots < FlightRecorder::MAX_PTR_ARGS) {
+        info.ptr_slots[info.num_ptr_slots++] = slot;
+      }
+      slot++;
+      continue;
+    }
+    size_t colon = tok.find(':');
+    std::string_view base = tok.substr(0, colon);
+    if (!is_triton_scalar_type(base)) {
+      continue;  // constexpr value or nullopt
+    }
+#if !defined(BACKEND_NPU)
+    if (colon != std::string_view::npos && tok.substr(colon) == ":1") {
+      continue;
+    }
+#endif
+    slot++;
+  }
+}
+
+Ring* acquire_ring() {
+  uint64_t tid = static_cast<uint64_t>(::syscall(SYS_gettid));
+  std::lock_guard<std::mutex> lock(g_ring_mutex);
+  size_t n = g_num_rings.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < n; i++) {
+    Ring* r = g_rings[i].load(std::memory_order_relaxed);
+    bool expected = false;
+    if (r->in_use.compare_exchange_strong(expected, true)) {
+      r->owner.store(tid, std::memory_order_relaxed);
+      return r;
+    }
+  }
+  if (n == MAX_RINGS) {
+    return nullptr;
+  }
+  Ring* r = new Ring();
+  r->in_use.store(true, std::memory_order_relaxed);
+  r->owner.store(tid, std::memory_order_relaxed);
+  g_rings[n].store(r, std::memory_order_release);
+  g_num_rings.store(n + 1, std::memory_order_release);
+  return r;
+}
+
+struct ThreadRing {
+  Ring* ring = nullptr;
+  bool acquired = false;
+
+  ~ThreadRing() {
+    if (ring != nullptr) {
+      ring->in_use.store(false, std::memory_order_release);
+    }
+  }
+
+  Ring* get() {
+    if (!acquired) {
+      ring = acquire_ring();
+      acquired = true;
+    }
+    return ring;
+  }
+};
+
+thread_local ThreadRing t_ring;
+
+int64_t now_ns() {
+  auto since_epoch = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count();
+}
+
+// Minimal formatting usable from a signal handler
+class FdSink {
+ public:
+  explicit FdSink(int fd) : fd_(fd) {
+  }
+  ~FdSink() {
+    flush();
+  }
+  void put(const char* s) {
+    while (*s) {
+      put_char(*s++);
+    }
+  }
+  void put(std::string_view s) {
+    for (char c : s) {
+      put_char(c);
+    }
+  }
+  void put_u64(uint64_t v) {
+    char tmp[24];
+    int n = 0;
+    do {
+      tmp[n++] = static_cast<char>('0' + v % 10);
+      v /= 10;
+    } while (v != 0);
+    while (n > 0) {
+      put_char(tmp[--n]);
+    }
+  }
+  void put_i64(int64_t v) {
+    if (v < 0) {
+      put_char('-');
+      put_u64(static_cast<uint64_t>(-(v + 1)) + 1);
+    } else {
+      put_u64(static_cast<uint64_t>(v));
+    }
+  }
+  void put_hex(uint64_t v) {
+    static constexpr char digits[] = "0123456789abcdef";
+    char tmp[16];
+    int n = 0;
+    do {
+      tmp[n++] = digits[v & 0xf];
+      v >>= 4;
+    } while (v != 0);
+    put("0x");
+    while (n > 0) {
+      put_char(tmp[--n]);
+    }
+  }
+
+ private:
+  void put_char(char c) {
+    if (len_ == sizeof(buf_)) {
+      flush();
+    }
+    buf_[len_++] = c;
+  }
+  void flush() {
+    size_t off = 0;
+    while (off < len_) {
+      ssize_t w = ::write(fd_, buf_ + off, len_ - off);
+      if (w <= 0) {
+        break;
+      }
+      off += static_cast<size_t>(w);
+    }
+    len_ = 0;
+  }
+
+  int fd_;
+  char buf_[1024];
+  size_t len_ = 0;
+};
+
+class StreamSink {
+ public:
+  explicit StreamSink(std::ostream& os) : os_(os) {
+  }
+  void put(const char* s) {
+    os_ << s;
+  }
+  void put(std::string_view s) {
+    os_ << s;
+  }
+  void put_u64(uint64_t v) {
+    os_ << v;
+  }
+  void put_i64(int64_t v) {
+    os_ << v;
+  }
+  void put_hex(uint64_t v) {
+    os_ << fmt::format("{:#x}", v);
+  }
+
+ private:
+  std::ostream& os_;
+};
+
+template <typename Sink>
+void dump_impl(Sink& out) {
+  int64_t now = now_ns();
+  out.put("=== triton_jit flight recorder: now=");
+  out.put_i64(now);
+  out.put("ns ===\n");
+
+  const uint32_t num_kernels = g_num_kernels.load(std::memory_order_acquire);
+  const size_t num_rings = g_num_rings.load(std::memory_order_acquire);
+  for (size_t r = 0; r < num_rings; r++) {
+    const Ring* ring = g_rings[r].load(std::memory_order_acquire);
+    const uint64_t next = ring->next.load(std::memory_order_acquire);
+    const uint64_t first = next > FlightRecorder::RING_SIZE ? next - FlightRecorder::RING_SIZE : 0;
+    out.put("--- thread ");
+    out.put_u64(ring->owner.load(std::memory_order_relaxed));
+    out.put(ring->in_use.load(std::memory_order_relaxed) ? "" : " (exited)");
+    out.put(": ");
+    out.put_u64(next);
+    out.put(" launches ---\n");
+
+    for (uint64_t i = first; i < next; i++) {
+      const FlightRecorder::Entry& e = ring->entries[i % FlightRecorder::RING_SIZE];
+      const uint64_t seq = e.seq.load(std::memory_order_acquire);
+      if (seq != i + 1) {
+        continue;  // overwritten or being written
+      }
+      const int64_t ts = e.timestamp_ns;
+      const uint32_t kernel_id = e.kernel_id;
+      const uint32_t grid[3] = {e.grid[0], e.grid[1], e.grid[2]};
+      const uint32_t num_warps = e.num_warps;
+      const uintptr_t stream = e.stream;
+      const uint32_t num_ptrs = std::min<uint32_t>(e.num_ptrs, FlightRecorder::MAX_PTR_ARGS);
+      uintptr_t ptrs[FlightRecorder::MAX_PTR_ARGS];
+      for (uint32_t p = 0; p < num_ptrs; p++) {
+        ptrs[p] = e.ptrs[p];
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (e.seq.load(std::memory_order_relaxed) != seq) {
+        continue;  // torn read
+      }
+
+      out.put("#");
+      out.put_u64(i);
+      out.put(" age=");
+      out.put_i64(now - ts);
+      out.put("ns ");
+      const KernelInfo* info = (kernel_id >= 1 && kernel_id <= num_kernels)
+                                   ? g_kernels[kernel_id - 1].load(std::memory_order_acquire)
+                                   : nullptr;
+      out.put(info ? std::string_view(info->name) : std::string_view("<unknown>"));
+      out.put(" grid=(");
+      out.put_u64(grid[0]);
+      out.put(",");
+      out.put_u64(grid[1]);
+      out.put(",");
+      out.put_u64(grid[2]);
+      out.put(") warps=");
+      out.put_u64(num_warps);
+      out.put(" stream=");
+      out.put_hex(stream);
+      out.put(" ptrs=[");
+      for (uint32_t p = 0; p < num_ptrs; p++) {
+        if (p != 0) {
+          out.put(",");
+        }
+        out.put_hex(ptrs[p]);
+      }
+      out.put("] sig=");
+      out.put(info ? std::string_view(info->signature) : std::string_view(""));
+      out.put("\n");
+    }
+  }
+}
+
+std::array<struct sigaction, NSIG> g_previous_actions;
+
+void fatal_signal_handler(int sig) {
+  FlightRecorder::dump_to_fd(g_signal_fd);
+  ::sigaction(sig, &g_previous_actions[sig], nullptr);
+  ::raise(sig);
+}
+
+}  // namespace
+
+bool FlightRecorder::enabled() {
+  static const bool on = []() {
+    const char* env = std::getenv("TRITON_JIT_FLIGHT_RECORDER");
+    bool enabled = env == nullptr || std::string_view(env) != "0";
+    const char* signals = std::getenv("TRITON_JIT_FLIGHT_RECORDER_SIGNALS");
+    if (enabled && signals != nullptr && std::string_view(signals) == "1") {
+      install_signal_handlers();
+    }
+    return enabled;
+  }();
+  return on;
+}
+
+uint32_t FlightRecorder::intern(const std::string& kernel_name,
+                                const std::string& dir,
+                                const std::string& signature) {
+  if (!enabled()) {
+    return 0;
+  }
+  static std::unordered_map<std::string, uint32_t> ids;
+  std::string key = fmt::format("{}/{}:{}", dir, kernel_name, signature);
+
+  std::lock_guard<std::mutex> lock(g_intern_mutex);
+  auto it = ids.find(key);
+  if (it != ids.end()) {
+    return it->second;
+  }
+  uint32_t n = g_num_kernels.load(std::memory_order_relaxed);
+  if (n == MAX_KERNELS) {
+    LOG(WARNING) << "FlightRecorder: too many kernel overloads, not recording " << kernel_name;
+    return 0;
+  }
+  auto info = std::make_unique<KernelInfo>();
+  info->name = kernel_name;
+  info->dir = dir;
+  info->signature = signature;
+  locate_pointer_args(signature, *info);
+  g_kernels[n].store(info.release(), std::memory_order_release);
+  g_num_kernels.store(n + 1, std::memory_order_release);
+  ids.emplace(std::move(key), n + 1);
+  return n + 1;
+}
+
+void FlightRecorder::record(uint32_t kernel_id,
+                            unsigned int grid_x,
+                            unsigned int grid_y,
+                            unsigned int grid_z,
+                            unsigned int num_warps,
+                            const void* stream,
+                            void** args) noexcept {
+  Ring* ring = t_ring.get();
+  if (ring == nullptr || kernel_id == 0) {
+    return;
+  }
+  const KernelInfo* info = g_kernels[kernel_id - 1].load(std::memory_order_acquire);
+
+  // Single writer per ring: the seq of an entry is cleared before and
+  // republished after the payload, so readers can detect torn entries.
+  const uint64_t i = ring->next.load(std::memory_order_relaxed);
+  Entry& e = ring->entries[i % RING_SIZE];
+  e.seq.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  e.timestamp_ns = now_ns();
+  e.kernel_id = kernel_id;
+  e.grid[0] = grid_x;
+  e.grid[1] = grid_y;
+  e.grid[2] = grid_z;
+  e.num_warps = num_warps;
+  e.stream = reinterpret_cast<uintptr_t>(stream);
+  e.num_ptrs = info->num_ptr_slots;
+  for (uint32_t p = 0; p < info->num_ptr_slots; p++) {
+    e.ptrs[p] = *static_cast<const uintptr_t*>(args[info->ptr_slots[p]]);
+  }
+  e.seq.store(i + 1, std::memory_order_release);
+  ring->next.store(i + 1, std::memory_order_release);
+}
+
+void FlightRecorder::dump(std::ostream& os) {
+  StreamSink sink(os);
+  dump_impl(sink);
+  os.flush();
+}
+
+void FlightRecorder::dump_to_fd(int fd) noexcept {
+  FdSink sink(fd);
+  dump_impl(sink);
+}
+
+void FlightRecorder::dump_on_failure(const char* reason) noexcept {
+  try {
+    const char* path = std::getenv("TRITON_JIT_FLIGHT_RECORDER_FILE");
+    std::ofstream file;
+    if (path != nullptr) {
+      file.open(path, std::ios::app);
+    }
+    std::ostream& os = file.is_open() ? static_cast<std::ostream&>(file) : std::cerr;
+    os << "triton_jit launch failed: " << reason << "\n";
+    dump(os);
+  } catch (...) {
+    // never let diagnostics mask the original error
+  }
+}
+
+void FlightRecorder::install_signal_handlers() {
+  static std::once_flag once;
+  std::call_once(once, []() {
+    if (const char* path = std::getenv("TRITON_JIT_FLIGHT_RECORDER_FILE")) {
+      int fd = ::open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+      if (fd >= 0) {
+        g_signal_fd = fd;
+      }
+    }
+    struct sigaction action {};
+    action.sa_handler = fatal_signal_handler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESETHAND;
+    for (int sig : {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT}) {
+      ::sigaction(sig, &action, &g_previous_actions[sig]);
+    }
+  });
+}
+
+}  // namespace triton_jit
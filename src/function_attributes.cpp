@@ -0,0 +1,180 @@
+#include "triton_jit/function_attributes.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+#include "c10/util/Logging.h"
+#include "fmt/core.h"
+#include "fmt/ranges.h"
+#include "nlohmann/json.hpp"
+
+namespace triton_jit {
+
+namespace {
+
+CachePreference parse_cache_preference(const std::string& s) {
+  for (CachePreference p : {CachePreference::NONE,
+                            CachePreference::PREFER_SHARED,
+                            CachePreference::PREFER_L1,
+                            CachePreference::PREFER_EQUAL}) {
+    if (s == cache_preference_name(p)) {
+      return p;
+    }
+  }
+  throw std::runtime_error(fmt::format("Unknown cache_preference: {}", s));
+}
+
+FunctionAttributes parse_attributes(const nlohmann::json& j) {
+  FunctionAttributes attrs;
+  for (const auto& [key, value] : j.items()) {
+    if (key == "shared_carveout") {
+      int carveout = value.get<int>();
+      if (carveout < 0 || carveout > 100) {
+        throw std::runtime_error(fmt::format("shared_carveout must be in [0, 100], got {}", carveout));
+      }
+      attrs.shared_carveout = carveout;
+    } else if (key == "cache_preference") {
+      attrs.cache_preference = parse_cache_preference(value.get<std::string>());
+    } else if (key == "max_dynamic_shared_bytes") {
+      attrs.max_dynamic_shared_bytes = value.get<int>();
+    } else if (key == "non_portable_cluster_size_allowed") {
+      attrs.non_portable_cluster_size_allowed = value.get<bool>();
+    } else {
+      throw std::runtime_error(fmt::format("Unknown function attribute: {}", key));
+    }
+  }
+  return attrs;
+}
+
+std::map<std::string, FunctionAttributes> parse_file(const std::string& path) {
+  std::ifstream f(path);
+  if (!f.is_open()) {
+    throw std::runtime_error(fmt::format("Failed to open function attribute config {}", path));
+  }
+  std::map<std::string, FunctionAttributes> result;
+  try {
+    nlohmann::json j = nlohmann::json::parse(f);
+    for (const auto& [kernel_name, value] : j.items()) {
+      result[kernel_name] = parse_attributes(value);
+    }
+  } catch (const nlohmann::json::exception& e) {
+    throw std::runtime_error(
+        fmt::format("Failed to parse function attribute config {}: {}", path, e.what()));
+  }
+  return result;
+}
+
+}  // namespace
+
+const char* cache_preference_name(CachePreference p) {
+  switch (p) {
+    case CachePreference::NONE:
+      return "none";
+    case CachePreference::PREFER_SHARED:
+      return "prefer_shared";
+    case CachePreference::PREFER_L1:
+      return "prefer_l1";
+    case CachePreference::PREFER_EQUAL:
+      return "prefer_equal";
+  }
+  return "unknown";
+}
+
+void FunctionAttributes::merge(const FunctionAttributes& other) {
+  if (other.shared_carveout) shared_carveout = other.shared_carveout;
+  if (other.cache_preference) cache_preference = other.cache_preference;
+  if (other.max_dynamic_shared_bytes) max_dynamic_shared_bytes = other.max_dynamic_shared_bytes;
+  if (other.non_portable_cluster_size_allowed) {
+    non_portable_cluster_size_allowed = other.non_portable_cluster_size_allowed;
+  }
+}
+
+std::vector<std::string> FunctionAttributes::describe() const {
+  std::vector<std::string> out;
+  if (shared_carveout) out.push_back(fmt::format("shared_carveout={}", *shared_carveout));
+  if (cache_preference) {
+    out.push_back(fmt::format("cache_preference={}", cache_preference_name(*cache_preference)));
+  }
+  if (max_dynamic_shared_bytes) {
+    out.push_back(fmt::format("max_dynamic_shared_bytes={}", *max_dynamic_shared_bytes));
+  }
+  if (non_portable_cluster_size_allowed) {
+    out.push_back(fmt::format("non_portable_cluster_size_allowed={}", *non_portable_cluster_size_allowed));
+  }
+  return out;
+}
+
+FunctionAttributePolicy& FunctionAttributePolicy::instance() {
+  static FunctionAttributePolicy policy;
+  return policy;
+}
+
+void FunctionAttributePolicy::set(const std::string& kernel_name, const FunctionAttributes& attrs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  attrs_[kernel_name] = attrs;
+}
+
+FunctionAttributes FunctionAttributePolicy::lookup(const std::string& kernel_name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ensure_env_loaded();
+  FunctionAttributes result;
+  if (auto it = attrs_.find("*"); it != attrs_.end()) {
+    result.merge(it->second);
+  }
+  if (auto it = attrs_.find(kernel_name); it != attrs_.end()) {
+    result.merge(it->second);
+  }
+  return result;
+}
+
+void FunctionAttributePolicy::load_file(const std::string& path) {
+  std::map<std::string, FunctionAttributes> loaded = parse_file(path);
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& [kernel_name, attrs] : loaded) {
+    attrs_[kernel_name].merge(attrs);
+  }
+}
+
+void FunctionAttributePolicy::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  attrs_.clear();
+  // an explicit clear also drops the environment config
+  env_loaded_ = true;
+}
+
+void FunctionAttributePolicy::ensure_env_loaded() {
+  if (env_loaded_) {
+    return;
+  }
+  const char* path = std::getenv("TRITON_JIT_FUNC_ATTR_CONFIG");
+  if (path == nullptr || *path == '\0') {
+    env_loaded_ = true;
+    return;
+  }
+  // marked loaded only once parsed: a malformed config keeps failing every lookup instead of being
+  // silently dropped after the first
+  std::map<std::string, FunctionAttributes> loaded = parse_file(path);
+  env_loaded_ = true;
+  // loaded beneath the settings made through the API
+  for (auto& [kernel_name, attrs] : loaded) {
+    FunctionAttributes& current = attrs_[kernel_name];
+    attrs.merge(current);
+    current = attrs;
+  }
+  LOG(INFO) << fmt::format("Loaded function attribute config {}", path);
+}
+
+void report_unsupported_function_attributes(const char* backend,
+                                            const std::string& kernel_name,
+                                            const FunctionAttributes& attrs) {
+  if (attrs.empty()) {
+    return;
+  }
+  LOG(WARNING) << fmt::format("{} backend ignores unsupported function attributes of {}: {}",
+                              backend,
+                              kernel_name,
+                              fmt::join(attrs.describe(), ", "));
+}
+
+}  // namespace triton_jit
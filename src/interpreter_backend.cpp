@@ -0,0 +1,154 @@
+#include "triton_jit/backends/interpreter_backend.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "c10/util/Logging.h"
+#include "fmt/core.h"
+#include "nlohmann/json.hpp"
+#include "pybind11/embed.h"
+#include "triton_jit/function_attributes.h"
+#include "triton_jit/jit_utils.h"
+
+namespace triton_jit {
+
+namespace py = pybind11;
+
+namespace {
+
+template <typename T>
+T read_arg(void* arg) {
+  T v;
+  std::memcpy(&v, arg, sizeof(T));
+  return v;
+}
+
+/// Decode one packed argument per signature token, in the order ArgHandle packed them
+py::list decode_args(const std::string& signature, void** args) {
+  py::list out;
+  size_t next = 0;
+  size_t begin = 0;
+  while (begin <= signature.size()) {
+    size_t end = signature.find(',', begin);
+    if (end == std::string::npos) {
+      end = signature.size();
+    }
+    std::string_view token(signature.data() + begin, end - begin);
+    begin = end + 1;
+    while (!token.empty() && token.front() == ' ') token.remove_prefix(1);
+    while (!token.empty() && token.back() == ' ') token.remove_suffix(1);
+    if (token.empty()) {
+      continue;
+    }
+
+    size_t colon = token.find(':');
+    std::string_view type = token.substr(0, colon);
+    std::string_view hint = colon == std::string_view::npos ? "" : token.substr(colon + 1);
+
+    if (type.front() == '*') {
+      // a HostPointerArg, or a bare nullptr for nullptr_t arguments; both start with the pointer
+      void* ptr = read_arg<void*>(args[next]);
+      if (ptr == nullptr) {
+        out.append(py::none());
+      } else {
+        int64_t nbytes = read_arg<HostPointerArg>(args[next]).nbytes;
+        out.append(py::make_tuple(reinterpret_cast<uintptr_t>(ptr), nbytes, std::string(type.substr(1))));
+      }
+      next++;
+    } else if (hint == "1") {
+      // equal-to-1 specialization: not packed
+      out.append(1);
+    } else if (type == "i1") {
+      out.append(read_arg<bool>(args[next++]));
+    } else if (type == "i32") {
+      out.append(read_arg<int>(args[next++]));
+    } else if (type == "u32") {
+      out.append(read_arg<unsigned int>(args[next++]));
+    } else if (type == "i64") {
+      out.append(read_arg<int64_t>(args[next++]));
+    } else if (type == "u64") {
+      out.append(read_arg<uint64_t>(args[next++]));
+    } else if (type == "fp32") {
+      out.append(read_arg<float>(args[next++]));
+    } else if (type == "fp64") {
+      out.append(read_arg<double>(args[next++]));
+    } else {
+      // constexpr value or nullopt, parsed on the Python side
+      out.append(std::string(token));
+    }
+  }
+  return out;
+}
+
+}  // namespace
+
+const InterpreterKernel* InterpreterBackend::load_kernel(const std::string& dir,
+                                                         const std::string& kernel_name) {
+  std::string key = fmt::format("{}::{}", dir, kernel_name);
+
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  auto it = module_cache_.find(key);
+  if (it != module_cache_.end()) {
+    return &it->second;
+  }
+
+  std::string path = fmt::format("{}/{}.json", dir, kernel_name);
+  std::ifstream f(path);
+  if (!f.is_open()) {
+    throw std::runtime_error(fmt::format("Failed to load metadata for kernel: {}", kernel_name));
+  }
+  InterpreterKernel kernel;
+  try {
+    nlohmann::json j = nlohmann::json::parse(f);
+    kernel.source_path = j.at("source_path").get<std::string>();
+    kernel.function_name = j.value("name", kernel_name);
+    kernel.num_stages = j.value("num_stages", 3);
+  } catch (const nlohmann::json::exception& e) {
+    throw std::runtime_error(fmt::format("Failed to parse interpreter metadata {}: {}", path, e.what()));
+  }
+
+  LOG(INFO) << fmt::format("Loading interpreted kernel {} from {}", kernel.function_name, kernel.source_path);
+  report_unsupported_function_attributes(
+      "INTERPRETER", kernel_name, FunctionAttributePolicy::instance().lookup(kernel_name));
+  auto result = module_cache_.emplace(std::move(key), std::move(kernel));
+  return &result.first->second;
+}
+
+void InterpreterBackend::launch_kernel(void* /*stream*/,
+                                       const InterpreterKernel* kernel,
+                                       unsigned grid_x,
+                                       unsigned grid_y,
+                                       unsigned grid_z,
+                                       unsigned block_x,
+                                       unsigned /*block_y*/,
+                                       unsigned /*block_z*/,
+                                       void** args,
+                                       const LaunchOptions& opts) {
+  py::gil_scoped_acquire gil;
+  // leaked on purpose: must not be released after the interpreter shuts down
+  static py::object* launch = []() {
+    std::filesystem::path script_dir = get_script_dir();
+    py::module_ sys = py::module_::import("sys");
+    sys.attr("path").attr("insert")(0, script_dir.c_str());
+    return new py::object(py::module_::import("interpret_launch").attr("launch"));
+  }();
+
+  py::list py_args = decode_args(opts.signature, args);
+  try {
+    (*launch)(kernel->source_path,
+              kernel->function_name,
+              py::make_tuple(grid_x, grid_y, grid_z),
+              block_x / WARP_SIZE,
+              kernel->num_stages,
+              py_args);
+  } catch (const py::error_already_set& e) {
+    throw std::runtime_error(
+        fmt::format("Interpreted launch of {} failed: {}", kernel->function_name, e.what()));
+  }
+}
+
+}  // namespace triton_jit
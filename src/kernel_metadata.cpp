@@ -1,15 +1,21 @@
 #include "triton_jit/kernel_metadata.h"
 
+#include <cstring>
 #include <fstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "c10/util/Logging.h"
 #include "fmt/core.h"
 #include "nlohmann/json.hpp"
+#include "triton_jit/jit_utils.h"
+#include "triton_jit/runtime_metrics.h"
 
 namespace triton_jit {
 
 GpuKernelMeta load_gpu_metadata(const std::string& dir, const std::string& kernel_name) {
+  ScopedTimer timer("jit/metadata_parse");
   std::string path = fmt::format("{}/{}.json", dir, kernel_name);
   std::ifstream f(path);
   GpuKernelMeta meta;
@@ -29,6 +35,7 @@ GpuKernelMeta load_gpu_metadata(const std::string& dir, const std::string& kerne
 }
 
 NpuKernelMetadata load_npu_metadata(const std::string& dir, const std::string& kernel_name) {
+  ScopedTimer timer("jit/metadata_parse");
   std::string path = fmt::format("{}/{}.json", dir, kernel_name);
   std::ifstream f(path);
   NpuKernelMetadata meta;
@@ -82,6 +89,7 @@ NpuKernelMetadata load_npu_metadata(const std::string& dir, const std::string& k
 }
 
 unsigned int load_shared_memory(const std::string& dir, const std::string& kernel_name) {
+  ScopedTimer timer("jit/metadata_parse");
   std::string path = fmt::format("{}/{}.json", dir, kernel_name);
   std::ifstream f(path);
   if (!f.is_open()) {
@@ -96,4 +104,50 @@ unsigned int load_shared_memory(const std::string& dir, const std::string& kerne
   }
 }
 
+std::vector<char> read_binary_file(const std::string& path) {
+  std::ifstream f(path, std::ios::binary | std::ios::ate);
+  if (!f.is_open()) {
+    throw std::runtime_error(fmt::format("Failed to open kernel binary: {}", path));
+  }
+  std::streamsize size = f.tellg();
+  if (size <= 0) {
+    throw std::runtime_error(fmt::format("Invalid binary size: {}", path));
+  }
+  f.seekg(0, std::ios::beg);
+  std::vector<char> buffer(static_cast<size_t>(size));
+  if (!f.read(buffer.data(), size)) {
+    throw std::runtime_error(fmt::format("Failed to read kernel binary: {}", path));
+  }
+  return buffer;
+}
+
+std::string binary_content_key(int device,
+                               const std::string& kernel_name,
+                               const std::vector<char>& binary,
+                               unsigned int shared) {
+  return fmt::format("{}:{}:{:016x}:{}:{}",
+                     device,
+                     kernel_name,
+                     hash_bytes(binary.data(), binary.size()),
+                     binary.size(),
+                     shared);
+}
+
+bool same_binary(const std::vector<char>& registered, const std::vector<char>& binary) {
+  return registered.size() == binary.size() &&
+         std::memcmp(registered.data(), binary.data(), binary.size()) == 0;
+}
+
+void record_module_load(size_t bytes, uint64_t load_ns, bool reused) {
+  RuntimeMetrics& metrics = RuntimeMetrics::instance();
+  if (reused) {
+    metrics.add("module_load/dedup_hits");
+    metrics.add("module_load/dedup_saved_bytes", bytes);
+    metrics.add("module_load/dedup_saved_ns", load_ns);
+  } else {
+    metrics.add("module_load/loaded");
+    metrics.add("module_load/loaded_bytes", bytes);
+  }
+}
+
 }  // namespace triton_jit
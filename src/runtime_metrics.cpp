@@ -0,0 +1,126 @@
+#include "triton_jit/runtime_metrics.h"
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <stdexcept>
+
+#include "c10/util/Logging.h"
+#include "fmt/core.h"
+#include "nlohmann/json.hpp"
+
+namespace triton_jit {
+
+void Histogram::record(uint64_t ns) {
+  count++;
+  sum_ns += ns;
+  min_ns = std::min(min_ns, ns);
+  max_ns = std::max(max_ns, ns);
+  buckets[std::bit_width(ns)]++;
+}
+
+RuntimeMetrics& RuntimeMetrics::instance() {
+  // leaked on purpose: metrics may be recorded from static destructors
+  static RuntimeMetrics* metrics = new RuntimeMetrics();
+  return *metrics;
+}
+
+void RuntimeMetrics::add(std::string_view counter, uint64_t delta) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = counters_.find(counter);
+  if (it == counters_.end()) {
+    it = counters_.emplace(std::string(counter), 0).first;
+  }
+  it->second += delta;
+}
+
+void RuntimeMetrics::record_ns(std::string_view histogram, uint64_t ns) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = histograms_.find(histogram);
+  if (it == histograms_.end()) {
+    it = histograms_.emplace(std::string(histogram), Histogram {}).first;
+  }
+  it->second.record(ns);
+}
+
+uint64_t RuntimeMetrics::counter(std::string_view name) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = counters_.find(name);
+  return it == counters_.end() ? 0 : it->second;
+}
+
+Histogram RuntimeMetrics::histogram(std::string_view name) const {
+  flush();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = histograms_.find(name);
+  return it == histograms_.end() ? Histogram {} : it->second;
+}
+
+uint64_t RuntimeMetrics::add_flush_hook(std::function<void()> hook) {
+  std::lock_guard<std::mutex> lock(hooks_mutex_);
+  uint64_t id = next_hook_id_++;
+  flush_hooks_.emplace(id, std::move(hook));
+  return id;
+}
+
+void RuntimeMetrics::remove_flush_hook(uint64_t id) {
+  // waits for a flush in progress, so the hook's owner may be destroyed afterwards
+  std::lock_guard<std::mutex> lock(hooks_mutex_);
+  flush_hooks_.erase(id);
+}
+
+void RuntimeMetrics::flush() const {
+  std::lock_guard<std::mutex> lock(hooks_mutex_);
+  for (const auto& [id, hook] : flush_hooks_) {
+    try {
+      hook();
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Runtime metrics flush hook failed: " << e.what();
+    }
+  }
+}
+
+std::string RuntimeMetrics::to_json() const {
+  flush();
+  nlohmann::json j;
+  j["counters"] = nlohmann::json::object();
+  j["histograms"] = nlohmann::json::object();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& [name, value] : counters_) {
+    j["counters"][name] = value;
+  }
+  for (const auto& [name, h] : histograms_) {
+    // only non-empty buckets, keyed by their exclusive upper bound in ns
+    nlohmann::json buckets = nlohmann::json::object();
+    for (size_t i = 0; i < Histogram::NUM_BUCKETS; i++) {
+      if (h.buckets[i] != 0) {
+        buckets[i == 64 ? std::string("inf") : std::to_string(uint64_t(1) << i)] = h.buckets[i];
+      }
+    }
+    j["histograms"][name] = {
+        {"count", h.count},
+        {"sum_ns", h.sum_ns},
+        {"min_ns", h.count == 0 ? 0 : h.min_ns},
+        {"max_ns", h.max_ns},
+        {"buckets", std::move(buckets)},
+    };
+  }
+  return j.dump(2);
+}
+
+void RuntimeMetrics::write_json(const std::string& path) const {
+  std::ofstream out(path);
+  if (!out) {
+    throw std::runtime_error(fmt::format("Cannot open {} for writing runtime metrics", path));
+  }
+  out << to_json() << "\n";
+}
+
+void RuntimeMetrics::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  counters_.clear();
+  histograms_.clear();
+}
+
+}  // namespace triton_jit
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdlib>
 #include <filesystem>
 #include <mutex>
 #include <string>
@@ -9,7 +10,10 @@
 
 #include "c10/util/Logging.h"
 #include "fmt/core.h"
+#include "fmt/ranges.h"
+#include "nlohmann/json.hpp"
 #include "pybind11/embed.h"
+#include "triton_jit/runtime_metrics.h"
 
 namespace triton_jit {
 
@@ -17,9 +21,13 @@ static void ensure_initialized() {
   // Use std::call_once to ensure initialization happens only once
   static std::once_flag init_flag;
   std::call_once(init_flag, []() {
+    ScopedTimer boot_timer("jit/interpreter_boot");
     c10::initLogging();
     if (!Py_IsInitialized()) {
       Py_InitializeEx(false);
+      // Py_InitializeEx leaves the GIL held by this thread; release it for good so other threads
+      // (e.g. the AsyncLauncher compiling a kernel) can take it with gil_scoped_acquire
+      PyEval_SaveThread();
     }
     // Set Python os.environ directly via pybind11
     namespace py = pybind11;
@@ -28,6 +36,10 @@ static void ensure_initialized() {
 
     // Import backend-specific modules for device registration
     std::string backend_name(BACKEND_NAME);
+    if (backend_name == "INTERPRETER") {
+      // Must be set before triton is imported, @triton.jit reads it at decoration time
+      py::module_::import("os").attr("environ")["TRITON_INTERPRET"] = "1";
+    }
     if (backend_name == "mtgpu") {
       try {
         // Import torch_musa to register MUSA as PrivateUse1 backend
@@ -39,6 +51,15 @@ static void ensure_initialized() {
   });
 }
 
+/// Look kernels up in the Triton cache before compiling; TRITON_JIT_CACHE_LOOKUP=0 disables it
+static bool triton_cache_lookup_enabled() {
+  static const bool enabled = []() {
+    const char* env = std::getenv("TRITON_JIT_CACHE_LOOKUP");
+    return env == nullptr || std::string(env) != "0";
+  }();
+  return enabled;
+}
+
 template <BackendPolicy Backend>
 TritonJITFunctionImpl<Backend>::TritonJITFunctionImpl(std::string_view path, std::string_view name)
     : file_path_(std::string(path)), function_name_(std::string(name)) {
@@ -50,9 +71,16 @@ TritonJITFunctionImpl<Backend>::TritonJITFunctionImpl(std::string_view path, std
   std::filesystem::path script_dir = get_script_dir();
   py::module_ sys = py::module_::import("sys");
   sys.attr("path").attr("insert")(0, script_dir.c_str());
-  py::module_ mod = py::module_::import("gen_ssig");
+  py::module_ mod = [&]() {
+    // the first import of the helper scripts also imports triton (and torch)
+    ScopedTimer timer("jit/python_import");
+    return py::module_::import("gen_ssig");
+  }();
   py::object fn = mod.attr("extract_static_signature");
-  py::object ans = fn(this->file_path_, this->function_name_);
+  py::object ans = [&]() {
+    ScopedTimer timer("jit/gen_ssig");
+    return fn(this->file_path_, this->function_name_);
+  }();
   py::list arg_types_raw = ans.cast<py::list>();
 
   int num_args = arg_types_raw.size();
@@ -66,6 +94,96 @@ TritonJITFunctionImpl<Backend>::TritonJITFunctionImpl(std::string_view path, std
     }
   }
   this->static_sig_ = StaticSignature {num_args, arg_types};
+
+  py::object autotune = [&]() {
+    ScopedTimer timer("jit/gen_ssig");
+    return mod.attr("extract_autotune_spec")(this->file_path_, this->function_name_);
+  }();
+  if (!autotune.is_none()) {
+    AutotuneSpec spec = AutotuneSpec::from_json(autotune.cast<std::string>());
+    if (!spec.unsupported.empty()) {
+      LOG(WARNING) << fmt::format("Autotuned kernel {} uses features the C++ runtime ignores: {}",
+                                  this->function_name_,
+                                  fmt::join(spec.unsupported, ", "));
+    }
+    this->autotune_ = std::move(spec);
+  }
+
+  py::object heuristics = mod.attr("extract_heuristics")(this->file_path_, this->function_name_);
+  if (!heuristics.is_none()) {
+    nlohmann::json j = nlohmann::json::parse(heuristics.cast<std::string>());
+    for (const auto& value : j.at("derived")) {
+      this->heuristics_.push_back(
+          HeuristicValue {value.at("name").get<std::string>(), value.at("index").get<int>()});
+    }
+  }
+
+  if (this->autotune_ || !this->heuristics_.empty()) {
+    this->provided_.assign(num_args, false);
+    if (this->autotune_) {
+      for (int i : this->autotune_->tuned) {
+        this->provided_.at(i) = true;
+      }
+    }
+    for (const HeuristicValue& h : this->heuristics_) {
+      if (h.index >= 0) {
+        this->provided_.at(h.index) = true;
+      }
+    }
+  }
+}
+
+template <BackendPolicy Backend>
+std::vector<std::string> TritonJITFunctionImpl<Backend>::evaluate_heuristics(
+    const std::string& args, const KernelConfig& config) const {
+  namespace py = pybind11;
+  ScopedTimer timer("jit/heuristics");
+  RuntimeMetrics::instance().add("heuristics/evaluations");
+  nlohmann::json constexprs = nlohmann::json::array();
+  for (const auto& [name, token] : config.constexprs) {
+    constexprs.push_back({name, token});
+  }
+
+  ensure_initialized();
+  py::gil_scoped_acquire gil;
+  py::module_ mod = py::module_::import("gen_ssig");
+  py::object values;
+  try {
+    values = mod.attr("evaluate_heuristics")(this->file_path_, this->function_name_, args, constexprs.dump());
+  } catch (const py::error_already_set& e) {
+    throw std::runtime_error(
+        fmt::format("Failed to evaluate the heuristics of {}: {}", this->function_name_, e.what()));
+  }
+
+  std::vector<std::string> result;
+  result.reserve(this->heuristics_.size());
+  for (auto item : values.cast<py::list>()) {
+    py::list pair = item.cast<py::list>();
+    result.push_back(pair[1].cast<std::string>());
+  }
+  if (result.size() != this->heuristics_.size()) {
+    throw std::runtime_error(fmt::format("{} heuristics of {} returned {} values",
+                                         this->heuristics_.size(),
+                                         this->function_name_,
+                                         result.size()));
+  }
+  return result;
+}
+
+template <BackendPolicy Backend>
+void TritonJITFunctionImpl<Backend>::record_compile_stages(
+    const std::string& signature, const std::vector<std::pair<std::string, double>>& stages) const {
+  RuntimeMetrics& metrics = RuntimeMetrics::instance();
+  std::vector<std::string> breakdown;
+  breakdown.reserve(stages.size());
+  for (const auto& [stage, ms] : stages) {
+    auto ns = static_cast<uint64_t>(ms * 1e6);
+    metrics.record_ns(fmt::format("compile_stage/{}", stage), ns);
+    metrics.record_ns(fmt::format("compile_stage/{}/{}", this->function_name_, stage), ns);
+    breakdown.push_back(fmt::format("{} {:.1f} ms", stage, ms));
+  }
+  LOG(INFO) << fmt::format(
+      "Compiled {} [{}]: {}", this->function_name_, signature, fmt::join(breakdown, ", "));
 }
 
 template <BackendPolicy Backend>
@@ -76,9 +194,17 @@ const TritonKernelImpl<Backend>& TritonJITFunctionImpl<Backend>::get_kernel(std:
   std::string signature(_signature);
   std::string key = fmt::format("{};{}", signature, device_index);
 
-  auto pos = this->overloads_.find(key);
-  if (pos == this->overloads_.end()) {
-    // Compile kernel via Python
+  {
+    std::lock_guard<std::mutex> lock(this->overloads_mutex_);
+    auto pos = this->overloads_.find(key);
+    if (pos != this->overloads_.end()) {
+      return pos->second;
+    }
+  }
+
+  // Compiled without overloads_mutex_: a caller holding the GIL must not wait on it behind Python
+  std::string cache_dir;
+  {
     namespace py = pybind11;
     ensure_initialized();
     py::gil_scoped_acquire gil;
@@ -86,25 +212,46 @@ const TritonKernelImpl<Backend>& TritonJITFunctionImpl<Backend>::get_kernel(std:
     std::filesystem::path script_dir = get_script_dir();
     py::module_ sys = py::module_::import("sys");
     sys.attr("path").attr("insert")(0, script_dir.c_str());
-    py::module_ mod = py::module_::import("standalone_compile");
-    py::object fn = mod.attr("compile_a_kernel");
-    py::object ans;
+    py::module_ mod = [&]() {
+      ScopedTimer timer("jit/python_import");
+      return py::module_::import("standalone_compile");
+    }();
+    // one call: the lookup (artifacts compiled earlier, e.g. by Python Triton sharing the cache dir)
+    // and the compile on a miss share the imported and specialized kernel source
+    bool lookup = triton_cache_lookup_enabled();
+    py::tuple result;
     try {
-      ans = fn(this->file_path_, this->function_name_, signature, num_warps, num_stages, device_index);
+      ScopedTimer timer("jit/compile_a_kernel");
+      result = mod.attr("lookup_or_compile_a_kernel")(
+          this->file_path_, this->function_name_, signature, num_warps, num_stages, device_index, lookup);
     } catch (const py::error_already_set& e) {
       std::cerr << "Python exception: " << e.what() << std::endl;
       throw;
     }
+    bool hit = result[2].cast<bool>();
+    if (lookup) {
+      RuntimeMetrics::instance().add(hit ? "compile/cache_lookup_hit" : "compile/cache_lookup_miss");
+    }
+    if (!hit) {
+      std::vector<std::pair<std::string, double>> stages;
+      for (auto item : result[1].cast<py::dict>()) {
+        stages.emplace_back(item.first.cast<std::string>(), item.second.cast<double>());
+      }
+      this->record_compile_stages(signature, stages);
+    }
+    cache_dir = result[0].cast<std::string>();
+  }
 
-    std::string cache_dir = ans.cast<std::string>();
-    TritonKernelImpl<Backend> k(cache_dir, this->function_name_);
+  TritonKernelImpl<Backend> k(cache_dir, this->function_name_);
+  k.recorder_id_ = FlightRecorder::intern(this->function_name_, cache_dir, signature);
+  // loaded before it is published, so concurrent launches only ever read the handle
+  k.lazy_init_handle();
 
-    auto result = this->overloads_.emplace(std::move(key), std::move(k));
-    if (result.second) {
-      pos = result.first;
-    } else {
-      throw std::runtime_error("Unable to emplace the kernel into TritonJITFunctionImpl's cache");
-    }
+  std::lock_guard<std::mutex> lock(this->overloads_mutex_);
+  auto [pos, inserted] = this->overloads_.try_emplace(std::move(key), std::move(k));
+  if (!inserted) {
+    // a concurrent miss of the same overload finished first, its kernel is kept
+    k.release_handle();
   }
   return pos->second;
 }
@@ -130,3 +277,8 @@ template class triton_jit::TritonJITFunctionImpl<triton_jit::IxBackend>;
 #include "triton_jit/backends/musa_backend.h"
 template class triton_jit::TritonJITFunctionImpl<triton_jit::MusaBackend>;
 #endif
+
+#ifdef BACKEND_INTERPRETER
+#include "triton_jit/backends/interpreter_backend.h"
+template class triton_jit::TritonJITFunctionImpl<triton_jit::InterpreterBackend>;
+#endif